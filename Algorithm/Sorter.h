@@ -2,6 +2,7 @@
 #define SORTER_H
 
 #include "Core/Memory.h" // rapid::mem_copy
+#include "Core/Malloc.h" // rapid::malloc_array
 #include "Core/Compare.h"
 #include "Core/Map.h"
 #include <type_traits> // std::declval
@@ -235,13 +236,13 @@ void msort(_RandomIter beg,
     using _ValueType = typename RemoveReference<_IterValueType>::type;
 
     size_type dist = distance(beg, end);
-    _ValueType *result = new _ValueType[dist];
+    _ValueType *result = malloc_array<_ValueType>(dist);
     msort(result, beg, end, c);
     for(size_type i = 0; i < dist; ++i)
     {
         *beg++ = result[i];
     }
-    delete[] result;
+    free_array(result, dist);
 }
 
 // shell sort
@@ -357,7 +358,7 @@ void hsort(_ForwardIter beg,
     long long interval = min;
     max -= min;
     min = 0;
-    __element_type *ele = new __element_type[static_cast<std::size_t>(max)];
+    __element_type *ele = malloc_array<__element_type>(static_cast<size_type>(max));
     mem_clear(ele, static_cast<size_type>(max) * sizeof(__element_type));
     _ForwardIter it = beg;
     while(it != end)
@@ -372,7 +373,7 @@ void hsort(_ForwardIter beg,
             *beg++ = i + interval;
         }
     }
-    delete[] ele;
+    free_array(ele, static_cast<size_type>(max));
 }
 
 }
@@ -10,15 +10,17 @@ namespace rapid
 
 template<typename _DataType,
          typename _Compare = Compare<_DataType>,
-         size_type _BalanceFactor = 2>
+         size_type _BalanceFactor = 2,
+         typename _Alloc = NodeAllocator<_DataType, AVLTreeStatsTag>>
 class AVLTree
 {
 public:
     using DataType = _DataType;
     using CompareType = _Compare;
-    using TreeType = BinaryTree<DataType>;
+    using AllocatorType = _Alloc;
+    using TreeType = BinaryTree<DataType, BTreeNode<DataType>, AllocatorType>;
     using Self = AVLTree;
-    using TreeNode = typename BinaryTree<DataType>::TreeNode;
+    using TreeNode = typename TreeType::TreeNode;
 public:
     using ValueType = DataType;
     using Reference = ValueType &;
@@ -39,7 +41,7 @@ public:
     using const_aiterator = typename TreeType::const_aiterator;
 
 private:
-    BinaryTree<DataType> _M_tree;
+    TreeType _M_tree;
 
     void _F_adjust(TreeNode *node);
     iterator _F_insert(ConstReference arg);
@@ -50,17 +52,19 @@ private:
     { _F_adjust(_M_tree.erase(node)); }
 public:
     AVLTree() { }
+    explicit AVLTree(const AllocatorType &alloc)
+        : _M_tree(alloc) { }
     AVLTree(const Self &tree)
         : _M_tree(TreeType(tree._M_tree)) { }
     AVLTree(Self &&tree)
-        : _M_tree(TreeType(forward<Self>(tree)._M_tree)) { }
+        : _M_tree(TreeType(rapid::forward<Self>(tree)._M_tree)) { }
     AVLTree(std::initializer_list<ValueType> arg_list)
     { insert(arg_list); }
 
     void swap(const Self &tree)
     { _M_tree.swap(tree._M_tree); }
     void swap(Self &&tree)
-    { _M_tree.swap(forward<Self>(tree)._M_tree); }
+    { _M_tree.swap(rapid::forward<Self>(tree)._M_tree); }
 
     iterator begin()
     { return _M_tree.begin(); }
@@ -116,6 +120,8 @@ public:
 
     SizeType size() const
     { return _M_tree.size(); }
+    AllocatorType get_allocator() const
+    { return _M_tree.get_allocator(); }
     bool empty() const
     { return size() == 0; }
     SizeType depth() const
@@ -124,13 +130,13 @@ public:
     iterator find(ConstReference arg) const
     { return _F_find<ValueType, CompareType>(arg); }
     iterator find(RvalueReference arg) const
-    { return _F_find<ValueType, CompareType>(forward<ValueType>(arg)); }
+    { return _F_find<ValueType, CompareType>(rapid::forward<ValueType>(arg)); }
     template<typename _InputType, typename _CompareType>
     iterator find(const _InputType &arg) const
     { return _F_find<_InputType, _CompareType>(arg); }
     template<typename _InputType, typename _CompareType>
     iterator find(_InputType &&arg) const
-    { return _F_find<_InputType, _CompareType>(forward<_InputType>(arg)); }
+    { return _F_find<_InputType, _CompareType>(rapid::forward<_InputType>(arg)); }
 
     template<typename _InputType = ValueType, typename _CompareType = CompareType>
     iterator find_and_insert(const _InputType &input);
@@ -150,11 +156,11 @@ public:
     iterator insert(ConstReference arg)
     { return _F_insert(arg); }
     iterator insert(RvalueReference arg)
-    { return _F_insert(forward<ValueType>(arg)); }
+    { return _F_insert(rapid::forward<ValueType>(arg)); }
     void erase(ConstReference arg)
     { erase(find(arg)); }
     void erase(RvalueReference arg)
-    { erase(find(forward<ValueType>(arg))); }
+    { erase(find(rapid::forward<ValueType>(arg))); }
     void erase(iterator it)
     { _F_erase(_M_tree.tree_node(it)); }
 
@@ -167,8 +173,8 @@ public:
 //-----------------------impl-----------------------//
 //-----------------------impl-----------------------//
 //-----------------------impl-----------------------//
-template<typename _DataType, typename _Compare, size_type _BalanceFactor>
-    void AVLTree<_DataType, _Compare, _BalanceFactor>::_F_adjust(TreeNode *node)
+template<typename _DataType, typename _Compare, size_type _BalanceFactor, typename _Alloc>
+    void AVLTree<_DataType, _Compare, _BalanceFactor, _Alloc>::_F_adjust(TreeNode *node)
 {
     TreeNode *visit = node;
     while(visit != nullptr)
@@ -197,10 +203,10 @@ template<typename _DataType, typename _Compare, size_type _BalanceFactor>
     }
 }
 
-template<typename _DataType, typename _Compare, size_type _BalanceFactor>
+template<typename _DataType, typename _Compare, size_type _BalanceFactor, typename _Alloc>
 template<typename _InputType, typename _CompareType>
-typename AVLTree<_DataType, _Compare, _BalanceFactor>::iterator
-    AVLTree<_DataType, _Compare, _BalanceFactor>::find_and_insert(const _InputType &input)
+typename AVLTree<_DataType, _Compare, _BalanceFactor, _Alloc>::iterator
+    AVLTree<_DataType, _Compare, _BalanceFactor, _Alloc>::find_and_insert(const _InputType &input)
 {
     iterator result;
     if(empty())
@@ -240,10 +246,10 @@ typename AVLTree<_DataType, _Compare, _BalanceFactor>::iterator
 
 
 
-template<typename _DataType, typename _Compare, size_type _BalanceFactor>
+template<typename _DataType, typename _Compare, size_type _BalanceFactor, typename _Alloc>
 template<typename _InputType, typename _CompareType>
-typename AVLTree<_DataType, _Compare, _BalanceFactor>::iterator
-    AVLTree<_DataType, _Compare, _BalanceFactor>::_F_find(const _InputType &arg) const
+typename AVLTree<_DataType, _Compare, _BalanceFactor, _Alloc>::iterator
+    AVLTree<_DataType, _Compare, _BalanceFactor, _Alloc>::_F_find(const _InputType &arg) const
 {
     TreeNode *node = _M_tree.root();
     iterator result;
@@ -268,9 +274,9 @@ typename AVLTree<_DataType, _Compare, _BalanceFactor>::iterator
 
 
 
-template<typename _DataType, typename _Compare, size_type _BalanceFactor>
-typename AVLTree<_DataType, _Compare, _BalanceFactor>::iterator
-    AVLTree<_DataType, _Compare, _BalanceFactor>::_F_insert(ConstReference arg)
+template<typename _DataType, typename _Compare, size_type _BalanceFactor, typename _Alloc>
+typename AVLTree<_DataType, _Compare, _BalanceFactor, _Alloc>::iterator
+    AVLTree<_DataType, _Compare, _BalanceFactor, _Alloc>::_F_insert(ConstReference arg)
 {
     iterator result = find_and_insert(arg);
     TreeNode *node = _M_tree.tree_node(result);
@@ -0,0 +1,84 @@
+#include "AllocStats.h"
+#include <cstring> // std::strcmp
+
+static rapid::AllocStats *__stats_head = nullptr;
+
+rapid::AllocStats::AllocStats(const char *name)
+    : Name(name), Next(nullptr), LiveBytes(0), PeakBytes(0), TotalBytes(0),
+      Allocations(0), Deallocations(0), Histogram{0}
+{
+    AllocStats *head = __atomic_load_n(&__stats_head, __ATOMIC_ACQUIRE);
+    do
+    { Next = head; }
+    while(!__atomic_compare_exchange_n(&__stats_head, &head, this, true, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE));
+}
+
+rapid::size_type rapid::AllocStats::histogram_index(size_type bytes)
+{
+    if(bytes <= 16) return 0;
+    size_type index = 64 - static_cast<size_type>(__builtin_clzll(bytes - 1)) - 4;
+    return index < HistogramSize ? index : HistogramSize - 1;
+}
+
+void rapid::AllocStats::record_allocate(size_type bytes)
+{
+    __atomic_add_fetch(&Allocations, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&TotalBytes, bytes, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&Histogram[histogram_index(bytes)], 1, __ATOMIC_RELAXED);
+    size_type live = __atomic_add_fetch(&LiveBytes, bytes, __ATOMIC_RELAXED);
+    size_type peak = __atomic_load_n(&PeakBytes, __ATOMIC_RELAXED);
+    while(live > peak && !__atomic_compare_exchange_n(&PeakBytes, &peak, live, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    { }
+}
+
+void rapid::AllocStats::record_deallocate(size_type bytes)
+{
+    __atomic_add_fetch(&Deallocations, 1, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&LiveBytes, bytes, __ATOMIC_RELAXED);
+}
+
+void rapid::AllocStats::reset()
+{
+    __atomic_store_n(&PeakBytes, __atomic_load_n(&LiveBytes, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    __atomic_store_n(&TotalBytes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&Allocations, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&Deallocations, 0, __ATOMIC_RELAXED);
+    for(size_type i = 0; i < HistogramSize; ++i)
+    { __atomic_store_n(&Histogram[i], 0, __ATOMIC_RELAXED); }
+}
+
+rapid::AllocStats* rapid::alloc_stats_find(const char *name)
+{
+    for(AllocStats *s = alloc_stats_list(); s != nullptr; s = s->Next)
+    {
+        if(std::strcmp(s->Name, name) == 0)
+        { return s; }
+    }
+    return nullptr;
+}
+
+rapid::AllocStats* rapid::alloc_stats_list()
+{ return __atomic_load_n(&__stats_head, __ATOMIC_ACQUIRE); }
+
+void rapid::alloc_stats_reset()
+{
+    for(AllocStats *s = alloc_stats_list(); s != nullptr; s = s->Next)
+    { s->reset(); }
+}
+
+void rapid::alloc_stats_dump(std::ostream &os)
+{
+    for(AllocStats *s = alloc_stats_list(); s != nullptr; s = s->Next)
+    {
+        os << s->Name << ": live " << s->LiveBytes << " bytes, peak " << s->PeakBytes
+           << " bytes, total " << s->TotalBytes << " bytes, " << s->Allocations
+           << " allocations, " << s->Deallocations << " deallocations" << std::endl;
+        os << "    sizes:";
+        for(size_type i = 0; i < AllocStats::HistogramSize; ++i)
+        {
+            if(s->Histogram[i] == 0) continue;
+            os << " <=" << (static_cast<size_type>(16) << i) << ":" << s->Histogram[i];
+        }
+        os << std::endl;
+    }
+}
@@ -0,0 +1,166 @@
+#ifndef ALLOCSTATS_H
+#define ALLOCSTATS_H
+
+#include "Core/Version.h"
+#include <memory> // std::allocator_traits
+#include <utility> // std::declval
+#include <ostream>
+
+namespace rapid
+{
+
+/* allocation statistics of one tag, usually a kind of container
+ * the default allocators of containers only record when RAPID_ALLOC_STATS is defined,
+ * StatsAllocator used explicitly always records
+ */
+struct AllocStats
+{
+    // bucket i counts sizes in (2^(i+3), 2^(i+4)], bucket 0 counts sizes <= 16
+    static constexpr size_type HistogramSize = 32;
+
+    const char *Name;
+    AllocStats *Next;// all stats are chained once they are created
+    size_type LiveBytes;
+    size_type PeakBytes;
+    size_type TotalBytes;
+    size_type Allocations;
+    size_type Deallocations;
+    size_type Histogram[HistogramSize];
+
+    explicit AllocStats(const char *name);
+
+    void record_allocate(size_type bytes);
+    void record_deallocate(size_type bytes);
+    void reset();
+
+    static size_type histogram_index(size_type bytes);
+};
+
+// the stats of [_Tag], which has a static function name()
+template<typename _Tag>
+AllocStats& alloc_stats_of()
+{
+    static AllocStats stats(_Tag::name());
+    return stats;
+}
+
+// stats named [name], nullptr if nothing has been recorded with it
+AllocStats* alloc_stats_find(const char *name);
+
+// the first stats created, go on with AllocStats::Next
+AllocStats* alloc_stats_list();
+
+// set every stats to 0, except the live bytes
+void alloc_stats_reset();
+
+// print every stats to [os]
+void alloc_stats_dump(std::ostream &os);
+
+#define REGIST_STATS_TAG(tag) \
+    struct tag##StatsTag \
+    { \
+        static const char* name() { return #tag; } \
+    }
+
+REGIST_STATS_TAG(Other);
+REGIST_STATS_TAG(Vector);
+REGIST_STATS_TAG(SmallVector);
+REGIST_STATS_TAG(Matrix);
+REGIST_STATS_TAG(Stack);
+REGIST_STATS_TAG(SingleLinkedList);
+REGIST_STATS_TAG(DoubleLinkedList);
+REGIST_STATS_TAG(Deque);
+REGIST_STATS_TAG(BinaryTree);
+REGIST_STATS_TAG(AVLTree);
+REGIST_STATS_TAG(RedBlackTree);
+REGIST_STATS_TAG(Map);
+REGIST_STATS_TAG(AVLMap);
+REGIST_STATS_TAG(Set);
+REGIST_STATS_TAG(AVLSet);
+REGIST_STATS_TAG(MPMCQueue);
+REGIST_STATS_TAG(SPSCQueue);
+REGIST_STATS_TAG(ConcurrentStack);
+REGIST_STATS_TAG(WorkStealingDeque);
+
+#if defined(RAPID_ALLOC_STATS)
+template<typename _Tag>
+inline void stats_record_allocate(size_type bytes)
+{ alloc_stats_of<_Tag>().record_allocate(bytes); }
+template<typename _Tag>
+inline void stats_record_deallocate(size_type bytes)
+{ alloc_stats_of<_Tag>().record_deallocate(bytes); }
+#else
+template<typename _Tag>
+inline void stats_record_allocate(size_type)
+{ }
+template<typename _Tag>
+inline void stats_record_deallocate(size_type)
+{ }
+#endif
+
+/* allocator adapter which records every allocation of [_Alloc] into the stats of [_Tag]
+ * param[_Alloc]: allocator of [T] doing the real work
+ */
+template<typename T, typename _Tag, typename _Alloc>
+class StatsAllocator
+{
+public:
+    using ValueType = T;
+    using Pointer = ValueType*;
+    using SizeType = size_type;
+    using AllocatorType = _Alloc;
+
+    using value_type = ValueType;// std
+
+    template<typename U>
+    struct rebind
+    { using other = StatsAllocator<U, _Tag, typename std::allocator_traits<_Alloc>::template rebind_alloc<U>>; };
+private:
+    using Traits = std::allocator_traits<AllocatorType>;
+
+    AllocatorType _M_alloc;
+
+    template<typename, typename, typename>
+    friend class StatsAllocator;
+public:
+    StatsAllocator() { }
+    StatsAllocator(const AllocatorType &alloc) : _M_alloc(alloc) { }
+    template<typename U, typename _OtherAlloc>
+    StatsAllocator(const StatsAllocator<U, _Tag, _OtherAlloc> &a) : _M_alloc(a._M_alloc) { }
+
+    Pointer allocate(SizeType n)
+    {
+        Pointer p = Traits::allocate(_M_alloc, n);
+        alloc_stats_of<_Tag>().record_allocate(n * sizeof(ValueType));
+        return p;
+    }
+    void deallocate(Pointer p, SizeType n)
+    {
+        alloc_stats_of<_Tag>().record_deallocate(n * sizeof(ValueType));
+        Traits::deallocate(_M_alloc, p, n);
+    }
+    // only if [_Alloc] has reallocate()
+    template<typename A = AllocatorType>
+    auto reallocate(Pointer p, SizeType old_n, SizeType n)
+        -> decltype(std::declval<A &>().reallocate(p, old_n, n))
+    {
+        Pointer result = _M_alloc.reallocate(p, old_n, n);
+        alloc_stats_of<_Tag>().record_deallocate(old_n * sizeof(ValueType));
+        alloc_stats_of<_Tag>().record_allocate(n * sizeof(ValueType));
+        return result;
+    }
+
+    const AllocatorType& allocator() const
+    { return _M_alloc; }
+
+    template<typename U, typename _OtherAlloc>
+    bool operator==(const StatsAllocator<U, _Tag, _OtherAlloc> &a) const
+    { return _M_alloc == a._M_alloc; }
+    template<typename U, typename _OtherAlloc>
+    bool operator!=(const StatsAllocator<U, _Tag, _OtherAlloc> &a) const
+    { return _M_alloc != a._M_alloc; }
+};
+
+};
+
+#endif // ALLOCSTATS_H
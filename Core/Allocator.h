@@ -0,0 +1,156 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include "Core/TLNode.h"
+#include "Core/ObjectPool.h"
+#include "Core/Malloc.h"
+#include "Core/Memory.h"
+#include "Core/AllocStats.h"
+#include <memory> // std::allocator_traits
+#include <new>
+
+namespace rapid
+{
+
+/* plain allocator, get memory from rapid::malloc
+ * any allocator satisfying the standard allocator requirements can replace it
+ */
+template<typename T>
+struct Allocator
+{
+    using ValueType = T;
+    using Pointer = ValueType*;
+    using SizeType = size_type;
+
+    using value_type = ValueType;// std
+
+    Allocator() noexcept { }
+    template<typename U>
+    Allocator(const Allocator<U> &) noexcept { }
+
+    Pointer allocate(SizeType n)
+    {
+        Pointer p = static_cast<Pointer>(rapid::malloc(n * sizeof(ValueType)));
+        if(p == nullptr)
+        { throw std::bad_alloc(); }
+        return p;
+    }
+    void deallocate(Pointer p, SizeType)
+    { rapid::free(p); }
+    // resize [p] keeping its bytes, big blocks are moved by the kernel instead of being copied
+    Pointer reallocate(Pointer p, SizeType, SizeType n)
+    {
+        Pointer result = static_cast<Pointer>(rapid::realloc(p, n * sizeof(ValueType)));
+        if(result == nullptr)
+        { throw std::bad_alloc(); }
+        return result;
+    }
+
+    template<typename U>
+    bool operator==(const Allocator<U> &) const noexcept
+    { return true; }
+    template<typename U>
+    bool operator!=(const Allocator<U> &) const noexcept
+    { return false; }
+};
+
+#if defined(RAPID_ALLOC_STATS)
+// default allocator of array containers, recorded into the stats of [_Tag]
+template<typename T, typename _Tag = OtherStatsTag>
+using ContainerAllocator = StatsAllocator<T, _Tag, Allocator<T>>;
+// default allocator of node containers, nodes are recycled through per-thread pools
+template<typename T, typename _Tag = OtherStatsTag>
+using NodeAllocator = StatsAllocator<T, _Tag, PoolAllocator<T>>;
+#else
+// default allocator of array containers
+template<typename T, typename _Tag = OtherStatsTag>
+using ContainerAllocator = Allocator<T>;
+// default allocator of node containers, nodes are recycled through per-thread pools
+template<typename T, typename _Tag = OtherStatsTag>
+using NodeAllocator = PoolAllocator<T>;
+#endif
+
+// the same kind of allocator as [_Alloc], which allocates [T]
+template<typename _Alloc, typename T>
+using RebindAllocator = typename std::allocator_traits<_Alloc>::template rebind_alloc<T>;
+
+/* allocate one [T] from [alloc] and construct it
+ * param[alloc]: allocator of any value type, it will be rebound to [T]
+ * param[args]: arguments of [T]'s constructor
+ */
+template<typename T, typename _Alloc, typename ... Args>
+T* allocate_object(_Alloc &alloc, const Args & ... args)
+{
+    using Traits = std::allocator_traits<RebindAllocator<_Alloc, T>>;
+    RebindAllocator<_Alloc, T> a(alloc);
+    T *p = Traits::allocate(a, 1);
+    try
+    { ::new(p) T(args...); }
+    catch(...)
+    {
+        Traits::deallocate(a, p, 1);
+        throw;
+    }
+    return p;
+}
+
+/* destroy [p] and give its memory back to [alloc]
+ * param[alloc]: allocator of any value type, it will be rebound to [T]
+ * param[p]: object created by allocate_object
+ */
+template<typename T, typename _Alloc>
+void release_object(_Alloc &alloc, T *p)
+{
+    if(p == nullptr) return;
+    RebindAllocator<_Alloc, T> a(alloc);
+    p->~T();
+    std::allocator_traits<RebindAllocator<_Alloc, T>>::deallocate(a, p, 1);
+}
+
+template<typename _Alloc>
+auto __reallocate_bytes(_Alloc &alloc, typename std::allocator_traits<_Alloc>::pointer p,
+                        size_type old_n, size_type new_n, size_type, int)
+    -> decltype(alloc.reallocate(p, old_n, new_n))
+{ return alloc.reallocate(p, old_n, new_n); }
+
+template<typename _Alloc>
+typename std::allocator_traits<_Alloc>::pointer
+    __reallocate_bytes(_Alloc &alloc, typename std::allocator_traits<_Alloc>::pointer p,
+                       size_type old_n, size_type new_n, size_type live_n, long)
+{
+    using Traits = std::allocator_traits<_Alloc>;
+    typename Traits::pointer result = Traits::allocate(alloc, new_n);
+    mem_copy(result, p, (live_n < new_n ? live_n : new_n) * sizeof(typename Traits::value_type));
+    Traits::deallocate(alloc, p, old_n);
+    return result;
+}
+
+/* resize [p] from [old_n] to [new_n] elements and keep the bytes of its first [live_n] elements,
+ * the elements are moved bitwise, so they must be trivially copyable
+ * use alloc.reallocate() if [alloc] has it, otherwise allocate, copy the live elements and deallocate
+ */
+template<typename _Alloc>
+typename std::allocator_traits<_Alloc>::pointer
+    reallocate_bytes(_Alloc &alloc, typename std::allocator_traits<_Alloc>::pointer p,
+                     size_type old_n, size_type new_n, size_type live_n)
+{ return __reallocate_bytes(alloc, p, old_n, new_n, live_n, 0); }
+
+// allocate the data of container's node, construct its content with [args]
+template<typename T, typename _Alloc, typename ... Args>
+NodeBase<T>* allocate_data(_Alloc &alloc, const Args & ... args)
+{ return allocate_object<NodeBase<T>>(alloc, args...); }
+
+// destroy the content of [p] and give its memory back to [alloc]
+template<typename T, typename _Alloc>
+void release_data(_Alloc &alloc, NodeBase<T> *p)
+{
+    if(p == nullptr) return;
+    p->destruct();
+    release_object(alloc, p);
+}
+
+};
+
+#endif // ALLOCATOR_H
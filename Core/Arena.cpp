@@ -0,0 +1,96 @@
+#include "Arena.h"
+#include "Core/Exception.h"
+#include <new>
+
+rapid::Arena::Arena(SizeType block_size, bool growable)
+    : _M_block_size(block_size), _M_growable(growable)
+{ }
+
+rapid::Arena::Block* rapid::Arena::_F_create_block(SizeType size)
+{
+    Block *block = static_cast<Block *>(::operator new(static_cast<std::size_t>(sizeof(Block) + size)));
+    block->Next = nullptr;
+    block->Size = size;
+    return block;
+}
+
+void rapid::Arena::_F_use_block(Block *block)
+{
+    _M_current = block;
+    _M_cursor = reinterpret_cast<unsigned long>(block->begin());
+    _M_limit = reinterpret_cast<unsigned long>(block->end());
+}
+
+void* rapid::Arena::_F_allocate_slow(SizeType size, SizeType align)
+{
+    // blocks kept by reset() are tried first
+    Block *next = _M_current == nullptr ? _M_head : _M_current->Next;
+    while(next != nullptr)
+    {
+        _F_use_block(next);
+        unsigned long p = _SF_align_up(_M_cursor, align);
+        if(p + size <= _M_limit)
+        {
+            _M_cursor = p + size;
+            return reinterpret_cast<void *>(p);
+        }
+        next = next->Next;
+    }
+    if(_M_head != nullptr && !_M_growable)
+    { throw OutOfMemoryException("exception: arena is used up !"); }
+
+    SizeType need = size + align;
+    Block *block = _F_create_block(need > _M_block_size ? need : _M_block_size);
+    if(_M_head == nullptr)
+    { _M_head = block; }
+    else
+    {
+        Block *last = _M_current;
+        while(last->Next != nullptr)
+        { last = last->Next; }
+        last->Next = block;
+    }
+    _F_use_block(block);
+    unsigned long p = _SF_align_up(_M_cursor, align);
+    _M_cursor = p + size;
+    return reinterpret_cast<void *>(p);
+}
+
+void rapid::Arena::reset()
+{
+    if(_M_head == nullptr) return;
+    _F_use_block(_M_head);
+}
+
+void rapid::Arena::release()
+{
+    Block *block = _M_head;
+    while(block != nullptr)
+    {
+        Block *next = block->Next;
+        ::operator delete(block);
+        block = next;
+    }
+    _M_head = _M_current = nullptr;
+    _M_cursor = _M_limit = 0;
+}
+
+rapid::size_type rapid::Arena::used() const
+{
+    SizeType result = 0;
+    for(Block *block = _M_head; block != nullptr; block = block->Next)
+    {
+        if(block == _M_current)
+        { return result + (_M_cursor - reinterpret_cast<unsigned long>(block->begin())); }
+        result += block->Size;
+    }
+    return result;
+}
+
+rapid::size_type rapid::Arena::capacity() const
+{
+    SizeType result = 0;
+    for(Block *block = _M_head; block != nullptr; block = block->Next)
+    { result += block->Size; }
+    return result;
+}
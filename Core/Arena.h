@@ -0,0 +1,135 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "Core/Version.h"
+#include <cstddef> // std::max_align_t
+#include <new>
+
+namespace rapid
+{
+
+/* region allocator, memory is handed out by moving a cursor forward in a block,
+ * and given back all together by reset() or destruction
+ * when a block is used up, the next block is chained if the arena is growable,
+ * otherwise OutOfMemoryException is thrown
+ */
+class Arena
+{
+public:
+    using SizeType = size_type;
+
+    static constexpr SizeType DefaultBlockSize = 64 * 1024;
+    static constexpr SizeType DefaultAlign = alignof(std::max_align_t);
+private:
+    struct Block
+    {
+        Block *Next;
+        SizeType Size;// usable bytes after the header
+
+        char* begin()
+        { return reinterpret_cast<char *>(this + 1); }
+        char* end()
+        { return begin() + Size; }
+    };
+
+    Block *_M_head = nullptr;
+    Block *_M_current = nullptr;
+    unsigned long _M_cursor = 0;
+    unsigned long _M_limit = 0;
+    SizeType _M_block_size;
+    bool _M_growable;
+
+    void* _F_allocate_slow(SizeType size, SizeType align);
+    Block* _F_create_block(SizeType size);
+    void _F_use_block(Block *block);
+
+    static unsigned long _SF_align_up(unsigned long p, SizeType align)
+    { return (p + align - 1) & ~static_cast<unsigned long>(align - 1); }
+public:
+    /* param[block_size]: byte size of each block
+     * param[growable]: whether to chain a new block when the last one is used up
+     */
+    explicit Arena(SizeType block_size = DefaultBlockSize, bool growable = true);
+    Arena(const Arena &) = delete;
+    Arena& operator=(const Arena &) = delete;
+    ~Arena()
+    { release(); }
+
+    /* param[size]: byte size required
+     * param[align]: power of 2
+     */
+    void* allocate(SizeType size, SizeType align = DefaultAlign)
+    {
+        unsigned long p = _SF_align_up(_M_cursor, align);
+        if(p + size <= _M_limit)
+        {
+            _M_cursor = p + size;
+            return reinterpret_cast<void *>(p);
+        }
+        return _F_allocate_slow(size, align);
+    }
+    // only the latest allocation can be given back, others are kept until reset()
+    void deallocate(void *p, SizeType size)
+    {
+        if(reinterpret_cast<unsigned long>(p) + size == _M_cursor)
+        { _M_cursor = reinterpret_cast<unsigned long>(p); }
+    }
+
+    template<typename T, typename ... Args>
+    T* create(const Args & ... args)
+    { return ::new(allocate(sizeof(T), alignof(T))) T(args...); }
+
+    // give back all memory, the blocks are kept for reuse
+    void reset();
+    // give back all memory and blocks
+    void release();
+
+    // byte size handed out since the last reset
+    SizeType used() const;
+    // byte size of all blocks
+    SizeType capacity() const;
+    SizeType block_size() const
+    { return _M_block_size; }
+    bool growable() const
+    { return _M_growable; }
+};
+
+// standard allocator adapter of Arena, can be passed to containers
+template<typename T>
+class ArenaAllocator
+{
+public:
+    using ValueType = T;
+    using Pointer = ValueType*;
+    using SizeType = size_type;
+
+    using value_type = ValueType;// std
+private:
+    Arena *_M_arena;
+
+    template<typename U>
+    friend class ArenaAllocator;
+public:
+    ArenaAllocator(Arena &arena) noexcept : _M_arena(&arena) { }
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &a) noexcept : _M_arena(a._M_arena) { }
+
+    Pointer allocate(SizeType n)
+    { return static_cast<Pointer>(_M_arena->allocate(n * sizeof(ValueType), alignof(ValueType))); }
+    void deallocate(Pointer p, SizeType n)
+    { _M_arena->deallocate(p, n * sizeof(ValueType)); }
+
+    Arena* arena() const
+    { return _M_arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &a) const noexcept
+    { return _M_arena == a._M_arena; }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U> &a) const noexcept
+    { return _M_arena != a._M_arena; }
+};
+
+};
+
+#endif // ARENA_H
@@ -2,6 +2,7 @@
 #define ATOMIC_H
 
 #include "Core/TypeTraits.h"
+#include "Core/Version.h"
 #include <iostream>
 
 namespace rapid
@@ -15,6 +16,7 @@ namespace rapid
 
 //#elif defined(__GNUC__) || defined(__GNUG__)
 
+// legacy full barrier operations, use Atomic with a MemoryOrder instead
 #define sync_fetch_before_add __sync_fetch_and_add   //return value before add
 #define sync_fetch_before_sub __sync_fetch_and_sub   //return value before sub
 #define sync_fetch_before_or __sync_fetch_and_or
@@ -49,59 +51,174 @@ namespace rapid
 
 //#endif
 
+/* the ordering of an atomic operation with the memory accesses around it
+ * Relaxed: only the operation itself is atomic
+ * Acquire: accesses after it are not moved before it, pairs with Release
+ * Release: accesses before it are not moved after it
+ * AcqRel: both Acquire and Release, for read-modify-write operations
+ * SeqCst: AcqRel and a single total order of all SeqCst operations
+ */
+enum class MemoryOrder : int
+{
+    Relaxed = __ATOMIC_RELAXED,
+    Acquire = __ATOMIC_ACQUIRE,
+    Release = __ATOMIC_RELEASE,
+    AcqRel = __ATOMIC_ACQ_REL,
+    SeqCst = __ATOMIC_SEQ_CST
+};
+
+// fence between the memory accesses before and after it
+inline void atomic_thread_fence(MemoryOrder order = MemoryOrder::SeqCst)
+{ __atomic_thread_fence(static_cast<int>(order)); }
+
+// natural alignment of an atomic value, size rounded up to a power of 2 and capped at 16
+constexpr size_type __value_align(size_type size, size_type align, size_type power = 1)
+{
+    return power < size && power < 16 ? __value_align(size, align, power * 2) :
+           power > align ? power : align;
+}
+
+/* atomic value of a trivially copyable type built on the __atomic builtins
+ * every operation takes a MemoryOrder, SeqCst by default, the operators are always SeqCst
+ * arithmetic and bitwise operations need an integral type
+ * sizes 1, 2, 4 and 8 are lock free, any other size, like a 12 byte struct,
+ * calls the generic __atomic functions of libatomic, so link with -latomic to use one
+ */
 template<typename T>
 class Atomic
 {
 private:
-    T _M_data;
-    static constexpr void type_assert()
+    static_assert(IsTriviallyCopyable<T>::value, "only support trivially copyable type");
+
+    alignas(__value_align(sizeof(T), alignof(T))) T _M_data;
+
+    static constexpr int _SF_order(MemoryOrder order)
+    { return static_cast<int>(order); }
+    // the failure order of a compare exchange can not release
+    static constexpr int _SF_failure_order(MemoryOrder order)
     {
-        static_assert(__is_assignable(T, T), "only support assignable type");
+        return order == MemoryOrder::AcqRel ? __ATOMIC_ACQUIRE :
+               order == MemoryOrder::Release ? __ATOMIC_RELAXED : static_cast<int>(order);
     }
 public:
-    Atomic()
+    using ValueType = T;
+
+    // constant initialized, a static Atomic is ready before any dynamic initialization
+    constexpr Atomic() : _M_data()
+    { }
+    constexpr Atomic(const T &value) : _M_data(value)
+    { }
+    Atomic(const Atomic &) = delete;
+    Atomic& operator=(const Atomic &) = delete;
+
+    // known at compile time, the storage is aligned to its size
+    bool is_lock_free() const
+    { return __atomic_always_lock_free(sizeof(T), 0); }
+
+    T load(MemoryOrder order = MemoryOrder::SeqCst) const
     {
-        type_assert();
-        mem_clear(&_M_data, sizeof(T));
+        T value;
+        __atomic_load(&_M_data, &value, _SF_order(order));
+        return value;
     }
-    Atomic(const T &value) : _M_data(value)
-    { type_assert(); }
-    Atomic(T &&value) : _M_data(forward<T>(value))
-    { type_assert(); }
+    void store(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    { __atomic_store(&_M_data, &value, _SF_order(order)); }
 
-    T add_and_fetch(T value)
-    { return sync_fetch_after_add(&_M_data, value); }
-    T sub_and_fetch(T value)
-    { return sync_fetch_after_sub(&_M_data, value); }
+    // return: the value before
+    T exchange(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+        T old;
+        __atomic_exchange(&_M_data, &value, &old, _SF_order(order));
+        return old;
+    }
+
+    /* set [desired] if the value equals [expected], the bytes are compared
+     * the weak one may fail even if they are equal, use it in a loop
+     * param[expected]: set to the current value if they are not equal
+     * return: whether [desired] is set
+     */
+    bool compare_exchange_weak(T &expected, T desired, MemoryOrder success, MemoryOrder failure)
+    { return __atomic_compare_exchange(&_M_data, &expected, &desired, true, _SF_order(success), _SF_order(failure)); }
+    bool compare_exchange_weak(T &expected, T desired, MemoryOrder order = MemoryOrder::SeqCst)
+    { return __atomic_compare_exchange(&_M_data, &expected, &desired, true, _SF_order(order), _SF_failure_order(order)); }
+    bool compare_exchange_strong(T &expected, T desired, MemoryOrder success, MemoryOrder failure)
+    { return __atomic_compare_exchange(&_M_data, &expected, &desired, false, _SF_order(success), _SF_order(failure)); }
+    bool compare_exchange_strong(T &expected, T desired, MemoryOrder order = MemoryOrder::SeqCst)
+    { return __atomic_compare_exchange(&_M_data, &expected, &desired, false, _SF_order(order), _SF_failure_order(order)); }
+
+    // return: the value before
+    T fetch_add(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    { return __atomic_fetch_add(&_M_data, value, _SF_order(order)); }
+    T fetch_sub(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    { return __atomic_fetch_sub(&_M_data, value, _SF_order(order)); }
+    T fetch_and(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    { return __atomic_fetch_and(&_M_data, value, _SF_order(order)); }
+    T fetch_or(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    { return __atomic_fetch_or(&_M_data, value, _SF_order(order)); }
+    T fetch_xor(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    { return __atomic_fetch_xor(&_M_data, value, _SF_order(order)); }
+
+    /* keep the smaller or the larger one of the value and [value],
+     * nothing is written if the value is kept
+     * return: the value before
+     */
+    T fetch_min(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+        T current = load(static_cast<MemoryOrder>(_SF_failure_order(order)));
+        while(value < current && !compare_exchange_weak(current, value, order))
+        { }
+        return current;
+    }
+    T fetch_max(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    {
+        T current = load(static_cast<MemoryOrder>(_SF_failure_order(order)));
+        while(current < value && !compare_exchange_weak(current, value, order))
+        { }
+        return current;
+    }
+
+    // return: the value after
+    T add_and_fetch(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    { return __atomic_add_fetch(&_M_data, value, _SF_order(order)); }
+    T sub_and_fetch(T value, MemoryOrder order = MemoryOrder::SeqCst)
+    { return __atomic_sub_fetch(&_M_data, value, _SF_order(order)); }
+
+    operator T() const
+    { return load(); }
 
-    bool operator==(T value)
-    { return sync_bool_compare_and_swap(&_M_data, value, _M_data); }
+    bool operator==(T value) const
+    { return load() == value; }
+    bool operator!=(T value) const
+    { return load() != value; }
 
     T operator++(int)
-    { return sync_fetch_before_add(&_M_data, 1); }
+    { return fetch_add(1); }
     T operator++()
-    { return sync_fetch_after_add(&_M_data, 1); }
+    { return add_and_fetch(1); }
     T operator--(int)
-    { return sync_fetch_before_sub(&_M_data, 1); }
+    { return fetch_sub(1); }
     T operator--()
-    { return sync_fetch_after_sub(&_M_data, 1); }
+    { return sub_and_fetch(1); }
 
     T operator+=(T value)
-    { return sync_fetch_after_add(&_M_data, value); }
+    { return __atomic_add_fetch(&_M_data, value, __ATOMIC_SEQ_CST); }
     T operator-=(T value)
-    { return sync_fetch_after_sub(&_M_data, value); }
+    { return __atomic_sub_fetch(&_M_data, value, __ATOMIC_SEQ_CST); }
     T operator|=(T value)
-    { return sync_fetch_after_or(&_M_data, value); }
+    { return __atomic_or_fetch(&_M_data, value, __ATOMIC_SEQ_CST); }
     T operator&=(T value)
-    { return sync_fetch_after_and(&_M_data, value); }
+    { return __atomic_and_fetch(&_M_data, value, __ATOMIC_SEQ_CST); }
     T operator^=(T value)
-    { return sync_fetch_after_xor(&_M_data, value); }
+    { return __atomic_xor_fetch(&_M_data, value, __ATOMIC_SEQ_CST); }
 
     T operator=(T value)
-    { return sync_value_compare_and_swap(&_M_data, _M_data, value); }
+    {
+        store(value);
+        return value;
+    }
 
-    friend std::ostream& operator<<(std::ostream &os, Atomic<T> &a)
-    { return os << sync_value_compare_and_swap(&a._M_data, 0, a._M_data); }
+    friend std::ostream& operator<<(std::ostream &os, const Atomic<T> &a)
+    { return os << a.load(MemoryOrder::Relaxed); }
 };
 
 };
@@ -4,6 +4,7 @@
 #include "Core/TypeTraits.h"
 #include "Core/Version.h"
 #include "Core/TLNode.h"
+#include "Core/Allocator.h"
 //#include "Core/Stack.h"
 
 namespace rapid
@@ -23,8 +24,6 @@ struct BTreeNode
     SizeType _M_child_number = 0;
     SizeType _M_depth = 1;
 
-    ~BTreeNode()
-    { delete _M_data; }
     void add_child_number(SizeType size)
     {
         _M_child_number += size;
@@ -46,18 +45,6 @@ struct BTreeNode
         if(_M_parent != nullptr)
         { _M_parent->update_depth(); }
     }
-    template<typename ... Args>
-    BTreeNode* append_left(const Args & ... args)
-    { return set_left(new BTreeNode<ValueType>(_M_left, nullptr, args...)); }
-    template<typename ... Args>
-    BTreeNode* append_right(const Args & ... args)
-    { return set_right(new BTreeNode<ValueType>(_M_right, nullptr, args...)); }
-
-//    BTreeNode* append_left(ConstReference data)
-//    { return set_left(new BTreeNode<ValueType>(_M_left, nullptr, data)); }
-//    BTreeNode* append_right(ConstReference data)
-//    { return set_right(new BTreeNode<ValueType>(_M_right, nullptr, data)); }
-
     BTreeNode* set_parent(BTreeNode *node)
     { return _M_parent = node; }
     BTreeNode* set_left(BTreeNode *node)
@@ -91,9 +78,9 @@ struct BTreeNode
         node->_M_data = _M_data;
         _M_data = temp_data;
     }
-    template<typename ... Args>
-    BTreeNode(BTreeNode *left, BTreeNode *right, const Args & ... args)
-        : _M_data(new NodeBase<ValueType>(args...))
+    // [data] is allocated by the tree
+    BTreeNode(BTreeNode *left, BTreeNode *right, NodeBase<ValueType> *data)
+        : _M_data(data)
     {
         set_left(left);
         set_right(right);
@@ -114,11 +101,14 @@ struct BTreeNode
     { return _M_parent; }
 };
 
-template<typename _DataType, typename _Node = BTreeNode<_DataType>>
+template<typename _DataType,
+         typename _Node = BTreeNode<_DataType>,
+         typename _Alloc = NodeAllocator<_DataType, BinaryTreeStatsTag>>
 class BinaryTree
 {
 public:
     using DataType = _DataType;
+    using AllocatorType = _Alloc;
     using Reference = DataType &;
     using RvalueReference = DataType &&;
     using ConstReference = const DataType &;
@@ -160,7 +150,7 @@ private:
         FormerIterator(const FormerIterator &it)
             : _M_current(it._M_current) { }
         FormerIterator(FormerIterator &&it)
-            : _M_current(forward<FormerIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<FormerIterator>(it)._M_current) { }
 
         FormerIterator operator++()
         {
@@ -170,7 +160,7 @@ private:
         FormerIterator operator++(int)
         {
             FormerIterator it = *this;
-            _M_current = BinaryTree<_DataType>::former_next(_M_current);
+            _M_current = former_next(_M_current);
             return it;
         }
         FormerIterator operator--()
@@ -215,11 +205,11 @@ private:
         ConstFormerIterator(const ConstFormerIterator &it)
             : _M_current(it._M_current) { }
         ConstFormerIterator(ConstFormerIterator &&it)
-            : _M_current(forward<ConstFormerIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ConstFormerIterator>(it)._M_current) { }
         ConstFormerIterator(const FormerIterator &it)
             : _M_current(it._M_current) { }
         ConstFormerIterator(FormerIterator &&it)
-            : _M_current(forward<FormerIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<FormerIterator>(it)._M_current) { }
 
         ConstFormerIterator operator++()
         {
@@ -274,7 +264,7 @@ private:
         MiddleIterator(const MiddleIterator &it)
             : _M_current(it._M_current) { }
         MiddleIterator(MiddleIterator &&it)
-            : _M_current(forward<MiddleIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<MiddleIterator>(it)._M_current) { }
 
         MiddleIterator operator++()
         {
@@ -329,11 +319,11 @@ private:
         ConstMiddleIterator(const ConstMiddleIterator &it)
             : _M_current(it._M_current) { }
         ConstMiddleIterator(ConstMiddleIterator &&it)
-            : _M_current(forward<ConstMiddleIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ConstMiddleIterator>(it)._M_current) { }
         ConstMiddleIterator(const MiddleIterator &it)
             : _M_current(it._M_current) { }
         ConstMiddleIterator(MiddleIterator &&it)
-            : _M_current(forward<MiddleIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<MiddleIterator>(it)._M_current) { }
 
         ConstMiddleIterator operator++()
         {
@@ -371,11 +361,11 @@ private:
         bool operator==(const ConstMiddleIterator &it) const
         { return _M_current == it._M_current; }
         bool operator==(ConstMiddleIterator &&it) const
-        { return _M_current == forward<ConstMiddleIterator>(it)._M_current; }
+        { return _M_current == rapid::forward<ConstMiddleIterator>(it)._M_current; }
         bool operator!=(const ConstMiddleIterator &it) const
         { return _M_current != it._M_current; }
         bool operator!=(ConstMiddleIterator &&it) const
-        { return _M_current != forward<ConstMiddleIterator>(it)._M_current; }
+        { return _M_current != rapid::forward<ConstMiddleIterator>(it)._M_current; }
     };
     class AfterIterator
     {
@@ -392,7 +382,7 @@ private:
         AfterIterator(const AfterIterator &it)
             : _M_current(it._M_current) { }
         AfterIterator(AfterIterator &&it)
-            : _M_current(forward<AfterIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<AfterIterator>(it)._M_current) { }
 
         AfterIterator operator++()
         {
@@ -447,11 +437,11 @@ private:
         ConstAfterIterator(const ConstAfterIterator &it)
             : _M_current(it._M_current) { }
         ConstAfterIterator(ConstAfterIterator &&it)
-            : _M_current(forward<ConstAfterIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ConstAfterIterator>(it)._M_current) { }
         ConstAfterIterator(const AfterIterator &it)
             : _M_current(it._M_current) { }
         ConstAfterIterator(AfterIterator &&it)
-            : _M_current(forward<AfterIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<AfterIterator>(it)._M_current) { }
 
         ConstAfterIterator operator++()
         {
@@ -489,11 +479,11 @@ private:
         bool operator==(const ConstAfterIterator &it) const
         { return _M_current == it._M_current; }
         bool operator==(ConstAfterIterator &&it) const
-        { return _M_current == forward<ConstAfterIterator>(it)._M_current; }
+        { return _M_current == rapid::forward<ConstAfterIterator>(it)._M_current; }
         bool operator!=(const ConstAfterIterator &it) const
         { return _M_current != it._M_current; }
         bool operator!=(ConstAfterIterator &&it) const
-        { return _M_current != forward<ConstAfterIterator>(it)._M_current; }
+        { return _M_current != rapid::forward<ConstAfterIterator>(it)._M_current; }
     };
 
 public:
@@ -581,7 +571,7 @@ private:
         ReverseFormerIterator(const ReverseFormerIterator &it)
             : _M_current(it._M_current) { }
         ReverseFormerIterator(ReverseFormerIterator &&it)
-            : _M_current(forward<ReverseFormerIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ReverseFormerIterator>(it)._M_current) { }
 
         ReverseFormerIterator operator++()
         {
@@ -639,11 +629,11 @@ private:
         ConstReverseFormerIterator(const ConstReverseFormerIterator &it)
             : _M_current(it._M_current) { }
         ConstReverseFormerIterator(ConstReverseFormerIterator &&it)
-            : _M_current(forward<ConstReverseFormerIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ConstReverseFormerIterator>(it)._M_current) { }
         ConstReverseFormerIterator(const ReverseFormerIterator &it)
             : _M_current(it._M_current) { }
         ConstReverseFormerIterator(ReverseFormerIterator &&it)
-            : _M_current(forward<ReverseFormerIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ReverseFormerIterator>(it)._M_current) { }
 
         ConstReverseFormerIterator operator++()
         {
@@ -681,11 +671,11 @@ private:
         bool operator==(const ConstReverseFormerIterator &it) const
         { return _M_current == it._M_current; }
         bool operator==(ConstReverseFormerIterator &&it) const
-        { return _M_current == forward<ConstReverseFormerIterator>(it)._M_current; }
+        { return _M_current == rapid::forward<ConstReverseFormerIterator>(it)._M_current; }
         bool operator!=(const ConstReverseFormerIterator &it) const
         { return _M_current != it._M_current; }
         bool operator!=(ConstReverseFormerIterator &&it) const
-        { return _M_current != forward<ConstReverseFormerIterator>(it)._M_current; }
+        { return _M_current != rapid::forward<ConstReverseFormerIterator>(it)._M_current; }
     };
     class ReverseMiddleIterator
     {
@@ -702,7 +692,7 @@ private:
         ReverseMiddleIterator(const ReverseMiddleIterator &it)
             : _M_current(it._M_current) { }
         ReverseMiddleIterator(ReverseMiddleIterator &&it)
-            : _M_current(forward<ReverseMiddleIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ReverseMiddleIterator>(it)._M_current) { }
 
         ReverseMiddleIterator operator++()
         {
@@ -757,11 +747,11 @@ private:
         ConstReverseMiddleIterator(const ConstReverseMiddleIterator &it)
             : _M_current(it._M_current) { }
         ConstReverseMiddleIterator(ConstReverseMiddleIterator &&it)
-            : _M_current(forward<ConstReverseMiddleIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ConstReverseMiddleIterator>(it)._M_current) { }
         ConstReverseMiddleIterator(const ReverseMiddleIterator &it)
             : _M_current(it._M_current) { }
         ConstReverseMiddleIterator(ReverseMiddleIterator &&it)
-            : _M_current(forward<ReverseMiddleIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ReverseMiddleIterator>(it)._M_current) { }
 
         ConstReverseMiddleIterator operator++()
         {
@@ -799,11 +789,11 @@ private:
         bool operator==(const ConstReverseMiddleIterator &it) const
         { return _M_current == it._M_current; }
         bool operator==(ConstReverseMiddleIterator &&it) const
-        { return _M_current == forward<ConstReverseMiddleIterator>(it)._M_current; }
+        { return _M_current == rapid::forward<ConstReverseMiddleIterator>(it)._M_current; }
         bool operator!=(const ConstReverseMiddleIterator &it) const
         { return _M_current != it._M_current; }
         bool operator!=(ConstReverseMiddleIterator &&it) const
-        { return _M_current != forward<ConstReverseMiddleIterator>(it)._M_current; }
+        { return _M_current != rapid::forward<ConstReverseMiddleIterator>(it)._M_current; }
     };
     class ReverseAfterIterator
     {
@@ -820,7 +810,7 @@ private:
         ReverseAfterIterator(const ReverseAfterIterator &it)
             : _M_current(it._M_current) { }
         ReverseAfterIterator(ReverseAfterIterator &&it)
-            : _M_current(forward<ReverseAfterIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ReverseAfterIterator>(it)._M_current) { }
 
         ReverseAfterIterator operator++()
         {
@@ -875,11 +865,11 @@ private:
         ConstReverseAfterIterator(const ConstReverseAfterIterator &it)
             : _M_current(it._M_current) { }
         ConstReverseAfterIterator(ConstReverseAfterIterator &&it)
-            : _M_current(forward<ConstReverseAfterIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ConstReverseAfterIterator>(it)._M_current) { }
         ConstReverseAfterIterator(const ReverseAfterIterator &it)
             : _M_current(it._M_current) { }
         ConstReverseAfterIterator(ReverseAfterIterator &&it)
-            : _M_current(forward<ReverseAfterIterator>(it)._M_current) { }
+            : _M_current(rapid::forward<ReverseAfterIterator>(it)._M_current) { }
 
         ConstReverseAfterIterator operator++()
         {
@@ -981,6 +971,7 @@ public:
 
 private:
     TreeNode *_M_root = nullptr;
+    AllocatorType _M_alloc;
 
     void _F_copy(const BinaryTree &tree);
 
@@ -988,14 +979,23 @@ private:
 
     template<typename ... Args>
     TreeNode* _F_construct_node(TreeNode *left, TreeNode *right, const Args & ... args)
-    { return new TreeNode(left, right, args...); }
+    { return allocate_object<TreeNode>(_M_alloc, left, right, allocate_data<DataType>(_M_alloc, args...)); }
+    void _F_release_node(TreeNode *node)
+    {
+        release_data(_M_alloc, node->_M_data);
+        release_object(_M_alloc, node);
+    }
 
 public:
     BinaryTree() { }
+    explicit BinaryTree(const AllocatorType &alloc)
+        : _M_alloc(alloc) { }
     BinaryTree(const BinaryTree &tree)
+        : _M_alloc(tree._M_alloc)
     { _F_copy(tree); }
     BinaryTree(BinaryTree &&tree)
-    { _F_copy(forward<BinaryTree>(tree)); }
+        : _M_alloc(tree._M_alloc)
+    { _F_copy(rapid::forward<BinaryTree>(tree)); }
     ~BinaryTree()
     { clear(); }
 
@@ -1011,7 +1011,7 @@ public:
     { return _M_root = _F_construct_node(_M_root, nullptr, args...); }
     template<typename ... Args>
     TreeNode* append_root(Args && ... args)
-    { return _M_root = _F_construct_node(_M_root, nullptr, forward<Args>(args)...); }
+    { return _M_root = _F_construct_node(_M_root, nullptr, rapid::forward<Args>(args)...); }
 
     SizeType size() const
     { return _M_root == nullptr ? 0 : (_M_root->child_size() + 1); }
@@ -1032,14 +1032,22 @@ public:
         TreeNode *node = tree._M_root;
         tree._M_root = _M_root;
         _M_root = node;
+        AllocatorType alloc = tree._M_alloc;
+        tree._M_alloc = _M_alloc;
+        _M_alloc = alloc;
     }
     void swap(BinaryTree &&tree)
     {
-        const BinaryTree &temp = forward<BinaryTree>(tree);
+        const BinaryTree &temp = rapid::forward<BinaryTree>(tree);
         TreeNode *node = temp._M_root;
         temp._M_root = _M_root;
         _M_root = node;
+        AllocatorType alloc = temp._M_alloc;
+        temp._M_alloc = _M_alloc;
+        _M_alloc = alloc;
     }
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
     TreeNode* left_rotate(TreeNode *node);
     TreeNode* right_rotate(TreeNode *node);
 
@@ -1052,12 +1060,12 @@ public:
      */
     TreeNode* erase(TreeNode *node);
 
-    static void release(TreeNode *node)
+    void release(TreeNode *node)
     {
         if(node == nullptr) return;
         release(left_child(node));
         release(right_child(node));
-        delete node;
+        _F_release_node(node);
     }
     static SizeType depth(TreeNode *node)
     { return node == nullptr ? 0 : node->depth(); }
@@ -1067,36 +1075,38 @@ public:
     { return node == nullptr ? nullptr : node->right(); }
     static TreeNode* parent(const TreeNode *node)
     { return node == nullptr ? nullptr : node->parent(); }
-    static TreeNode* set_left(TreeNode *node, TreeNode *child)
+    TreeNode* set_left(TreeNode *node, TreeNode *child)
     {
         if(node == nullptr) return nullptr;
-        release(left_child(node));
+        release(erase_left(node));
         return node->set_left(child);
     }
-    static TreeNode* set_right(TreeNode *node, TreeNode *child)
+    TreeNode* set_right(TreeNode *node, TreeNode *child)
     {
         if(node == nullptr) return nullptr;
-        release(right_child(node));
+        release(erase_right(node));
         return node->set_right(child);
     }
+    // the new node takes the original left child of [node] as its left child
     template<typename ... Args>
-    static TreeNode* append_left(TreeNode *node, const Args & ... args)
-    { return node == nullptr ? nullptr : node->append_left(args...); }
+    TreeNode* append_left(TreeNode *node, const Args & ... args)
+    { return node == nullptr ? nullptr : node->set_left(_F_construct_node(left_child(node), nullptr, args...)); }
     template<typename ... Args>
-    static TreeNode* append_left(TreeNode *node, Args && ... args)
-    { return node == nullptr ? nullptr : node->append_left(forward<Args>(args)...); }
+    TreeNode* append_left(TreeNode *node, Args && ... args)
+    { return node == nullptr ? nullptr : node->set_left(_F_construct_node(left_child(node), nullptr, rapid::forward<Args>(args)...)); }
+    // the new node takes the original right child of [node] as its left child
     template<typename ... Args>
-    static TreeNode* append_right(TreeNode *node, const Args & ... args)
-    { return node == nullptr ? nullptr : node->append_right(args...); }
+    TreeNode* append_right(TreeNode *node, const Args & ... args)
+    { return node == nullptr ? nullptr : node->set_right(_F_construct_node(right_child(node), nullptr, args...)); }
     template<typename ... Args>
-    static TreeNode* append_right(TreeNode *node, Args && ... args)
-    { return node == nullptr ? nullptr : node->append_right(forward<Args>(args)...); }
+    TreeNode* append_right(TreeNode *node, Args && ... args)
+    { return node == nullptr ? nullptr : node->set_right(_F_construct_node(right_child(node), nullptr, rapid::forward<Args>(args)...)); }
 
-    static void remove(TreeNode *node)
+    void remove(TreeNode *node)
     { release(node); }
-    static void remove_left(TreeNode *node)
+    void remove_left(TreeNode *node)
     { set_left(node, nullptr); }
-    static void remove_right(TreeNode *node)
+    void remove_right(TreeNode *node)
     { set_right(node, nullptr); }
     static TreeNode* erase_left(TreeNode *node)
     {
@@ -1126,8 +1136,8 @@ public:
 //-----------------------impl-----------------------//
 //-----------------------impl-----------------------//
 
-template<typename _DataType, typename _Node>
-void BinaryTree<_DataType, _Node>::_F_copy_tree(TreeNode *src, TreeNode *dst)
+template<typename _DataType, typename _Node, typename _Alloc>
+void BinaryTree<_DataType, _Node, _Alloc>::_F_copy_tree(TreeNode *src, TreeNode *dst)
 {
     if(left_child(dst) != nullptr)
     {
@@ -1141,8 +1151,8 @@ void BinaryTree<_DataType, _Node>::_F_copy_tree(TreeNode *src, TreeNode *dst)
     }
 }
 
-template<typename _DataType, typename _Node>
-void BinaryTree<_DataType, _Node>::_F_copy(const BinaryTree &tree)
+template<typename _DataType, typename _Node, typename _Alloc>
+void BinaryTree<_DataType, _Node, _Alloc>::_F_copy(const BinaryTree &tree)
 {
     clear();
     if(tree.empty())
@@ -1179,9 +1189,9 @@ void BinaryTree<_DataType, _Node>::_F_copy(const BinaryTree &tree)
 //        dst.push(new_node);
 //    }
 }
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::right_rotate(TreeNode *node)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::right_rotate(TreeNode *node)
 {
     TreeNode *left_node = left_child(node);
     if(left_node == nullptr) return nullptr;
@@ -1223,9 +1233,9 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
     return left_node;
 }
 
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::left_rotate(TreeNode *node)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::left_rotate(TreeNode *node)
 {
     TreeNode *right_node = right_child(node);
     if(right_node == nullptr) return nullptr;
@@ -1268,33 +1278,33 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
 }
 
 //---------------------***************---------------------//
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::left_child_under(TreeNode *node)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::left_child_under(TreeNode *node)
 {
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     while(node != nullptr && BT::left_child(node) != nullptr)
     {
         node = BT::left_child(node);
     }
     return node;
 }
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::right_child_under(TreeNode *node)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::right_child_under(TreeNode *node)
 {
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     while(node != nullptr && BT::right_child(node) != nullptr)
     {
         node = BT::right_child(node);
     }
     return node;
 }
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::left_leaves(TreeNode *node)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::left_leaves(TreeNode *node)
 {
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     node = left_child_under(node);
     while(BT::right_child(node) != nullptr)
     {
@@ -1302,11 +1312,11 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
     }
     return node;
 }
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::right_leaves(TreeNode *node)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::right_leaves(TreeNode *node)
 {
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     node = right_child_under(node);
     while(BT::left_child(node) != nullptr)
     {
@@ -1315,12 +1325,12 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
     return node;
 }
 
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::former_next(TreeNode *current)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::former_next(TreeNode *current)
 {
     using namespace rapid;
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     using Node = typename BT::TreeNode;
     if(BT::left_child(current) != nullptr)
     {
@@ -1339,12 +1349,12 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
     }
     return BT::right_child(current);
 }
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::middle_next(TreeNode *current)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::middle_next(TreeNode *current)
 {
     using namespace rapid;
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     using Node = typename BT::TreeNode;
     if(BT::right_child(current) != nullptr)
     {
@@ -1364,12 +1374,12 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
     return current;
 }
 
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::after_next(TreeNode *current)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::after_next(TreeNode *current)
 {
     using namespace rapid;
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     if(current == BT::left_child(BT::parent(current)))
     {
         if(BT::right_child(BT::parent(current)) == nullptr)
@@ -1385,12 +1395,12 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
     return nullptr;
 }
 
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::former_previous(TreeNode *current)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::former_previous(TreeNode *current)
 {
     using namespace rapid;
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     if(current == BT::left_child(BT::parent(current)))
     {
         return BT::parent(current);
@@ -1406,12 +1416,12 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
     }
     return nullptr;
 }
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::middle_previous(TreeNode *current)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::middle_previous(TreeNode *current)
 {
     using namespace rapid;
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     if(BT::left_child(current) != nullptr)
     {
         return right_child_under(BT::left_child(current));
@@ -1427,12 +1437,12 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
     return BT::parent(current);
 }
 
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::after_previous(TreeNode *current)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::after_previous(TreeNode *current)
 {
     using namespace rapid;
-    using BT = BinaryTree<_DataType>;
+    using BT = BinaryTree;
     if(BT::right_child(current) != nullptr)
     {
         return BT::right_child(current);
@@ -1463,9 +1473,9 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
 }
 //---------------------***************---------------------//
 //---------------------------------------------------------//
-template<typename _DataType, typename _Node>
-typename BinaryTree<_DataType, _Node>::TreeNode*
-    BinaryTree<_DataType, _Node>::erase(TreeNode *node)
+template<typename _DataType, typename _Node, typename _Alloc>
+typename BinaryTree<_DataType, _Node, _Alloc>::TreeNode*
+    BinaryTree<_DataType, _Node, _Alloc>::erase(TreeNode *node)
 {
     if(node == nullptr) return nullptr;
 
@@ -1496,7 +1506,7 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
             temp = reserve_parent;
         }
         node->swap(reserve);
-        delete reserve;
+        _F_release_node(reserve);
         return temp;
     }
     else
@@ -1524,7 +1534,7 @@ typename BinaryTree<_DataType, _Node>::TreeNode*
             temp = reserve_parent;
         }
         node->swap(reserve);
-        delete reserve;
+        _F_release_node(reserve);
         return temp;
     }
 }
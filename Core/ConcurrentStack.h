@@ -0,0 +1,185 @@
+#ifndef CONCURRENTSTACK_H
+#define CONCURRENTSTACK_H
+
+#include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include "Core/TLNode.h"
+#include "Core/Atomic.h"
+#include "Core/HazardPointer.h"
+#include "Core/Allocator.h"
+
+namespace rapid
+{
+
+/* lock-free stack (Treiber stack) shared by any number of threads
+ * a popping thread protects the top node with a hazard pointer before reading it, so the node
+ * is neither freed nor reused under it, popped nodes are retired and given back to the
+ * allocator in batches once no hazard pointer holds them
+ * the element is kept in the node, one allocation per push, and the default allocator
+ * recycles nodes through per-thread pools
+ * param[_Alloc]: allocator of the nodes
+ */
+template<typename T, typename _Alloc = NodeAllocator<T, ConcurrentStackStatsTag>>
+class ConcurrentStack
+{
+public:
+    using ValueType = T;
+    using Reference = ValueType&;
+    using ConstReference = const ValueType &;
+    using RvalueReference = ValueType&&;
+    using SizeType = size_type;
+    using AllocatorType = _Alloc;
+
+    using value_type = ValueType;// std
+    using allocator_type = AllocatorType;// std
+private:
+    struct Node
+    {
+        Node *Next = nullptr;
+        Node *Retired = nullptr;// link of the retired list, Next may still be read by a popper
+        NodeBase<ValueType> Data;
+    };
+
+    // retired nodes are scanned when there are this many at least
+    static constexpr SizeType RetireBatch = 64;
+
+    AllocatorType _M_alloc;
+    alignas(CacheLineSize) Atomic<Node *> _M_top;
+    alignas(CacheLineSize) Atomic<Node *> _M_retired;
+    Atomic<SizeType> _M_retired_count;
+
+    void _F_push(Node *n)
+    {
+        n->Next = _M_top.load(MemoryOrder::Relaxed);
+        while(!_M_top.compare_exchange_weak(n->Next, n, MemoryOrder::Release, MemoryOrder::Relaxed))
+        { }
+    }
+    // push the chain from [first] to [last] linked by Retired to the retired list
+    void _F_push_retired(Node *first, Node *last, SizeType count)
+    {
+        last->Retired = _M_retired.load(MemoryOrder::Relaxed);
+        while(!_M_retired.compare_exchange_weak(last->Retired, first, MemoryOrder::Release, MemoryOrder::Relaxed))
+        { }
+        _M_retired_count.fetch_add(count, MemoryOrder::Relaxed);
+    }
+    void _F_retire(Node *n)
+    {
+        _F_push_retired(n, n, 1);
+        // the threshold grows with the threads, so a scan frees most of the nodes it looks at
+        SizeType threshold = RetireBatch + 2 * HazardRecord::SlotCount * hazard_record_count();
+        if(_M_retired_count.load(MemoryOrder::Relaxed) >= threshold)
+        { _F_reclaim(); }
+    }
+    // free the retired nodes not protected, the others are retired again
+    void _F_reclaim()
+    {
+        Node *n = _M_retired.exchange(nullptr, MemoryOrder::Acquire);
+        // the nodes were unlinked before, a reader protecting them after this fence sees a new top
+        atomic_thread_fence(MemoryOrder::SeqCst);
+        Node *first = nullptr, *last = nullptr;
+        SizeType taken = 0, kept = 0;
+        while(n != nullptr)
+        {
+            Node *next = n->Retired;
+            taken++;
+            if(hazard_protected(n))
+            {
+                n->Retired = first;
+                first = n;
+                if(last == nullptr) last = n;
+                kept++;
+            }
+            else
+            { release_object(_M_alloc, n); }
+            n = next;
+        }
+        _M_retired_count.fetch_sub(taken, MemoryOrder::Relaxed);
+        if(first != nullptr)
+        { _F_push_retired(first, last, kept); }
+    }
+public:
+    ConcurrentStack() { }
+    explicit ConcurrentStack(const AllocatorType &alloc)
+        : _M_alloc(alloc) { }
+    ConcurrentStack(const ConcurrentStack &) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack &) = delete;
+    // no thread may use the stack any more
+    ~ConcurrentStack()
+    {
+        Node *n = _M_top.load(MemoryOrder::Acquire);
+        while(n != nullptr)
+        {
+            Node *next = n->Next;
+            n->Data.destruct();
+            release_object(_M_alloc, n);
+            n = next;
+        }
+        n = _M_retired.load(MemoryOrder::Acquire);
+        while(n != nullptr)
+        {
+            Node *next = n->Retired;
+            release_object(_M_alloc, n);
+            n = next;
+        }
+    }
+
+    void push(ConstReference arg)
+    {
+        Node *n = allocate_object<Node>(_M_alloc);
+        try
+        { n->Data.construct(arg); }
+        catch(...)
+        {
+            release_object(_M_alloc, n);
+            throw;
+        }
+        _F_push(n);
+    }
+    void push(RvalueReference arg)
+    {
+        Node *n = allocate_object<Node>(_M_alloc);
+        try
+        { ::new(n->Data.address()) ValueType(rapid::move(arg)); }
+        catch(...)
+        {
+            release_object(_M_alloc, n);
+            throw;
+        }
+        _F_push(n);
+    }
+
+    /* param[out]: assigned by the element popped
+     * return: false if the stack is empty
+     */
+    bool try_pop(Reference out)
+    {
+        Node *top;
+        while(true)
+        {
+            top = hazard_protect(0, _M_top);
+            if(top == nullptr)
+            {
+                hazard_clear(0);
+                return false;
+            }
+            // [top] is protected, its Next can be read even if another thread pops it now
+            if(_M_top.compare_exchange_weak(top, top->Next, MemoryOrder::AcqRel, MemoryOrder::Relaxed))
+            { break; }
+        }
+        hazard_clear(0);
+        out = rapid::move(top->Data.ref_content());
+        top->Data.destruct();
+        _F_retire(top);
+        return true;
+    }
+
+    // exact only if no thread is pushing or popping
+    bool empty() const
+    { return _M_top.load(MemoryOrder::Acquire) == nullptr; }
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
+};
+
+};
+
+#endif // CONCURRENTSTACK_H
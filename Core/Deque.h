@@ -0,0 +1,488 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include "Core/TypeTraits.h"
+#include "Core/Version.h"
+#include "Core/Exception.h"
+#include "Core/Memory.h"
+#include "Core/Allocator.h"
+#include <initializer_list>
+#include <iterator> // std::random_access_iterator_tag
+
+namespace rapid
+{
+
+/* double ended queue kept in fixed size blocks listed by a map of block pointers
+ * push and pop at both ends are O(1), only the map is copied when it grows, so the
+ * elements never move and their addresses stay valid until they are popped
+ * a block emptied by a pop is kept for the next push, so a FIFO whose length stays
+ * about the same does not allocate
+ * iterators are invalidated by a push or a pop, references only by erasing their element
+ */
+template<typename T, typename _Alloc = ContainerAllocator<T, DequeStatsTag>>
+class Deque
+{
+public:
+    using ValueType = T;
+    using Pointer = ValueType*;
+    using ConstPointer = const ValueType*;
+    using Reference = ValueType&;
+    using ConstReference = const ValueType &;
+    using RvalueReference = ValueType&&;
+    using SizeType = size_type;
+    using DifferenceType = long long;
+    using AllocatorType = _Alloc;
+
+    using value_type = ValueType;// std
+    using allocator_type = AllocatorType;// std
+
+    // elements of a block, a power of 2 of about 512 bytes and at least 16 elements
+    static constexpr SizeType BlockSize = sizeof(ValueType) * 16 >= 512 ? 16 :
+                                          sizeof(ValueType) * 32 >= 512 ? 32 :
+                                          sizeof(ValueType) * 64 >= 512 ? 64 :
+                                          sizeof(ValueType) * 128 >= 512 ? 128 :
+                                          sizeof(ValueType) * 256 >= 512 ? 256 : 512;
+    // empty blocks kept for later pushes, shrink_to_fit() gives them back
+    static constexpr SizeType SpareLimit = 4;
+private:
+    using DataAllocator = RebindAllocator<AllocatorType, ValueType>;
+    using DataTraits = std::allocator_traits<DataAllocator>;
+    using MapAllocator = RebindAllocator<AllocatorType, Pointer>;
+    using MapTraits = std::allocator_traits<MapAllocator>;
+
+    AllocatorType _M_alloc;
+    Pointer *_M_map = nullptr;
+    SizeType _M_map_size = 0;
+    // position of the front element, counted from the first element of block 0 of the map
+    SizeType _M_start = 0;
+    SizeType _M_size = 0;
+    Pointer _M_spare[SpareLimit];
+    SizeType _M_spare_count = 0;
+
+    Pointer _F_block()
+    {
+        if(_M_spare_count > 0)
+        { return _M_spare[--_M_spare_count]; }
+        DataAllocator a(_M_alloc);
+        return DataTraits::allocate(a, BlockSize);
+    }
+    void _F_release_block(Pointer block)
+    {
+        if(_M_spare_count < SpareLimit)
+        {
+            _M_spare[_M_spare_count++] = block;
+            return;
+        }
+        DataAllocator a(_M_alloc);
+        DataTraits::deallocate(a, block, BlockSize);
+    }
+    // the block holding [position], it is created if the map slot is empty
+    Pointer _F_block_of(SizeType position)
+    {
+        Pointer &block = _M_map[position / BlockSize];
+        if(block == nullptr)
+        { block = _F_block(); }
+        return block;
+    }
+    // the slot of block [b] is not used by an element any more
+    void _F_drop_block(SizeType b)
+    {
+        if(_M_map[b] == nullptr) return;
+        _F_release_block(_M_map[b]);
+        _M_map[b] = nullptr;
+    }
+    /* make room in the map for a push at the front or at the back
+     * the blocks in use are put in the middle of the map, which doubles only if they
+     * fill half of it, so a FIFO moving through the map keeps the same one
+     */
+    void _F_grow_map();
+    Reference _F_at(SizeType i) const
+    {
+        SizeType position = _M_start + i;
+        return _M_map[position / BlockSize][position % BlockSize];
+    }
+    void _F_copy_data(const Deque &d)
+    {
+        clear();
+        for(SizeType i = 0; i < d.size(); ++i)
+        { push_back(d._F_at(i)); }
+    }
+    void _F_move_data(Deque &d)
+    {
+        clear();
+        _F_free();
+        _M_map = d._M_map;
+        _M_map_size = d._M_map_size;
+        _M_start = d._M_start;
+        _M_size = d._M_size;
+        d._M_map = nullptr;
+        d._M_map_size = 0;
+        d._M_start = 0;
+        d._M_size = 0;
+    }
+    // give every block and the map back, the elements must be destroyed
+    void _F_free();
+    template<typename ... Args>
+    void _F_push_back(Args && ... args);
+    template<typename ... Args>
+    void _F_push_front(Args && ... args);
+public:
+    template<typename _Value>
+    class basic_iterator
+    {
+    private:
+        const Deque *_M_deque;
+        SizeType _M_index;
+
+        friend class Deque;
+
+        basic_iterator(const Deque *d, SizeType index) : _M_deque(d), _M_index(index) { }
+    public:
+        using iterator_category = std::random_access_iterator_tag;// std
+        using value_type = ValueType;// std
+        using difference_type = DifferenceType;// std
+        using pointer = _Value*;// std
+        using reference = _Value&;// std
+
+        basic_iterator() : _M_deque(nullptr), _M_index(0) { }
+        // also converts iterator to const_iterator
+        basic_iterator(const basic_iterator<ValueType> &it) : _M_deque(it._M_deque), _M_index(it._M_index) { }
+
+        _Value& operator*() const
+        { return _M_deque->_F_at(_M_index); }
+        _Value* operator->() const
+        { return &_M_deque->_F_at(_M_index); }
+        _Value& operator[](DifferenceType n) const
+        { return _M_deque->_F_at(_M_index + static_cast<SizeType>(n)); }
+
+        basic_iterator& operator++()
+        {
+            ++_M_index;
+            return *this;
+        }
+        basic_iterator operator++(int)
+        {
+            basic_iterator it = *this;
+            ++_M_index;
+            return it;
+        }
+        basic_iterator& operator--()
+        {
+            --_M_index;
+            return *this;
+        }
+        basic_iterator operator--(int)
+        {
+            basic_iterator it = *this;
+            --_M_index;
+            return it;
+        }
+        basic_iterator& operator+=(DifferenceType n)
+        {
+            _M_index += static_cast<SizeType>(n);
+            return *this;
+        }
+        basic_iterator& operator-=(DifferenceType n)
+        {
+            _M_index -= static_cast<SizeType>(n);
+            return *this;
+        }
+        basic_iterator operator+(DifferenceType n) const
+        { return basic_iterator(*this) += n; }
+        basic_iterator operator-(DifferenceType n) const
+        { return basic_iterator(*this) -= n; }
+        DifferenceType operator-(const basic_iterator &it) const
+        { return static_cast<DifferenceType>(_M_index - it._M_index); }
+
+        bool operator==(const basic_iterator &it) const
+        { return _M_index == it._M_index; }
+        bool operator!=(const basic_iterator &it) const
+        { return _M_index != it._M_index; }
+        bool operator<(const basic_iterator &it) const
+        { return _M_index < it._M_index; }
+        bool operator>(const basic_iterator &it) const
+        { return _M_index > it._M_index; }
+        bool operator<=(const basic_iterator &it) const
+        { return _M_index <= it._M_index; }
+        bool operator>=(const basic_iterator &it) const
+        { return _M_index >= it._M_index; }
+
+        template<typename>
+        friend class basic_iterator;
+    };
+
+    using iterator = basic_iterator<ValueType>;
+    using const_iterator = basic_iterator<const ValueType>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    Deque() { }
+    explicit Deque(const AllocatorType &alloc) : _M_alloc(alloc) { }
+    Deque(const Deque &d) : _M_alloc(d._M_alloc)
+    { _F_copy_data(d); }
+    Deque(Deque &&d) : _M_alloc(d._M_alloc)
+    { _F_move_data(d); }
+    Deque(std::initializer_list<ValueType> arg)
+    {
+        for(auto it = arg.begin(); it != arg.end(); ++it)
+        { push_back(*it); }
+    }
+    ~Deque()
+    {
+        clear();
+        _F_free();
+    }
+
+    Deque& operator=(const Deque &d)
+    {
+        if(this != &d)
+        { _F_copy_data(d); }
+        return *this;
+    }
+    Deque& operator=(Deque &&d)
+    {
+        if(this != &d)
+        { _F_move_data(d); }
+        return *this;
+    }
+
+    void push_back(ConstReference arg)
+    { _F_push_back(arg); }
+    void push_back(RvalueReference arg)
+    { _F_push_back(rapid::move(arg)); }
+    void push_front(ConstReference arg)
+    { _F_push_front(arg); }
+    void push_front(RvalueReference arg)
+    { _F_push_front(rapid::move(arg)); }
+    template<typename ... Args>
+    Reference emplace_back(Args && ... args)
+    {
+        _F_push_back(rapid::forward<Args>(args)...);
+        return back();
+    }
+    template<typename ... Args>
+    Reference emplace_front(Args && ... args)
+    {
+        _F_push_front(rapid::forward<Args>(args)...);
+        return front();
+    }
+
+    void pop_back();
+    void pop_front();
+
+    // destroy the elements, the blocks are kept as spares up to SpareLimit
+    void clear();
+    // give back the spare blocks and shrink the map to the blocks in use
+    void shrink_to_fit();
+
+    Reference operator[](const SizeType index)
+    { return _F_at(index); }
+    ConstReference operator[](const SizeType index) const
+    { return _F_at(index); }
+    Reference at(const SizeType index)
+    {
+        if(index >= size())
+        { throw IndexOutOfArrayException("exception: index out of array !"); }
+        return _F_at(index);
+    }
+
+    Reference front()
+    { return _F_at(0); }
+    ConstReference front() const
+    { return _F_at(0); }
+    Reference back()
+    { return _F_at(_M_size - 1); }
+    ConstReference back() const
+    { return _F_at(_M_size - 1); }
+
+    iterator begin()
+    { return iterator(this, 0); }
+    iterator end()
+    { return iterator(this, _M_size); }
+    const_iterator begin() const
+    { return const_iterator(this, 0); }
+    const_iterator end() const
+    { return const_iterator(this, _M_size); }
+    const_iterator cbegin() const
+    { return begin(); }
+    const_iterator cend() const
+    { return end(); }
+
+    reverse_iterator rbegin()
+    { return reverse_iterator(end()); }
+    reverse_iterator rend()
+    { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const
+    { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const
+    { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const
+    { return rbegin(); }
+    const_reverse_iterator crend() const
+    { return rend(); }
+
+    SizeType size() const
+    { return _M_size; }
+    bool empty() const
+    { return _M_size == 0; }
+    // slots of the map, each one may hold a block
+    SizeType map_size() const
+    { return _M_map_size; }
+    SizeType spare_blocks() const
+    { return _M_spare_count; }
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
+};
+
+//-----------------------impl-----------------------//
+template<typename T, typename _Alloc>
+void Deque<T, _Alloc>::_F_grow_map()
+{
+    SizeType first = _M_start / BlockSize;
+    SizeType used = _M_size == 0 ? 0 : (_M_start + _M_size - 1) / BlockSize - first + 1;
+    SizeType size = _M_map_size < 8 ? 8 : _M_map_size;
+    if(used * 2 + 2 > size)
+    { size *= 2; }
+    SizeType target = (size - used) / 2;
+    // blocks outside the elements are spares now
+    for(SizeType i = 0; i < _M_map_size; ++i)
+    {
+        if(i < first || i >= first + used)
+        { _F_drop_block(i); }
+    }
+    if(size == _M_map_size)
+    {
+        // the same map, the slots in use are moved to the middle, the spare slots stay empty
+        if(target < first)
+        {
+            for(SizeType i = 0; i < used; ++i)
+            { _M_map[target + i] = _M_map[first + i]; }
+        }
+        else
+        {
+            for(SizeType i = used; i > 0; --i)
+            { _M_map[target + i - 1] = _M_map[first + i - 1]; }
+        }
+        for(SizeType i = 0; i < _M_map_size; ++i)
+        {
+            if(i < target || i >= target + used)
+            { _M_map[i] = nullptr; }
+        }
+    }
+    else
+    {
+        MapAllocator a(_M_alloc);
+        Pointer *map = MapTraits::allocate(a, size);
+        for(SizeType i = 0; i < size; ++i)
+        { map[i] = i >= target && i < target + used ? _M_map[first + i - target] : nullptr; }
+        if(_M_map != nullptr)
+        { MapTraits::deallocate(a, _M_map, _M_map_size); }
+        _M_map = map;
+        _M_map_size = size;
+    }
+    _M_start = target * BlockSize + _M_start % BlockSize;
+}
+
+template<typename T, typename _Alloc>
+void Deque<T, _Alloc>::_F_free()
+{
+    DataAllocator a(_M_alloc);
+    for(SizeType i = 0; i < _M_map_size; ++i)
+    {
+        if(_M_map[i] != nullptr)
+        { DataTraits::deallocate(a, _M_map[i], BlockSize); }
+    }
+    while(_M_spare_count > 0)
+    { DataTraits::deallocate(a, _M_spare[--_M_spare_count], BlockSize); }
+    if(_M_map != nullptr)
+    {
+        MapAllocator m(_M_alloc);
+        MapTraits::deallocate(m, _M_map, _M_map_size);
+    }
+    _M_map = nullptr;
+    _M_map_size = 0;
+    _M_start = 0;
+}
+
+template<typename T, typename _Alloc>
+template<typename ... Args>
+void Deque<T, _Alloc>::_F_push_back(Args && ... args)
+{
+    if((_M_start + _M_size) / BlockSize >= _M_map_size)
+    { _F_grow_map(); }
+    SizeType position = _M_start + _M_size;
+    ::new(static_cast<void *>(_F_block_of(position) + position % BlockSize)) ValueType(rapid::forward<Args>(args)...);
+    ++_M_size;
+}
+
+template<typename T, typename _Alloc>
+template<typename ... Args>
+void Deque<T, _Alloc>::_F_push_front(Args && ... args)
+{
+    if(_M_start == 0)
+    { _F_grow_map(); }
+    SizeType position = _M_start - 1;
+    ::new(static_cast<void *>(_F_block_of(position) + position % BlockSize)) ValueType(rapid::forward<Args>(args)...);
+    --_M_start;
+    ++_M_size;
+}
+
+template<typename T, typename _Alloc>
+void Deque<T, _Alloc>::pop_back()
+{
+    SizeType position = _M_start + _M_size - 1;
+    rapid::destroy(&_F_at(_M_size - 1), 1);
+    --_M_size;
+    if(position % BlockSize == 0 || _M_size == 0)
+    { _F_drop_block(position / BlockSize); }
+}
+
+template<typename T, typename _Alloc>
+void Deque<T, _Alloc>::pop_front()
+{
+    SizeType position = _M_start;
+    rapid::destroy(&_F_at(0), 1);
+    ++_M_start;
+    --_M_size;
+    if(_M_start % BlockSize == 0 || _M_size == 0)
+    { _F_drop_block(position / BlockSize); }
+}
+
+template<typename T, typename _Alloc>
+void Deque<T, _Alloc>::clear()
+{
+    for(SizeType i = 0; i < _M_size; ++i)
+    { rapid::destroy(&_F_at(i), 1); }
+    for(SizeType i = 0; i < _M_map_size; ++i)
+    { _F_drop_block(i); }
+    _M_size = 0;
+    _M_start = _M_map_size / 2 * BlockSize;
+}
+
+template<typename T, typename _Alloc>
+void Deque<T, _Alloc>::shrink_to_fit()
+{
+    DataAllocator a(_M_alloc);
+    while(_M_spare_count > 0)
+    { DataTraits::deallocate(a, _M_spare[--_M_spare_count], BlockSize); }
+    if(_M_size == 0)
+    {
+        _F_free();
+        return;
+    }
+    SizeType first = _M_start / BlockSize;
+    SizeType used = (_M_start + _M_size - 1) / BlockSize - first + 1;
+    if(used == _M_map_size) return;
+    MapAllocator m(_M_alloc);
+    Pointer *map = MapTraits::allocate(m, used);
+    for(SizeType i = 0; i < used; ++i)
+    { map[i] = _M_map[first + i]; }
+    MapTraits::deallocate(m, _M_map, _M_map_size);
+    _M_map = map;
+    _M_map_size = used;
+    _M_start %= BlockSize;
+}
+
+};
+
+#endif // DEQUE_H
@@ -2,19 +2,22 @@
 #define DOUBLELINKEDLIST_H
 
 #include "Core/TLNode.h"
+#include "Core/Allocator.h"
 #include "Core/TypeTraits.h"
 #include "Core/Version.h"
 #include "Core/Compare.h"
+#include "Core/Exception.h"
 #include <initializer_list>
 
 namespace rapid
 {
 
-template<typename T>
+template<typename T, typename _Alloc = NodeAllocator<T, DoubleLinkedListStatsTag>>
 class DoubleLinkedList
 {
 public:
     using ValueType = T;
+    using AllocatorType = _Alloc;
     using Pointer = ValueType*;
     using Reference = ValueType&;
     using ConstReference = const ValueType &;
@@ -33,9 +36,8 @@ private:
         Node *Next;
         Node *Previous;
 
-        template<typename ... Args>
-        Node(Node *p, Node *n, const Args & ... args)
-            : Data(new NodeBase<ValueType>(args...)), Next(n), Previous(p)
+        Node(Node *p, Node *n, NodeBase<ValueType> *data)
+            : Data(data), Next(n), Previous(p)
         {
             if(p != nullptr)
             { p->Next = this; }
@@ -43,8 +45,6 @@ private:
             { n->Previous = this; }
         }
 
-        ~Node()
-        { delete Data; }
         void dealloc()
         {
             if(Next != nullptr)
@@ -64,13 +64,19 @@ private:
         }
     };
 
+    AllocatorType _M_alloc;
     Node *_M_head = nullptr;
     Node *_M_tail = nullptr;
     SizeType _M_size = 0;
 
     template<typename ... Args>
     Node* _F_construct_node(Node *p, Node *n, const Args & ... args)
-    { return new Node(p, n, args...); }
+    { return allocate_object<Node>(_M_alloc, p, n, allocate_data<ValueType>(_M_alloc, args...)); }
+    void _F_release_node(Node *n)
+    {
+        release_data(_M_alloc, n->Data);
+        release_object(_M_alloc, n);
+    }
 
     void _F_add_size(SizeType i)
     { _M_size += i; }
@@ -104,7 +110,7 @@ public:
         iterator(const iterator &it)
             : _M_current(it._M_current) { }
         iterator(iterator && it)
-            : _M_current(forward<iterator>(it)._M_current) { }
+            : _M_current(rapid::forward<iterator>(it)._M_current) { }
 
         iterator operator++()
         {
@@ -160,7 +166,7 @@ public:
         reverse_iterator(const reverse_iterator &it)
             : _M_current(it._M_current) { }
         reverse_iterator(reverse_iterator && it)
-            : _M_current(forward<reverse_iterator>(it)._M_current) { }
+            : _M_current(rapid::forward<reverse_iterator>(it)._M_current) { }
 
         reverse_iterator operator++()
         {
@@ -218,11 +224,11 @@ public:
         const_iterator(const const_iterator &it)
             : _M_current(it._M_current) { }
         const_iterator(const_iterator && it)
-            : _M_current(forward<const_iterator>(it)._M_current) { }
+            : _M_current(rapid::forward<const_iterator>(it)._M_current) { }
         const_iterator(const iterator &it)
             : _M_current(it._M_current) { }
         const_iterator(iterator &&it)
-            : _M_current(forward<iterator>(it)._M_current) { }
+            : _M_current(rapid::forward<iterator>(it)._M_current) { }
 
         const_iterator operator++()
         {
@@ -281,11 +287,11 @@ public:
         const_reverse_iterator(const const_reverse_iterator &it)
             : _M_current(it._M_current) { }
         const_reverse_iterator(const_reverse_iterator && it)
-            : _M_current(forward<const_reverse_iterator>(it)._M_current) { }
+            : _M_current(rapid::forward<const_reverse_iterator>(it)._M_current) { }
         const_reverse_iterator(const reverse_iterator &it)
             : _M_current(it._M_current) { }
         const_reverse_iterator(reverse_iterator &&it)
-            : _M_current(forward<reverse_iterator>(it)._M_current) { }
+            : _M_current(rapid::forward<reverse_iterator>(it)._M_current) { }
 
         const_reverse_iterator operator++()
         {
@@ -322,7 +328,10 @@ public:
     };
 
     DoubleLinkedList() { }
-    DoubleLinkedList(const DoubleLinkedList<ValueType> &dll)
+    explicit DoubleLinkedList(const AllocatorType &alloc)
+        : _M_alloc(alloc) { }
+    DoubleLinkedList(const DoubleLinkedList &dll)
+        : _M_alloc(dll._M_alloc)
     { insert<const_iterator>(cend(), dll.begin(), dll.end()); }
     template<typename IteratorType>
     DoubleLinkedList(const IteratorType &b, const IteratorType &e)
@@ -340,15 +349,18 @@ public:
     bool empty() const
     { return size() == 0; }
 
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
+
     iterator push_back(ConstReference arg)
     { return insert(end(), arg); }
     iterator push_back(RvalueReference arg)
-    { return insert(end(), forward<ValueType>(arg)); }
+    { return insert(end(), rapid::forward<ValueType>(arg)); }
 
     iterator push_front(ConstReference arg)
     { return insert(begin(), arg); }
     iterator push_front(RvalueReference arg)
-    { return insert(begin(), forward<ValueType>(arg)); }
+    { return insert(begin(), rapid::forward<ValueType>(arg)); }
 
     void pop_back()
     { erase(iterator(_M_tail)); }
@@ -363,12 +375,12 @@ public:
     iterator insert(iterator it, ConstReference arg)
     { return _F_insert(it, arg); }
     iterator insert(iterator it, RvalueReference arg)
-    { return _F_insert(it, forward<ValueType>(arg)); }
+    { return _F_insert(it, rapid::forward<ValueType>(arg)); }
 
     iterator insert(const_iterator it, ConstReference arg)
     { return _F_insert(it, arg); }
     iterator insert(const_iterator it, RvalueReference arg)
-    { return _F_insert(it, forward<ValueType>(arg)); }
+    { return _F_insert(it, rapid::forward<ValueType>(arg)); }
 
     template<typename IteratorType>
     iterator insert(const_iterator pos, IteratorType b, IteratorType e);
@@ -401,14 +413,22 @@ public:
     { return const_reverse_iterator(_M_tail == nullptr ? nullptr : _M_head->Previous); }
 
     Reference front() const
-    { return _M_head == nullptr ? NodeBase<ValueType>().ref_content() : _M_head->data(); }
+    {
+        if(_M_head == nullptr)
+        { throw IndexOutOfArrayException("exception: front of an empty list !"); }
+        return _M_head->data();
+    }
     Reference back() const
-    { return _M_tail == nullptr ? NodeBase<ValueType>().ref_content() : _M_tail->data(); }
+    {
+        if(_M_tail == nullptr)
+        { throw IndexOutOfArrayException("exception: back of an empty list !"); }
+        return _M_tail->data();
+    }
 
     iterator find(ConstReference arg)
     { return _F_find(arg); }
     iterator find(RvalueReference arg)
-    { return _F_find(forward<ValueType>(arg)); }
+    { return _F_find(rapid::forward<ValueType>(arg)); }
 
     void reverse();
 
@@ -417,13 +437,13 @@ public:
     { return _F_insert(begin(), args...); }
     template<typename ... Args>
     iterator emplace_front(Args && ... args)
-    { return _F_insert(begin(), forward<Args>(args)...); }
+    { return _F_insert(begin(), rapid::forward<Args>(args)...); }
     template<typename ... Args>
     iterator emplace_back(const Args & ... args)
     { return _F_insert(end(), args...); }
     template<typename ... Args>
     iterator emplace_back(Args && ... args)
-    { return _F_insert(end(), forward<Args>(args)...); }
+    { return _F_insert(end(), rapid::forward<Args>(args)...); }
     template<typename ... Args>
     iterator emplace(const_iterator it, const Args & ... args)
     { return _F_insert(it._F_const_cast(), args...); }
@@ -432,10 +452,10 @@ public:
     { return _F_insert(it, args...); }
     template<typename ... Args>
     iterator emplace(const_iterator it, Args && ... args)
-    { return _F_insert(it._F_const_cast(), forward<Args>(args)...); }
+    { return _F_insert(it._F_const_cast(), rapid::forward<Args>(args)...); }
     template<typename ... Args>
     iterator emplace(iterator it, Args && ... args)
-    { return _F_insert(it, forward<Args...>(args...)); }
+    { return _F_insert(it, rapid::forward<Args...>(args...)); }
 
     void sort()
     { sort(Compare<ValueType>()); }
@@ -447,10 +467,10 @@ public:
 //-----------------------impl-----------------------//
 //-----------------------impl-----------------------//
 //-----------------------impl-----------------------//
-template<typename T>
+template<typename T, typename _Alloc>
 template<typename ... Args>
-typename DoubleLinkedList<T>::iterator
-    DoubleLinkedList<T>::_F_insert(const_iterator it, const Args & ... args)
+typename DoubleLinkedList<T, _Alloc>::iterator
+    DoubleLinkedList<T, _Alloc>::_F_insert(const_iterator it, const Args & ... args)
 {
     _F_add_size(1);
     if(it == cend())
@@ -471,10 +491,10 @@ typename DoubleLinkedList<T>::iterator
     return iterator(n);
 }
 
-template<typename T>
+template<typename T, typename _Alloc>
 template<typename IteratorType>
-typename DoubleLinkedList<T>::iterator
-    DoubleLinkedList<T>::insert(const_iterator pos, IteratorType b, IteratorType e)
+typename DoubleLinkedList<T, _Alloc>::iterator
+    DoubleLinkedList<T, _Alloc>::insert(const_iterator pos, IteratorType b, IteratorType e)
 {
     iterator result = pos._F_const_cast();
     while(b != e)
@@ -485,8 +505,8 @@ typename DoubleLinkedList<T>::iterator
     return result;
 }
 
-template<typename T>
-void DoubleLinkedList<T>::_F_erase(const_iterator it)
+template<typename T, typename _Alloc>
+void DoubleLinkedList<T, _Alloc>::_F_erase(const_iterator it)
 {
     if(it == end())
         return;
@@ -499,13 +519,13 @@ void DoubleLinkedList<T>::_F_erase(const_iterator it)
         _M_head = _M_head->Next;
     }
     it._F_const_cast()._M_current->dealloc();
-    delete it._M_current;
+    _F_release_node(it._F_const_cast()._M_current);
     _F_add_size(-1);
 }
 
-template<typename T>
-typename DoubleLinkedList<T>::iterator
-    DoubleLinkedList<T>::_F_find(ConstReference arg)
+template<typename T, typename _Alloc>
+typename DoubleLinkedList<T, _Alloc>::iterator
+    DoubleLinkedList<T, _Alloc>::_F_find(ConstReference arg)
 {
     Node *temp = _M_head;
     while(temp != nullptr)
@@ -517,22 +537,22 @@ typename DoubleLinkedList<T>::iterator
     return end();
 }
 
-template<typename T>
-void DoubleLinkedList<T>::clear()
+template<typename T, typename _Alloc>
+void DoubleLinkedList<T, _Alloc>::clear()
 {
     Node *n = _M_head;
     while(n != nullptr)
     {
         Node *m = n->Next;
-        delete n;
+        _F_release_node(n);
         n = m;
     }
     _M_head = _M_tail = nullptr;
     _M_size = 0;
 }
 
-template<typename T>
-void DoubleLinkedList<T>::reverse()
+template<typename T, typename _Alloc>
+void DoubleLinkedList<T, _Alloc>::reverse()
 {
     Node *n1 = _M_head;
     Node *n2 = _M_tail;
@@ -546,9 +566,9 @@ void DoubleLinkedList<T>::reverse()
     }
 }
 
-template<typename T>
+template<typename T, typename _Alloc>
 template<typename _Compare>
-void DoubleLinkedList<T>::sort(_Compare c)
+void DoubleLinkedList<T, _Alloc>::sort(_Compare c)
 {
     Node *max_pos = nullptr;
     Node *min_pos = _M_head;
@@ -587,11 +607,11 @@ void DoubleLinkedList<T>::sort(_Compare c)
     }
 }
 
-template<typename T>
-using Dlist = DoubleLinkedList<T>;
+template<typename T, typename _Alloc = NodeAllocator<T, DoubleLinkedListStatsTag>>
+using Dlist = DoubleLinkedList<T, _Alloc>;
 
-template<typename T>
-using List = DoubleLinkedList<T>;
+template<typename T, typename _Alloc = NodeAllocator<T, DoubleLinkedListStatsTag>>
+using List = DoubleLinkedList<T, _Alloc>;
 
 
 
@@ -0,0 +1,163 @@
+#include "Epoch.h"
+#include "Malloc.h"
+#include "Memory.h"
+#include <new> // placement new std::bad_alloc
+#include <thread> // std::this_thread::yield
+
+// objects retired between two collections
+static constexpr rapid::size_type __collect_interval = 64;
+
+static rapid::Atomic<rapid::size_type> __global_epoch;
+static rapid::Atomic<rapid::EpochParticipant *> __participant_head;
+static thread_local rapid::EpochParticipant *__thread_participant = nullptr;
+
+struct EpochParticipantGuard
+{
+    ~EpochParticipantGuard()
+    {
+        rapid::EpochParticipant *p = __thread_participant;
+        if(p == nullptr) return;
+        // what can not be reclaimed yet stays with the participant for the next owner
+        rapid::epoch_collect();
+        __thread_participant = nullptr;
+        p->PinDepth = 0;
+        p->State.store(0, rapid::MemoryOrder::Release);
+        p->Active.store(false, rapid::MemoryOrder::Release);
+    }
+};
+
+// reuse an inactive participant or create a new one
+static rapid::EpochParticipant* __acquire_participant()
+{
+    for(rapid::EpochParticipant *p = __participant_head.load(rapid::MemoryOrder::Acquire); p != nullptr; p = p->Next)
+    {
+        bool active = false;
+        if(!p->Active.load(rapid::MemoryOrder::Relaxed) &&
+           p->Active.compare_exchange_strong(active, true, rapid::MemoryOrder::Acquire))
+        { return p; }
+    }
+    // participants are never freed, aligned by hand so it does not depend on aligned new of C++17
+    unsigned long raw = reinterpret_cast<unsigned long>(::operator new(sizeof(rapid::EpochParticipant) + rapid::CacheLineSize));
+    raw = (raw + rapid::CacheLineSize - 1) & ~static_cast<unsigned long>(rapid::CacheLineSize - 1);
+    rapid::EpochParticipant *p = ::new(reinterpret_cast<void *>(raw)) rapid::EpochParticipant();
+    p->Active.store(true, rapid::MemoryOrder::Relaxed);
+    p->Next = __participant_head.load(rapid::MemoryOrder::Relaxed);
+    while(!__participant_head.compare_exchange_weak(p->Next, p, rapid::MemoryOrder::Release,
+                                                    rapid::MemoryOrder::Relaxed))
+    { }
+    return p;
+}
+
+/* advance the global epoch if every pinned participant has seen it
+ * return: the global epoch after
+ */
+static rapid::size_type __try_advance()
+{
+    // acquire what the threads did before they unpinned or advanced, so it happens before the reclaim
+    rapid::size_type epoch = __global_epoch.load(rapid::MemoryOrder::Acquire);
+    rapid::atomic_thread_fence(rapid::MemoryOrder::SeqCst);
+    for(rapid::EpochParticipant *p = rapid::epoch_participant_list(); p != nullptr; p = p->Next)
+    {
+        rapid::size_type state = p->State.load(rapid::MemoryOrder::Acquire);
+        if((state & 1) != 0 && (state >> 1) != epoch)
+        { return epoch; }
+    }
+    if(__global_epoch.compare_exchange_strong(epoch, epoch + 1, rapid::MemoryOrder::AcqRel, rapid::MemoryOrder::Acquire))
+    { return epoch + 1; }
+    return epoch;
+}
+
+rapid::EpochParticipant& rapid::epoch_participant()
+{
+    EpochParticipant *p = __thread_participant;
+    if(p != nullptr)
+    { return *p; }
+    static thread_local EpochParticipantGuard guard;
+    un_use(guard);
+    return *(__thread_participant = __acquire_participant());
+}
+
+rapid::EpochParticipant* rapid::epoch_participant_list()
+{ return __participant_head.load(MemoryOrder::Acquire); }
+
+rapid::size_type rapid::epoch_current()
+{ return __global_epoch.load(MemoryOrder::Relaxed); }
+
+void rapid::epoch_pin()
+{
+    EpochParticipant &p = epoch_participant();
+    if(p.PinDepth++ != 0) return;
+    size_type epoch = __global_epoch.load(MemoryOrder::Relaxed);
+    // a full barrier, the reads after it can not be moved before the pin is visible
+    p.State.exchange((epoch << 1) | 1, MemoryOrder::SeqCst);
+}
+
+void rapid::epoch_unpin()
+{
+    EpochParticipant &p = epoch_participant();
+    if(--p.PinDepth != 0) return;
+    p.State.store(0, MemoryOrder::Release);
+}
+
+bool rapid::epoch_pinned()
+{ return epoch_participant().PinDepth != 0; }
+
+void rapid::epoch_retire(void *object, EpochReclaimer reclaim, void *context)
+{
+    EpochParticipant &p = epoch_participant();
+    if(p.RetiredSize == p.RetiredCapacity)
+    {
+        size_type capacity = p.RetiredCapacity == 0 ? __collect_interval : p.RetiredCapacity * 2;
+        void *retired = rapid::realloc(p.Retired, capacity * sizeof(EpochRetired));
+        if(retired == nullptr)
+        { throw std::bad_alloc(); }
+        p.Retired = static_cast<EpochRetired *>(retired);
+        p.RetiredCapacity = capacity;
+    }
+    // the object was unlinked before, a thread pinning the epoch read here or later can not see it
+    atomic_thread_fence(MemoryOrder::SeqCst);
+    p.Retired[p.RetiredSize++] = EpochRetired{object, reclaim, context, __global_epoch.load(MemoryOrder::Relaxed)};
+    if(++p.RetireCount >= __collect_interval)
+    { epoch_collect(); }
+}
+
+rapid::size_type rapid::epoch_collect()
+{
+    EpochParticipant &p = epoch_participant();
+    // a reclaimer retiring more objects does not collect again
+    if(p.Collecting) return 0;
+    p.Collecting = true;
+    p.RetireCount = 0;
+    size_type epoch = __try_advance();
+    size_type n = 0;
+    while(n < p.RetiredSize && p.Retired[n].Epoch + 2 <= epoch)
+    { ++n; }
+    // objects retired by the reclaimers are appended after [n]
+    for(size_type i = 0; i < n; ++i)
+    {
+        EpochRetired r = p.Retired[i];
+        r.Reclaim(r.Object, r.Context);
+    }
+    if(n != 0)
+    {
+        p.RetiredSize -= n;
+        mem_move(p.Retired, p.Retired + n, p.RetiredSize * sizeof(EpochRetired));
+    }
+    p.Collecting = false;
+    return n;
+}
+
+void rapid::epoch_synchronize()
+{
+    while(epoch_pending() != 0)
+    {
+        if(epoch_collect() == 0)
+        { std::this_thread::yield(); }
+    }
+}
+
+rapid::size_type rapid::epoch_pending()
+{ return epoch_participant().RetiredSize; }
+
+rapid::size_type rapid::epoch_collect_interval()
+{ return __collect_interval; }
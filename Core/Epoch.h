@@ -0,0 +1,182 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include "Core/Version.h"
+#include "Core/Atomic.h"
+
+namespace rapid
+{
+
+/* epoch based reclamation
+ * a thread pins the epoch while it reads shared objects, an object removed from a shared
+ * structure is retired instead of freed, and reclaimed once the global epoch has advanced
+ * twice since then, which proves every thread that could still see it has unpinned
+ * the epoch only advances when every pinned thread has seen the current one, so a
+ * thread pinned for long delays the reclamation of all threads
+ * cheaper than hazard pointers for readers, one exchange per pin instead of one per node
+ */
+
+// free [object], [context] is the pointer given to epoch_retire
+using EpochReclaimer = void (*)(void *object, void *context);
+
+struct EpochRetired
+{
+    void *Object;
+    EpochReclaimer Reclaim;
+    void *Context;
+    size_type Epoch;// the global epoch when it was retired
+};
+
+// registration of a thread, only the State is read by other threads
+struct alignas(CacheLineSize) EpochParticipant
+{
+    // the epoch pinned shifted left by 1 with the lowest bit set, 0 if not pinned
+    Atomic<size_type> State;
+    Atomic<bool> Active;
+    size_type PinDepth;
+    bool Collecting;
+    // retired objects in the order of their epoch, kept when the thread exits and taken over by the next one
+    EpochRetired *Retired;
+    size_type RetiredSize;
+    size_type RetiredCapacity;
+    size_type RetireCount;
+    EpochParticipant *Next;// participants are chained once they are created and never freed
+};
+
+/* the participant of this thread, registered at the first call and unregistered when the
+ * thread exits, then it is reused by a new thread
+ */
+EpochParticipant& epoch_participant();
+
+// the first participant, go on with EpochParticipant::Next
+EpochParticipant* epoch_participant_list();
+
+// the global epoch
+size_type epoch_current();
+
+// pin the epoch for this thread, nested pins are counted
+void epoch_pin();
+
+void epoch_unpin();
+
+// whether this thread has pinned the epoch
+bool epoch_pinned();
+
+/* retire [object] after it is no longer reachable from shared memory, [reclaim] is called
+ * with it and [context] by this thread (or the next owner of its participant) when no thread
+ * can see it, the call may happen inside a later epoch_retire or epoch_collect
+ * it does not have to be pinned
+ */
+void epoch_retire(void *object, EpochReclaimer reclaim, void *context = nullptr);
+
+// retire an object from new
+template<typename T>
+void epoch_retire(T *object)
+{ epoch_retire(const_cast<void *>(static_cast<const void *>(object)), [](void *p, void *) { delete static_cast<T *>(p); }); }
+
+/* try to advance the epoch and reclaim what this thread retired and is safe now,
+ * epoch_retire does it once every epoch_collect_interval() objects
+ * return: number of objects reclaimed
+ */
+size_type epoch_collect();
+
+/* reclaim everything this thread retired, waiting for the pinned threads to move on
+ * it must not be called while pinned
+ */
+void epoch_synchronize();
+
+// number of objects retired by this thread and not reclaimed
+size_type epoch_pending();
+
+// number of epoch_retire between two epoch_collect
+size_type epoch_collect_interval();
+
+// pin the epoch in a scope
+class EpochGuard
+{
+public:
+    EpochGuard()
+    { epoch_pin(); }
+    ~EpochGuard()
+    { epoch_unpin(); }
+    EpochGuard(const EpochGuard &) = delete;
+    EpochGuard& operator=(const EpochGuard &) = delete;
+};
+
+/* a value read by any number of threads without locks and replaced as a whole by writers
+ * a writer copies the current version, changes the copy and publishes it, the old version
+ * is retired, so readers always see a complete version
+ * made for read-mostly lookup tables like a Map or a Set, every update copies the table
+ */
+template<typename T>
+class EpochSnapshot
+{
+public:
+    using ValueType = T;
+    using ConstPointer = const ValueType *;
+private:
+    Atomic<ValueType *> _M_current;
+
+    static void _SF_reclaim(void *p, void *)
+    { delete static_cast<ValueType *>(p); }
+    void _F_publish(ValueType *value)
+    { epoch_retire(_M_current.exchange(value, MemoryOrder::AcqRel), &_SF_reclaim); }
+public:
+    template<typename ... Args>
+    explicit EpochSnapshot(Args && ... args)
+        : _M_current(new ValueType(rapid::forward<Args>(args)...)) { }
+    EpochSnapshot(const EpochSnapshot &) = delete;
+    EpochSnapshot& operator=(const EpochSnapshot &) = delete;
+    // no thread may read it any more
+    ~EpochSnapshot()
+    { delete _M_current.load(MemoryOrder::Acquire); }
+
+    // the current version, it stays valid until this thread unpins the epoch
+    ConstPointer load() const
+    { return _M_current.load(MemoryOrder::Acquire); }
+
+    /* call [f] with the current version under a pin
+     * return: what [f] returns
+     */
+    template<typename _Func>
+    auto read(_Func f) const -> decltype(f(*load()))
+    {
+        EpochGuard guard;
+        return f(*load());
+    }
+
+    // replace the current version
+    void store(const ValueType &value)
+    { _F_publish(new ValueType(value)); }
+    void store(ValueType &&value)
+    { _F_publish(new ValueType(rapid::move(value))); }
+
+    /* publish a copy of the current version changed by [f], [f] is called again
+     * with a new copy if another writer published in between
+     */
+    template<typename _Func>
+    void update(_Func f)
+    {
+        EpochGuard guard;
+        ValueType *current = _M_current.load(MemoryOrder::Acquire);
+        while(true)
+        {
+            ValueType *copy = new ValueType(*current);
+            try
+            { f(*copy); }
+            catch(...)
+            {
+                delete copy;
+                throw;
+            }
+            if(_M_current.compare_exchange_strong(current, copy, MemoryOrder::AcqRel, MemoryOrder::Acquire))
+            { break; }
+            delete copy;
+        }
+        epoch_retire(current, &_SF_reclaim);
+    }
+};
+
+};
+
+#endif // EPOCH_H
@@ -28,6 +28,7 @@ RegistException(IndexOutOfArrayException);
 RegistException(SizeDoesNotMatchException);
 RegistException(CannotParseFileException);
 RegistException(CannotWriteFileException);
+RegistException(OutOfMemoryException);
 
 };
 
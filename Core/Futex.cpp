@@ -0,0 +1,59 @@
+#include "Futex.h"
+#include <climits> // INT_MAX
+#include <thread> // std::this_thread::yield
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// the kernel sleeps on the address of the word itself
+static_assert(sizeof(rapid::Atomic<unsigned int>) == sizeof(unsigned int), "Atomic<unsigned int> must be a plain word");
+
+bool rapid::Backoff::spin()
+{
+    if(_M_step <= SpinLimit)
+    {
+        for(unsigned int i = 0; i < (1u << _M_step); ++i)
+        { cpu_relax(); }
+    }
+    else if(_M_step <= YieldLimit)
+    { std::this_thread::yield(); }
+    else
+    { return false; }
+    ++_M_step;
+    return true;
+}
+
+#if defined(__linux__)
+
+void rapid::futex_wait(const Atomic<unsigned int> &word, unsigned int expected)
+{ syscall(SYS_futex, reinterpret_cast<const unsigned int *>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0); }
+
+void rapid::futex_wake(const Atomic<unsigned int> &word, int count)
+{ syscall(SYS_futex, reinterpret_cast<const unsigned int *>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0); }
+
+#else
+
+void rapid::futex_wait(const Atomic<unsigned int> &word, unsigned int expected)
+{
+    if(word.load(MemoryOrder::Relaxed) == expected)
+    { std::this_thread::yield(); }
+}
+
+void rapid::futex_wake(const Atomic<unsigned int> &, int)
+{ }
+
+#endif
+
+void rapid::futex_sleep(Atomic<unsigned int> &word, unsigned int state, unsigned int sleeper)
+{
+    if((state & sleeper) == 0 &&
+       !word.compare_exchange_strong(state, state | sleeper, MemoryOrder::Relaxed, MemoryOrder::Relaxed))
+    { return; }
+    futex_wait(word, state | sleeper);
+}
+
+void rapid::futex_wake_all(const Atomic<unsigned int> &word)
+{ futex_wake(word, INT_MAX); }
@@ -0,0 +1,61 @@
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include "Core/Version.h"
+#include "Core/Atomic.h"
+
+namespace rapid
+{
+
+// tell the cpu this is a spin-wait loop, it saves power and leaves the core to the sibling thread
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/* exponential backoff of a spin-wait loop
+ * spin() pauses 1, 2, 4 ... 64 times, then yields the cpu a few times, then returns false
+ * to tell the caller its spin budget is used up and it should sleep
+ */
+class Backoff
+{
+private:
+    unsigned int _M_step = 0;
+public:
+    static constexpr unsigned int SpinLimit = 6;
+    static constexpr unsigned int YieldLimit = 10;
+
+    bool spin();
+
+    void reset()
+    { _M_step = 0; }
+    // whether it has started yielding, the holder is probably preempted
+    bool yielding() const
+    { return _M_step > SpinLimit; }
+};
+
+/* sleep while [word] equals [expected], the check and the sleep are atomic
+ * it may return early without a wake, the caller checks [word] again
+ * without futex support it only yields the cpu
+ */
+void futex_wait(const Atomic<unsigned int> &word, unsigned int expected);
+
+/* sleep on [word] while it equals [state], [sleeper] is set in [word] first so the thread
+ * changing [word] sees a sleeper and wakes it
+ * it returns at once if [word] changed before the bit was set
+ */
+void futex_sleep(Atomic<unsigned int> &word, unsigned int state, unsigned int sleeper);
+
+// wake at most [count] threads sleeping on [word]
+void futex_wake(const Atomic<unsigned int> &word, int count);
+
+// wake every thread sleeping on [word]
+void futex_wake_all(const Atomic<unsigned int> &word);
+
+};
+
+#endif // FUTEX_H
@@ -0,0 +1,32 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include "Core/Memory.h"
+#include <string>
+
+namespace rapid
+{
+
+/* hash functor built on mem_hash, bitwise comparable types hash their bytes,
+ * specialize it for other types
+ */
+template<typename T>
+struct Hash
+{
+    static_assert(IsBitwiseComparable<T>::value, "specialize rapid::Hash for the type");
+
+    size_type operator()(const T &arg) const
+    { return mem_hash(&arg, sizeof(T)); }
+};
+
+template<>
+struct Hash<std::string>
+{
+    size_type operator()(const std::string &arg) const
+    { return mem_hash(arg.data(), arg.size()); }
+};
+
+}
+#endif // HASH_H
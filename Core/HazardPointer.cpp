@@ -0,0 +1,72 @@
+#include "HazardPointer.h"
+#include <new> // placement new
+
+static rapid::Atomic<rapid::HazardRecord *> __record_head;
+static rapid::Atomic<rapid::size_type> __record_count;
+static thread_local rapid::HazardRecord *__thread_record = nullptr;
+
+struct HazardRecordGuard
+{
+    ~HazardRecordGuard()
+    {
+        rapid::HazardRecord *record = __thread_record;
+        __thread_record = nullptr;
+        if(record == nullptr) return;
+        for(int i = 0; i < rapid::HazardRecord::SlotCount; ++i)
+        { record->Slots[i].store(nullptr, rapid::MemoryOrder::Release); }
+        record->Active.store(false, rapid::MemoryOrder::Release);
+    }
+};
+
+// reuse an inactive record or create a new one
+static rapid::HazardRecord* __acquire_record()
+{
+    for(rapid::HazardRecord *r = __record_head.load(rapid::MemoryOrder::Acquire); r != nullptr; r = r->Next)
+    {
+        bool active = false;
+        if(!r->Active.load(rapid::MemoryOrder::Relaxed) &&
+           r->Active.compare_exchange_strong(active, true, rapid::MemoryOrder::Acquire))
+        { return r; }
+    }
+    // records are never freed, aligned by hand so it does not depend on aligned new of C++17
+    unsigned long raw = reinterpret_cast<unsigned long>(::operator new(sizeof(rapid::HazardRecord) + rapid::CacheLineSize));
+    raw = (raw + rapid::CacheLineSize - 1) & ~static_cast<unsigned long>(rapid::CacheLineSize - 1);
+    rapid::HazardRecord *record = ::new(reinterpret_cast<void *>(raw)) rapid::HazardRecord();
+    record->Active.store(true, rapid::MemoryOrder::Relaxed);
+    record->Next = __record_head.load(rapid::MemoryOrder::Relaxed);
+    while(!__record_head.compare_exchange_weak(record->Next, record, rapid::MemoryOrder::Release,
+                                               rapid::MemoryOrder::Relaxed))
+    { }
+    __record_count.fetch_add(1, rapid::MemoryOrder::Relaxed);
+    return record;
+}
+
+rapid::HazardRecord& rapid::hazard_record()
+{
+    HazardRecord *record = __thread_record;
+    if(record != nullptr)
+    { return *record; }
+    // a thread exiting after its guard is destroyed keeps the record it gets here
+    static thread_local HazardRecordGuard guard;
+    un_use(guard);
+    return *(__thread_record = __acquire_record());
+}
+
+rapid::HazardRecord* rapid::hazard_record_list()
+{ return __record_head.load(MemoryOrder::Acquire); }
+
+rapid::size_type rapid::hazard_record_count()
+{ return __record_count.load(MemoryOrder::Relaxed); }
+
+bool rapid::hazard_protected(const void *p)
+{
+    for(HazardRecord *r = hazard_record_list(); r != nullptr; r = r->Next)
+    {
+        for(int i = 0; i < HazardRecord::SlotCount; ++i)
+        {
+            if(r->Slots[i].load() == p)
+            { return true; }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,65 @@
+#ifndef HAZARDPOINTER_H
+#define HAZARDPOINTER_H
+
+#include "Core/Version.h"
+#include "Core/Atomic.h"
+
+namespace rapid
+{
+
+/* hazard pointers
+ * before a thread reads a shared node it publishes the node's address in one of its slots,
+ * a node removed from a lock-free container is only given back to the allocator when no
+ * slot of any thread holds it, so readers never touch freed memory and a node can not be
+ * reused under a reader (no ABA)
+ */
+struct alignas(CacheLineSize) HazardRecord
+{
+    static constexpr int SlotCount = 2;
+
+    Atomic<const void *> Slots[SlotCount];
+    Atomic<bool> Active;
+    HazardRecord *Next;// records are chained once they are created and never freed
+};
+
+/* the record of this thread, acquired at the first call and given back when the thread exits,
+ * then it is reused by a new thread
+ */
+HazardRecord& hazard_record();
+
+// the first record, go on with HazardRecord::Next
+HazardRecord* hazard_record_list();
+
+// number of records created, an upper bound of the pointers protected at the same time is SlotCount times it
+size_type hazard_record_count();
+
+/* load [src] and protect the pointer in slot [slot] of this thread, the pointer stays valid
+ * until the slot is cleared or used again
+ * param[slot]: 0 to HazardRecord::SlotCount - 1
+ */
+template<typename T>
+T* hazard_protect(int slot, const Atomic<T *> &src)
+{
+    Atomic<const void *> &hazard = hazard_record().Slots[slot];
+    T *p = src.load(MemoryOrder::Relaxed);
+    while(true)
+    {
+        hazard.store(p);
+        // [src] did not change after the slot became visible, so the pointer was not retired before
+        T *current = src.load();
+        if(current == p)
+        { return p; }
+        p = current;
+    }
+}
+
+// stop protecting the pointer in slot [slot] of this thread
+inline void hazard_clear(int slot)
+{ hazard_record().Slots[slot].store(nullptr, MemoryOrder::Release); }
+
+// whether a slot of any thread holds [p]
+bool hazard_protected(const void *p);
+
+};
+
+#endif // HAZARDPOINTER_H
@@ -0,0 +1,247 @@
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+
+#include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include "Core/TLNode.h"
+#include "Core/Atomic.h"
+#include "Core/Allocator.h"
+
+namespace rapid
+{
+
+/* bounded lock-free queue for multiple producers and multiple consumers
+ * every slot has a sequence number telling whether it is ready to be written at position p
+ * (sequence == p) or to be read at position p (sequence == p + 1), so producers and consumers
+ * only contend on the tail and the head, which are kept in different cache lines
+ * the constructors of [T] used by push should not throw
+ * param[_Alloc]: allocator of the slots
+ */
+template<typename T, typename _Alloc = ContainerAllocator<T, MPMCQueueStatsTag>>
+class MPMCQueue
+{
+public:
+    using ValueType = T;
+    using Reference = ValueType&;
+    using ConstReference = const ValueType &;
+    using RvalueReference = ValueType&&;
+    using SizeType = size_type;
+    using AllocatorType = _Alloc;
+
+    using value_type = ValueType;// std
+    using allocator_type = AllocatorType;// std
+private:
+    struct Slot
+    {
+        Atomic<SizeType> Sequence;
+        NodeBase<ValueType> Data;
+    };
+    using SlotAllocator = RebindAllocator<AllocatorType, Slot>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+    using Difference = long long;
+
+    // read-only after construction
+    AllocatorType _M_alloc;
+    Slot *_M_slots;
+    SizeType _M_mask;
+    // next position to push
+    alignas(CacheLineSize) Atomic<SizeType> _M_tail;
+    // next position to pop
+    alignas(CacheLineSize) Atomic<SizeType> _M_head;
+    char _M_padding[CacheLineSize - sizeof(Atomic<SizeType>)];
+
+    static SizeType _SF_round_capacity(SizeType capacity)
+    {
+        SizeType result = 2;
+        while(result < capacity)
+        { result <<= 1; }
+        return result;
+    }
+
+    /* claim the position to push
+     * return: whether the queue is not full, [pos] is the position claimed
+     */
+    bool _F_claim_push(SizeType &pos)
+    {
+        pos = _M_tail.load(MemoryOrder::Relaxed);
+        while(true)
+        {
+            Difference diff = static_cast<Difference>(_M_slots[pos & _M_mask].Sequence.load(MemoryOrder::Acquire) - pos);
+            if(diff == 0)
+            {
+                if(_M_tail.compare_exchange_weak(pos, pos + 1, MemoryOrder::Relaxed))
+                { return true; }
+            }
+            else if(diff < 0)
+            { return false; }
+            else
+            { pos = _M_tail.load(MemoryOrder::Relaxed); }
+        }
+    }
+    bool _F_claim_pop(SizeType &pos)
+    {
+        pos = _M_head.load(MemoryOrder::Relaxed);
+        while(true)
+        {
+            Difference diff = static_cast<Difference>(_M_slots[pos & _M_mask].Sequence.load(MemoryOrder::Acquire) - (pos + 1));
+            if(diff == 0)
+            {
+                if(_M_head.compare_exchange_weak(pos, pos + 1, MemoryOrder::Relaxed))
+                { return true; }
+            }
+            else if(diff < 0)
+            { return false; }
+            else
+            { pos = _M_head.load(MemoryOrder::Relaxed); }
+        }
+    }
+    /* claim up to [n] positions in a row from [cursor], the slot at position p is ready
+     * when its sequence is p + [offset]
+     * return: the number claimed, [pos] is the first position claimed
+     */
+    SizeType _F_claim_range(Atomic<SizeType> &cursor, SizeType offset, SizeType n, SizeType &pos)
+    {
+        pos = cursor.load(MemoryOrder::Relaxed);
+        while(true)
+        {
+            SizeType count = 0;
+            for(; count < n; count++)
+            {
+                SizeType p = pos + count;
+                if(_M_slots[p & _M_mask].Sequence.load(MemoryOrder::Acquire) != p + offset)
+                { break; }
+            }
+            if(count == 0)
+            {
+                SizeType now = cursor.load(MemoryOrder::Relaxed);
+                // the slot is taken by someone else only if the cursor moved
+                if(now == pos)
+                { return 0; }
+                pos = now;
+                continue;
+            }
+            if(cursor.compare_exchange_weak(pos, pos + count, MemoryOrder::Relaxed))
+            { return count; }
+        }
+    }
+    template<typename ... Args>
+    void _F_publish(SizeType pos, const Args & ... args)
+    {
+        Slot &slot = _M_slots[pos & _M_mask];
+        slot.Data.construct(args...);
+        slot.Sequence.store(pos + 1, MemoryOrder::Release);
+    }
+    void _F_publish_move(SizeType pos, RvalueReference arg)
+    {
+        Slot &slot = _M_slots[pos & _M_mask];
+        ::new(slot.Data.address()) ValueType(rapid::move(arg));
+        slot.Sequence.store(pos + 1, MemoryOrder::Release);
+    }
+    void _F_consume(SizeType pos, Reference out)
+    {
+        Slot &slot = _M_slots[pos & _M_mask];
+        out = rapid::move(slot.Data.ref_content());
+        slot.Data.destruct();
+        slot.Sequence.store(pos + _M_mask + 1, MemoryOrder::Release);
+    }
+public:
+    /* param[capacity]: rounded up to a power of 2, 2 at least
+     */
+    explicit MPMCQueue(SizeType capacity, const AllocatorType &alloc = AllocatorType())
+        : _M_alloc(alloc), _M_slots(nullptr), _M_mask(_SF_round_capacity(capacity) - 1)
+    {
+        SlotAllocator a(_M_alloc);
+        _M_slots = SlotTraits::allocate(a, _M_mask + 1);
+        for(SizeType i = 0; i <= _M_mask; i++)
+        {
+            ::new(static_cast<void *>(_M_slots + i)) Slot();
+            _M_slots[i].Sequence.store(i, MemoryOrder::Relaxed);
+        }
+    }
+    MPMCQueue(const MPMCQueue &) = delete;
+    MPMCQueue& operator=(const MPMCQueue &) = delete;
+    // no thread may use the queue any more
+    ~MPMCQueue()
+    {
+        SizeType head = _M_head.load(MemoryOrder::Relaxed), tail = _M_tail.load(MemoryOrder::Relaxed);
+        for(; head != tail; head++)
+        { _M_slots[head & _M_mask].Data.destruct(); }
+        rapid::destroy(_M_slots, _M_mask + 1);
+        SlotAllocator a(_M_alloc);
+        SlotTraits::deallocate(a, _M_slots, _M_mask + 1);
+    }
+
+    // return: false if the queue is full
+    bool try_push(ConstReference arg)
+    {
+        SizeType pos;
+        if(!_F_claim_push(pos)) return false;
+        _F_publish(pos, arg);
+        return true;
+    }
+    bool try_push(RvalueReference arg)
+    {
+        SizeType pos;
+        if(!_F_claim_push(pos)) return false;
+        _F_publish_move(pos, rapid::move(arg));
+        return true;
+    }
+    template<typename ... Args>
+    bool try_emplace(const Args & ... args)
+    {
+        SizeType pos;
+        if(!_F_claim_push(pos)) return false;
+        _F_publish(pos, args...);
+        return true;
+    }
+
+    /* param[out]: assigned by the element popped
+     * return: false if the queue is empty
+     */
+    bool try_pop(Reference out)
+    {
+        SizeType pos;
+        if(!_F_claim_pop(pos)) return false;
+        _F_consume(pos, out);
+        return true;
+    }
+
+    /* push up to [n] elements of [args] with a single claim
+     * return: the number pushed, the elements after it are not touched
+     */
+    SizeType push_n(const ValueType *args, SizeType n)
+    {
+        SizeType pos, count = _F_claim_range(_M_tail, 0, n, pos);
+        for(SizeType i = 0; i < count; i++)
+        { _F_publish(pos + i, args[i]); }
+        return count;
+    }
+    /* pop up to [n] elements into [out] with a single claim
+     * return: the number popped
+     */
+    SizeType pop_n(ValueType *out, SizeType n)
+    {
+        SizeType pos, count = _F_claim_range(_M_head, 1, n, pos);
+        for(SizeType i = 0; i < count; i++)
+        { _F_consume(pos + i, out[i]); }
+        return count;
+    }
+
+    SizeType capacity() const
+    { return _M_mask + 1; }
+    // exact only if no thread is pushing or popping
+    SizeType size() const
+    {
+        SizeType head = _M_head.load(MemoryOrder::Relaxed);
+        SizeType tail = _M_tail.load(MemoryOrder::Relaxed);
+        return tail > head ? tail - head : 0;
+    }
+    bool empty() const
+    { return size() == 0; }
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
+};
+
+};
+
+#endif // MPMCQUEUE_H
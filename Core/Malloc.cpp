@@ -0,0 +1,423 @@
+#include "Malloc.h"
+#include "Memory.h"
+#include "PageMemory.h"
+#include "SpinLock.h"
+#include <cstdlib> // posix_memalign std::free
+
+using uint32 = unsigned int;
+
+// memory checkers only see blocks from the system allocator
+#if defined(__SANITIZE_ADDRESS__) && !defined(RAPID_SYSTEM_MALLOC)
+#define RAPID_SYSTEM_MALLOC
+#endif
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) && !defined(RAPID_SYSTEM_MALLOC)
+#define RAPID_SYSTEM_MALLOC
+#endif
+#endif
+
+#if !defined(RAPID_SYSTEM_MALLOC)
+
+/* memory is cut from spans aligned to their size, the header of the span at
+ * the aligned address tells which size class the memory belongs to
+ */
+static constexpr rapid::size_type __span_size = 256 * 1024;
+static constexpr rapid::size_type __span_header_size = 64;
+static constexpr rapid::size_type __max_small_size = 32 * 1024;
+static constexpr uint32 __class_count = 40;
+/* larger sizes are mapped from the system directly in whole pages and grow by moving pages,
+ * only the address is aligned to the span size, so a 33K block does not hold a 256K one
+ */
+static constexpr uint32 __mapped_class = 0xFFFFFFFE;
+
+struct Span
+{
+    uint32 SizeClass;
+    rapid::size_type Size;// byte size usable, only for mapped spans
+    Span *Next;// only while a mapped span is cached
+};
+
+struct FreeObject
+{
+    FreeObject *Next;
+};
+
+struct FreeList
+{
+    FreeObject *Head;
+    uint32 Count;
+};
+
+/* classes are 16, 32, ... 128, then 4 classes in each power of 2 up to 32K
+ * param[size]: 0 < size <= __max_small_size
+ */
+static inline uint32 __size_to_class(rapid::size_type size)
+{
+    if(size <= 128)
+    { return static_cast<uint32>((size + 15) / 16 - 1); }
+    uint32 lg = 63 - static_cast<uint32>(__builtin_clzll(size - 1));
+    return 8 + (lg - 7) * 4 + static_cast<uint32>((size - 1) >> (lg - 2)) - 4;
+}
+
+static constexpr rapid::size_type __class_to_size(uint32 c)
+{
+    return c < 8 ? (c + 1) * 16 : (5 + (c - 8) % 4) << (7 + (c - 8) / 4 - 2);
+}
+
+// object count moved between thread cache and depot at a time
+static constexpr uint32 __batch_count(uint32 c)
+{
+    return 32 * 1024 / __class_to_size(c) < 2 ? 2 :
+           32 * 1024 / __class_to_size(c) > 64 ? 64 :
+           static_cast<uint32>(32 * 1024 / __class_to_size(c));
+}
+
+static inline Span* __span_of(void *p)
+{ return reinterpret_cast<Span *>(reinterpret_cast<unsigned long>(p) & ~(__span_size - 1)); }
+
+static Span* __create_span(rapid::size_type size, uint32 size_class)
+{
+    void *p = nullptr;
+    if(posix_memalign(&p, __span_size, static_cast<std::size_t>(size)) != 0)
+    { return nullptr; }
+    Span *span = static_cast<Span *>(p);
+    span->SizeClass = size_class;
+    span->Size = size - __span_header_size;
+    return span;
+}
+
+//-----------------------depot-----------------------//
+
+struct alignas(64) Depot
+{
+    rapid::SpinLock Lock;
+    FreeList List;
+};
+
+static Depot __depot[__class_count];
+
+// cut a new span into a freelist of class [c]
+static FreeObject* __depot_grow(uint32 c)
+{
+    Span *span = __create_span(__span_size, c);
+    if(span == nullptr) return nullptr;
+    rapid::size_type size = __class_to_size(c);
+    char *begin = reinterpret_cast<char *>(span) + __span_header_size;
+    rapid::size_type count = (__span_size - __span_header_size) / size;
+    FreeObject *head = nullptr;
+    for(rapid::size_type i = count; i > 0; --i)
+    {
+        FreeObject *o = reinterpret_cast<FreeObject *>(begin + (i - 1) * size);
+        o->Next = head;
+        head = o;
+    }
+    return head;
+}
+
+/* move at most [count] objects of class [c] into [list]
+ * return: number of objects moved
+ */
+static uint32 __depot_fetch(uint32 c, FreeList &list, uint32 count)
+{
+    Depot &d = __depot[c];
+    d.Lock.lock();
+    if(d.List.Head == nullptr)
+    {
+        FreeObject *head = __depot_grow(c);
+        if(head == nullptr)
+        {
+            d.Lock.unlock();
+            return 0;
+        }
+        d.List.Head = head;
+        d.List.Count = static_cast<uint32>((__span_size - __span_header_size) / __class_to_size(c));
+    }
+    uint32 moved = 0;
+    FreeObject *o = d.List.Head;
+    FreeObject *last = nullptr;
+    while(o != nullptr && moved < count)
+    {
+        last = o;
+        o = o->Next;
+        ++moved;
+    }
+    last->Next = list.Head;
+    list.Head = d.List.Head;
+    list.Count += moved;
+    d.List.Head = o;
+    d.List.Count -= moved;
+    d.Lock.unlock();
+    return moved;
+}
+
+// move at most [count] objects from [list] to the depot
+static void __depot_release(uint32 c, FreeList &list, uint32 count)
+{
+    if(list.Head == nullptr) return;
+    FreeObject *first = list.Head;
+    FreeObject *last = first;
+    uint32 moved = 1;
+    while(last->Next != nullptr && moved < count)
+    {
+        last = last->Next;
+        ++moved;
+    }
+    list.Head = last->Next;
+    list.Count -= moved;
+
+    Depot &d = __depot[c];
+    d.Lock.lock();
+    last->Next = d.List.Head;
+    d.List.Head = first;
+    d.List.Count += moved;
+    d.Lock.unlock();
+}
+
+//-----------------------thread cache-----------------------//
+
+struct ThreadCache
+{
+    FreeList Lists[__class_count];
+};
+
+// plain pointer, so it can still be read after the thread's destructors have run
+static thread_local ThreadCache *__thread_cache = nullptr;
+static thread_local bool __thread_cache_retired = false;
+
+static void __flush_cache(ThreadCache *cache)
+{
+    for(uint32 c = 0; c < __class_count; ++c)
+    {
+        FreeList &list = cache->Lists[c];
+        __depot_release(c, list, list.Count);
+    }
+}
+
+struct ThreadCacheGuard
+{
+    ~ThreadCacheGuard()
+    {
+        ThreadCache *cache = __thread_cache;
+        __thread_cache = nullptr;
+        __thread_cache_retired = true;
+        if(cache == nullptr) return;
+        __flush_cache(cache);
+        std::free(cache);
+    }
+};
+
+static ThreadCache* __local_cache()
+{
+    ThreadCache *cache = __thread_cache;
+    if(cache != nullptr || __thread_cache_retired)
+    { return cache; }
+    cache = static_cast<ThreadCache *>(std::calloc(1, sizeof(ThreadCache)));
+    if(cache == nullptr) return nullptr;
+    static thread_local ThreadCacheGuard guard;
+    un_use(guard);
+    return __thread_cache = cache;
+}
+
+static void* __allocate_small(rapid::size_type size)
+{
+    uint32 c = __size_to_class(size);
+    ThreadCache *cache = __local_cache();
+    if(cache == nullptr)
+    {
+        // the thread is exiting, go to the depot directly
+        FreeList list{nullptr, 0};
+        if(__depot_fetch(c, list, 1) == 0) return nullptr;
+        return list.Head;
+    }
+    FreeList &list = cache->Lists[c];
+    if(list.Head == nullptr && __depot_fetch(c, list, __batch_count(c)) == 0)
+    { return nullptr; }
+    FreeObject *o = list.Head;
+    list.Head = o->Next;
+    --list.Count;
+    return o;
+}
+
+static void __free_small(void *p, uint32 c)
+{
+    FreeObject *o = static_cast<FreeObject *>(p);
+    ThreadCache *cache = __local_cache();
+    if(cache == nullptr)
+    {
+        FreeList list{o, 1};
+        o->Next = nullptr;
+        __depot_release(c, list, 1);
+        return;
+    }
+    FreeList &list = cache->Lists[c];
+    o->Next = list.Head;
+    list.Head = o;
+    if(++list.Count > 2 * __batch_count(c))
+    { __depot_release(c, list, __batch_count(c)); }
+}
+
+//-----------------------mapped span-----------------------//
+
+/* freed mapped spans of up to __cached_span_pages pages are kept by page count,
+ * so a mid size used again and again is not mapped and faulted in each time
+ */
+static constexpr rapid::size_type __cached_span_pages = 256;
+static constexpr rapid::size_type __span_cache_limit = 16 * 1024 * 1024;
+
+struct alignas(64) SpanCache
+{
+    rapid::SpinLock Lock;
+    rapid::size_type Bytes;
+    Span *Lists[__cached_span_pages + 1];
+};
+
+static SpanCache __span_cache;
+
+static inline rapid::size_type __span_bytes(rapid::size_type size)
+{ return (size + __span_header_size + rapid::page_size() - 1) & ~(rapid::page_size() - 1); }
+
+static Span* __map_span(rapid::size_type size)
+{
+    rapid::size_type total = __span_bytes(size);
+    rapid::size_type pages = total / rapid::page_size();
+    if(pages <= __cached_span_pages)
+    {
+        __span_cache.Lock.lock();
+        Span *span = __span_cache.Lists[pages];
+        if(span != nullptr)
+        {
+            __span_cache.Lists[pages] = span->Next;
+            __span_cache.Bytes -= total;
+        }
+        __span_cache.Lock.unlock();
+        if(span != nullptr) return span;
+    }
+    Span *span = static_cast<Span *>(rapid::page_allocate(total, rapid::PageHint::Transparent, __span_size));
+    if(span == nullptr) return nullptr;
+    span->SizeClass = __mapped_class;
+    span->Size = total - __span_header_size;
+    return span;
+}
+
+static void __unmap_span(Span *span)
+{
+    rapid::size_type total = span->Size + __span_header_size;
+    rapid::size_type pages = total / rapid::page_size();
+    if(pages <= __cached_span_pages)
+    {
+        __span_cache.Lock.lock();
+        bool cached = __span_cache.Bytes + total <= __span_cache_limit;
+        if(cached)
+        {
+            span->Next = __span_cache.Lists[pages];
+            __span_cache.Lists[pages] = span;
+            __span_cache.Bytes += total;
+        }
+        __span_cache.Lock.unlock();
+        if(cached) return;
+    }
+    rapid::page_release(span, total);
+}
+
+// the pages are moved, the content is not copied
+static Span* __remap_span(Span *span, rapid::size_type size)
+{
+    rapid::size_type total = size + __span_header_size;
+    Span *result = static_cast<Span *>(rapid::page_reallocate(span, span->Size + __span_header_size, total,
+                                                              rapid::PageHint::Transparent, __span_size));
+    if(result == nullptr) return nullptr;
+    result->Size = __span_bytes(size) - __span_header_size;
+    return result;
+}
+
+//-----------------------interface-----------------------//
+
+void* rapid::malloc(size_type size)
+{
+    if(size == 0)
+    { size = 1; }
+    if(size <= __max_small_size)
+    { return __allocate_small(size); }
+    Span *span = __map_span(size);
+    if(span == nullptr) return nullptr;
+    return reinterpret_cast<char *>(span) + __span_header_size;
+}
+
+void rapid::free(void *p)
+{
+    if(p == nullptr) return;
+    Span *span = __span_of(p);
+    if(span->SizeClass == __mapped_class)
+    { __unmap_span(span); }
+    else
+    { __free_small(p, span->SizeClass); }
+}
+
+void* rapid::realloc(void *p, size_type size)
+{
+    if(p == nullptr)
+    { return rapid::malloc(size); }
+    if(size == 0)
+    { size = 1; }
+    size_type usable = malloc_usable_size(p);
+    Span *span = __span_of(p);
+    if(span->SizeClass == __mapped_class && size > __max_small_size)
+    {
+        // the pages are moved when growing and the tail is unmapped when shrinking
+        if(size <= usable && usable - size < page_size())
+        { return p; }
+        Span *result = __remap_span(span, size);
+        if(result == nullptr)
+        { return size <= usable ? p : nullptr; }
+        return reinterpret_cast<char *>(result) + __span_header_size;
+    }
+    // a smaller size is kept in place until it fits a smaller size class
+    if(size <= usable && span->SizeClass != __mapped_class && __size_to_class(size) == span->SizeClass)
+    { return p; }
+    void *result = rapid::malloc(size);
+    if(result == nullptr)
+    { return size <= usable ? p : nullptr; }
+    mem_copy(result, p, size < usable ? size : usable);
+    rapid::free(p);
+    return result;
+}
+
+rapid::size_type rapid::malloc_usable_size(void *p)
+{
+    if(p == nullptr) return 0;
+    Span *span = __span_of(p);
+    return span->SizeClass == __mapped_class ? span->Size : __class_to_size(span->SizeClass);
+}
+
+rapid::size_type rapid::malloc_max_small_size()
+{ return __max_small_size; }
+
+void rapid::malloc_flush_thread_cache()
+{
+    ThreadCache *cache = __thread_cache;
+    if(cache != nullptr)
+    { __flush_cache(cache); }
+}
+
+#else
+#include <malloc.h> // ::malloc_usable_size
+
+void* rapid::malloc(size_type size)
+{ return std::malloc(static_cast<std::size_t>(size == 0 ? 1 : size)); }
+
+void rapid::free(void *p)
+{ std::free(p); }
+
+void* rapid::realloc(void *p, size_type size)
+{ return std::realloc(p, static_cast<std::size_t>(size == 0 ? 1 : size)); }
+
+rapid::size_type rapid::malloc_usable_size(void *p)
+{ return ::malloc_usable_size(p); }
+
+rapid::size_type rapid::malloc_max_small_size()
+{ return 0; }
+
+void rapid::malloc_flush_thread_cache()
+{ }
+
+#endif
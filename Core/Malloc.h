@@ -0,0 +1,69 @@
+#ifndef MALLOC_H
+#define MALLOC_H
+
+#include "Core/Version.h"
+#include <new>
+
+namespace rapid
+{
+
+/* thread-caching allocator
+ * small sizes are rounded up to a size class and served from a per-thread freelist,
+ * which is refilled from and drained to a central depot in batches
+ * memory can be freed by any thread
+ * sizes larger than malloc_max_small_size() get whole pages of their own
+ * define RAPID_SYSTEM_MALLOC (implied by AddressSanitizer) to forward everything to std::malloc
+ */
+
+/* param[size]: byte size required
+ * return: memory aligned to 16 at least, nullptr if out of memory
+ */
+void* malloc(size_type size);
+
+// param[p]: memory from rapid::malloc or rapid::realloc, nullptr is ignored
+void free(void *p);
+
+/* resize [p], the content is kept up to the smaller size
+ * shrinking gives memory back once a smaller size class fits or whole pages are unused
+ * return: the new memory, nullptr if out of memory and [p] is untouched
+ */
+void* realloc(void *p, size_type size);
+
+// byte size usable in [p], never less than the size asked for
+size_type malloc_usable_size(void *p);
+
+// the largest size served by size classes
+size_type malloc_max_small_size();
+
+/* give all memory cached by this thread back to the depot,
+ * called automatically when the thread exits
+ */
+void malloc_flush_thread_cache();
+
+/* allocate [n] default constructed [T] from rapid::malloc
+ * throw std::bad_alloc if out of memory
+ */
+template<typename T>
+T* malloc_array(size_type n)
+{
+    T *p = static_cast<T *>(rapid::malloc(n * sizeof(T)));
+    if(p == nullptr && n != 0)
+    { throw std::bad_alloc(); }
+    for(size_type i = 0; i < n; ++i)
+    { ::new(p + i) T(); }
+    return p;
+}
+
+// destroy [n] elements of [p] and free it
+template<typename T>
+void free_array(T *p, size_type n)
+{
+    if(p == nullptr) return;
+    for(size_type i = 0; i < n; ++i)
+    { p[i].~T(); }
+    rapid::free(p);
+}
+
+};
+
+#endif // MALLOC_H
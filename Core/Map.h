@@ -15,24 +15,24 @@ struct Pair
     _Second Second;
     Pair() { }
     Pair(const _First &f) : First(f) { }
-    Pair(_First &&f) : First(forward<_First>(f)) { }
+    Pair(_First &&f) : First(rapid::forward<_First>(f)) { }
     Pair(const Pair &p)
         : First(p.First), Second(p.Second) { }
     Pair(Pair &&p)
-        : First(forward<Pair>(p).First), Second(forward<Pair>(p).Second) { }
+        : First(rapid::forward<Pair>(p).First), Second(rapid::forward<Pair>(p).Second) { }
 
     template<typename ... Args>
     Pair(const _First &f, const Args & ... args)
         : First(f), Second(args...) { }
     template<typename ... Args>
     Pair(const _First &f, Args && ... args)
-        : First(f), Second(forward<Args>(args)...) { }
+        : First(f), Second(rapid::forward<Args>(args)...) { }
     template<typename ... Args>
     Pair(_First &&f, const Args & ... args)
-        : First(forward<_First>(f)), Second(args...) { }
+        : First(rapid::forward<_First>(f)), Second(args...) { }
     template<typename ... Args>
     Pair(_First &&f, Args && ... args)
-        : First(forward<_First>(f)), Second(forward<Args>(args)...) { }
+        : First(rapid::forward<_First>(f)), Second(rapid::forward<Args>(args)...) { }
 
     bool operator<(const Pair &f) const
     { return First < f.First; }
@@ -74,6 +74,9 @@ public:
 
 private:
     using TreeType = _TreeType;
+public:
+    using AllocatorType = typename TreeType::AllocatorType;
+private:
 
     using IteratorImpl = typename TreeType::iterator;
     using ConstIteratorImpl = typename TreeType::const_iterator;
@@ -99,7 +102,7 @@ public:
         iterator(const iterator &it)
             : _M_it(it._M_it) { }
         iterator(iterator &&it)
-            : _M_it(forward<iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<iterator>(it)._M_it) { }
 
         iterator operator++()
         {
@@ -147,7 +150,7 @@ public:
         const_iterator(const const_iterator &it)
             : _M_it(it._M_it) { }
         const_iterator(const_iterator &&it)
-            : _M_it(forward<const_iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_iterator>(it)._M_it) { }
 
         const_iterator operator++()
         {
@@ -195,7 +198,7 @@ public:
         reverse_iterator(const reverse_iterator &it)
             : _M_it(it._M_it) { }
         reverse_iterator(reverse_iterator &&it)
-            : _M_it(forward<reverse_iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<reverse_iterator>(it)._M_it) { }
 
         reverse_iterator operator++()
         {
@@ -243,7 +246,7 @@ public:
         const_reverse_iterator(const const_reverse_iterator &it)
             : _M_it(it._M_it) { }
         const_reverse_iterator(const_reverse_iterator &&it)
-            : _M_it(forward<const_reverse_iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_reverse_iterator>(it)._M_it) { }
 
         const_reverse_iterator operator++()
         {
@@ -284,13 +287,16 @@ private:
 
 public:
     MapBase() { }
+    explicit MapBase(const AllocatorType &alloc) : _M_tree(alloc) { }
     MapBase(const MapBase &m) : _M_tree(m._M_tree) { }
-    MapBase(MapBase &&m) : _M_tree(forward<MapBase>(m)._M_tree) { }
+    MapBase(MapBase &&m) : _M_tree(rapid::forward<MapBase>(m)._M_tree) { }
 
     bool empty() const
     { return _M_tree.empty(); }
     SizeType size() const
     { return _M_tree.size(); }
+    AllocatorType get_allocator() const
+    { return _M_tree.get_allocator(); }
 
     iterator insert(const DataType &data)
     { return _M_tree.insert(data); }
@@ -300,21 +306,21 @@ public:
 //    iterator insert(const KeyType &key, const ValueType &value)
 //    { return insert(DataType(key, value)); }
 //    iterator insert(KeyType &&key, const ValueType &value)
-//    { return insert(DataType(forward<KeyType>(key), value)); }
+//    { return insert(DataType(rapid::forward<KeyType>(key), value)); }
 //    iterator insert(const KeyType &key, ValueType &&value)
-//    { return insert(DataType(key, forward<ValueType>(value))); }
+//    { return insert(DataType(key, rapid::forward<ValueType>(value))); }
 //    iterator insert(KeyType &&key, ValueType &&value)
-//    { return insert(DataType(forward<KeyType>(key), forward<ValueType>(value))); }
+//    { return insert(DataType(rapid::forward<KeyType>(key), rapid::forward<ValueType>(value))); }
 
     template<typename ... Args>
     iterator insert(KeyType &&key, Args && ... value)
-    { return insert(DataType(forward<KeyType>(key), forward<Args>(value)...)); }
+    { return insert(DataType(rapid::forward<KeyType>(key), rapid::forward<Args>(value)...)); }
     template<typename ... Args>
     iterator insert(KeyType &&key, const Args & ... value)
-    { return insert(DataType(forward<KeyType>(key), value...)); }
+    { return insert(DataType(rapid::forward<KeyType>(key), value...)); }
     template<typename ... Args>
     iterator insert(const KeyType &key, Args && ... value)
-    { return insert(DataType(key, forward<Args>(value)...)); }
+    { return insert(DataType(key, rapid::forward<Args>(value)...)); }
     template<typename ... Args>
     iterator insert(const KeyType &key, const Args & ... value)
     { return insert(DataType(key, value...)); }
@@ -324,13 +330,13 @@ public:
     { return insert(DataType(key, args...)); }
     template<typename ... Args>
     iterator emplace(const KeyType &key, Args && ... args)
-    { return insert(DataType(key, forward<Args>(args)...)); }
+    { return insert(DataType(key, rapid::forward<Args>(args)...)); }
     template<typename ... Args>
     iterator emplace(KeyType &&key, const Args & ... args)
-    { return insert(DataType(forward<KeyType>(key), args...)); }
+    { return insert(DataType(rapid::forward<KeyType>(key), args...)); }
     template<typename ... Args>
     iterator emplace(KeyType &&key, Args && ... args)
-    { return insert(DataType(forward<KeyType>(key), forward<Args>(args)...)); }
+    { return insert(DataType(rapid::forward<KeyType>(key), rapid::forward<Args>(args)...)); }
 
     void erase(iterator it)
     { _M_tree.erase(*it); }
@@ -338,7 +344,7 @@ public:
     iterator find(const KeyType &key) const
     { return iterator(_M_tree.template find<KeyType, CompareType>(key)); }
     iterator find(KeyType &&key) const
-    { return iterator(_M_tree.template find<KeyType, CompareType>(forward<KeyType>(key))); }
+    { return iterator(_M_tree.template find<KeyType, CompareType>(rapid::forward<KeyType>(key))); }
 
     ValueType& operator[](const KeyType &key)
     {
@@ -347,7 +353,7 @@ public:
     }
     ValueType& operator[](KeyType &&key)
     {
-        IteratorImpl it = _M_tree.template find_and_insert(forward<KeyType>(key));
+        IteratorImpl it = _M_tree.template find_and_insert(rapid::forward<KeyType>(key));
         return it->Second;
     }
 
@@ -381,13 +387,15 @@ public:
 
 template<typename _Key,
          typename _Value,
-         typename _Compare = Compare<Pair<_Key, _Value>>>
-using Map = MapBase<_Key, _Value, RedBlackTree<Pair<_Key, _Value>, _Compare>>;
+         typename _Compare = Compare<Pair<_Key, _Value>>,
+         typename _Alloc = NodeAllocator<Pair<_Key, _Value>, MapStatsTag>>
+using Map = MapBase<_Key, _Value, RedBlackTree<Pair<_Key, _Value>, _Compare, _Alloc>>;
 
 template<typename _Key,
          typename _Value,
-         typename _Compare = Compare<Pair<_Key, _Value>>>
-using AVLMap = MapBase<_Key, _Value, AVLTree<Pair<_Key, _Value>, _Compare>>;
+         typename _Compare = Compare<Pair<_Key, _Value>>,
+         typename _Alloc = NodeAllocator<Pair<_Key, _Value>, AVLMapStatsTag>>
+using AVLMap = MapBase<_Key, _Value, AVLTree<Pair<_Key, _Value>, _Compare, 2, _Alloc>>;
 
 };
 
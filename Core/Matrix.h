@@ -6,8 +6,11 @@
 #include "Core/Version.h"
 #include "Core/Exception.h"
 #include "Core/Memory.h"
+#include "Core/Malloc.h"
+#include "Core/AllocStats.h"
 #include <initializer_list>
 #include <iostream>
+#include <type_traits> // std::is_trivially_default_constructible
 
 namespace rapid
 {
@@ -53,7 +56,8 @@ protected:
 //    template<typename _FilterType>
 //    void _F_filter(const Matrix<_FilterType> m);
 
-    static void _SF_clear(DataType **mem, SizeType r);
+    static void _SF_clear(DataType **mem, SizeType r, SizeType c);
+    static DataType** _SF_allocate(SizeType r, SizeType c);
     static Matrix<_Tp> _SF_multiply(ConstMatrixRef m1, ConstMatrixRef m2);
 public:
     Matrix(SizeType r = 1, SizeType c = 1)
@@ -61,7 +65,7 @@ public:
     Matrix(SizeType r, SizeType c, ConstReference default_value)
     { _F_construct_default(r, c, default_value); }
     Matrix(SizeType r, SizeType c, RvalueReference default_value)
-    { _F_construct_default(r, c, forward<ValueType>(default_value)); }
+    { _F_construct_default(r, c, rapid::forward<ValueType>(default_value)); }
     Matrix(ConstMatrixRef m)
     { _F_copy(m); }
     Matrix(RvalueMatrixRef m)
@@ -78,7 +82,7 @@ public:
     void set_value(SizeType r, SizeType c, ConstReference v)
     { _F_set_value(r, c, v); }
     void set_value(SizeType r, SizeType c, RvalueReference v)
-    { _F_set_value(r, c, forward<ValueType>(v)); }
+    { _F_set_value(r, c, rapid::forward<ValueType>(v)); }
 
     ValueType get_value(SizeType r, SizeType c) const
     { return _F_data(r, c); }
@@ -97,21 +101,21 @@ public:
     void multiply(SizeType r, ConstReference n)
     { _F_multiply(r, n); }
     void multiply(SizeType r, RvalueReference n)
-    { _F_multiply(r, forward<ValueType>(n)); }
+    { _F_multiply(r, rapid::forward<ValueType>(n)); }
     void multiply(ConstMatrixRef m)
     { _F_multiply(m); }
     void multiply(RvalueMatrixRef m)
-    { _F_multiply(forward<Matrix<_Tp>>(m)); }
+    { _F_multiply(rapid::forward<Matrix<_Tp>>(m)); }
 
     void add(ConstMatrixRef m)
     { _F_add(m); }
     void add(RvalueMatrixRef m)
-    { _F_add(forward<Matrix<_Tp>>(m)); }
+    { _F_add(rapid::forward<Matrix<_Tp>>(m)); }
 
 //    void filter(ConstMatrixRef m)
 //    { _F_filter(m); }
 //    void filter(RvalueMatrixRef m)
-//    { _F_filter(forward<Matrix<_Tp>>(m)); }
+//    { _F_filter(rapid::forward<Matrix<_Tp>>(m)); }
 //    void filter(std::initializer_list<std::initializer_list<double>> m)
 //    { _F_filter(Matrix<double>(m)); }
 
@@ -120,18 +124,18 @@ public:
     // need call by manual
     void clear()
     {
-        _SF_clear(_M_data, row());
+        _SF_clear(_M_data, row(), column());
         _M_data = nullptr;
     }
 
     static Matrix<_Tp> multiply(ConstMatrixRef m1, ConstMatrixRef m2)
     { return _SF_multiply(m1, m2); }
     static Matrix<_Tp> multiply(ConstMatrixRef m1, RvalueMatrixRef m2)
-    { return _SF_multiply(m1, forward<Matrix<_Tp>>(m2)); }
+    { return _SF_multiply(m1, rapid::forward<Matrix<_Tp>>(m2)); }
     static Matrix<_Tp> multiply(RvalueMatrixRef m1, ConstMatrixRef m2)
-    { return _SF_multiply(forward<Matrix<_Tp>>(m1), m2); }
+    { return _SF_multiply(rapid::forward<Matrix<_Tp>>(m1), m2); }
     static Matrix<_Tp> multiply(RvalueMatrixRef m1, RvalueMatrixRef m2)
-    { return _SF_multiply(forward<Matrix<_Tp>>(m1), forward<Matrix<_Tp>>(m2)); }
+    { return _SF_multiply(rapid::forward<Matrix<_Tp>>(m1), rapid::forward<Matrix<_Tp>>(m2)); }
 
     // copy [m]'s data reference to [this]
     void copy_from(ConstMatrixRef m)
@@ -222,6 +226,12 @@ void Matrix<_Tp>::_F_copy(ConstMatrixRef m)
     _F_resize(m.row(), m.column());
     for(SizeType i = 0; i < row(); i++)
     {
+        // rows of trivially copyable elements are copied as bytes
+        if(IsTriviallyCopyable<ValueType>::value)
+        {
+            mem_copy(_M_data[i], m._M_data[i], static_cast<size_type>(column()) * sizeof(DataType));
+            continue;
+        }
         for(SizeType j = 0; j < column(); j++)
         {
             set_value(i, j, m.get_value(i, j));
@@ -232,42 +242,57 @@ void Matrix<_Tp>::_F_copy(ConstMatrixRef m)
 template<typename _Tp>
 void Matrix<_Tp>::_F_resize(SizeType r, SizeType c)
 {
-    _SF_clear(_M_data, row());
+    _SF_clear(_M_data, row(), column());
     _M_row = r;
     _M_column = c;
-    _M_data = new DataType*[static_cast<unsigned long long>(row())];
-    for(SizeType i = 0; i < row(); i++)
-    {
-        _M_data[i] = new DataType[static_cast<unsigned long long>(column())];
-    }
+    _M_data = _SF_allocate(row(), column());
 }
 
 template<typename _Tp>
 void Matrix<_Tp>::_F_construct_default(SizeType r, SizeType c, ConstReference value)
 {
-    _SF_clear(_M_data, row());
+    _SF_clear(_M_data, row(), column());
     _M_row = r;
     _M_column = c;
-    _M_data = new DataType*[row()];
+    _M_data = _SF_allocate(row(), column());
     for(SizeType i = 0; i < row(); i++)
     {
-        _M_data[i] = new DataType[column()];
         for(SizeType j = 0; j < column(); j++)
         {
-            _M_data[i][j].construct(value);
+            _F_set_value(i, j, value);
         }
     }
 }
 
 template<typename _Tp>
-void Matrix<_Tp>::_SF_clear(DataType **mem, SizeType r)
+typename Matrix<_Tp>::DataType** Matrix<_Tp>::_SF_allocate(SizeType r, SizeType c)
+{
+    DataType **mem = malloc_array<DataType *>(static_cast<size_type>(r));
+    stats_record_allocate<MatrixStatsTag>(static_cast<size_type>(r) * sizeof(DataType *));
+    for(SizeType i = 0; i < r; i++)
+    {
+        mem[i] = malloc_array<DataType>(static_cast<size_type>(c));
+        stats_record_allocate<MatrixStatsTag>(static_cast<size_type>(c) * sizeof(DataType));
+        // zero bytes are enough for trivially constructible elements
+        if(std::is_trivially_default_constructible<ValueType>::value) continue;
+        for(SizeType j = 0; j < c; j++)
+        { mem[i][j].construct(); }
+    }
+    return mem;
+}
+
+template<typename _Tp>
+void Matrix<_Tp>::_SF_clear(DataType **mem, SizeType r, SizeType c)
 {
     if(mem == nullptr) return;
     for(SizeType i = 0; i < r; i++)
     {
-        delete[] mem[i];
+        rapid::destroy(mem[i][0].address(), static_cast<size_type>(c));
+        rapid::free(mem[i]);
+        stats_record_deallocate<MatrixStatsTag>(static_cast<size_type>(c) * sizeof(DataType));
     }
-    delete[] mem;
+    rapid::free(mem);
+    stats_record_deallocate<MatrixStatsTag>(static_cast<size_type>(r) * sizeof(DataType *));
     mem = nullptr;
 }
 
@@ -381,6 +406,10 @@ void Matrix<_Tp>::power(SizeType p)
     swap(temp);
 }
 
+// the rows are owned through pointers, a Matrix can be moved by copying its bytes
+template<typename _Tp>
+struct IsTriviallyRelocatable<Matrix<_Tp>> : TrueType
+{ };
 
 };
 
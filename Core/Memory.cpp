@@ -1,6 +1,14 @@
-
 #include "Memory.h"
 
+#if !defined(RAPID_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define RAPID_SIMD_X86
+#include <immintrin.h>
+#endif
+#if defined(__unix__)
+#include <unistd.h> // sysconf
+#endif
+
 using uint64 = unsigned long long;
 using uint32 = unsigned int;
 using uint16 = unsigned short;
@@ -15,8 +23,8 @@ unsigned long rapid::address_to_integer(const void *a)
 }
 
 template<typename T>
-static inline void copy_memory(void *dst, void *src)
-{ *(reinterpret_cast<T *>(dst)) = *(reinterpret_cast<T *>(src)); }
+static inline void copy_memory(void *dst, const void *src)
+{ *(reinterpret_cast<T *>(dst)) = *(reinterpret_cast<const T *>(src)); }
 
 /* copy memory with positive order, not check overlapping areas
  * param[dst]: the begin pos of the destination memory
@@ -24,9 +32,10 @@ static inline void copy_memory(void *dst, void *src)
  * param[count]: copy number
  */
 template<typename T>
-static void __mem_copy(void *dst, void *src, rapid::size_type count)
+static void __mem_copy(void *dst, const void *src, rapid::size_type count)
 {
-    char *d = reinterpret_cast<char *>(dst), *s = reinterpret_cast<char *>(src);
+    char *d = reinterpret_cast<char *>(dst);
+    const char *s = reinterpret_cast<const char *>(src);
     while(count-- > 0)
     {
         copy_memory<T>(d, s);
@@ -41,9 +50,10 @@ static void __mem_copy(void *dst, void *src, rapid::size_type count)
  * param[count]: copy number
  */
 template<typename T>
-static void __mem_rcopy(void *dst, void *src, rapid::size_type count)
+static void __mem_rcopy(void *dst, const void *src, rapid::size_type count)
 {
-    char *d = reinterpret_cast<char *>(dst) - sizeof(T), *s = reinterpret_cast<char *>(src) - sizeof(T);
+    char *d = reinterpret_cast<char *>(dst) - sizeof(T);
+    const char *s = reinterpret_cast<const char *>(src) - sizeof(T);
     while(count-- > 0)
     {
         copy_memory<T>(d, s);
@@ -52,31 +62,30 @@ static void __mem_rcopy(void *dst, void *src, rapid::size_type count)
     }
 }
 
-void rapid::mem_copy(void *dst, void *src, const size_type size)
+//-----------------------scalar kernel-----------------------//
+
+static void __scalar_copy(char *d, const char *s, rapid::size_type size)
 {
-    null_return2(dst, src);
-    char *d = reinterpret_cast<char *>(dst), *s = reinterpret_cast<char *>(src);
-    size_type count = size / 8;
+    rapid::size_type count = size / 8;
     __mem_copy<uint64>(d, s, count);
     count = count * 8;
     __mem_copy<uint8>(d + count, s + count, size % 8);
 }
 
-void rapid::mem_rcopy(void *dst, void *src, const size_type size)
+// [d] and [s] are the begin pos, copy from the end to the begin
+static void __scalar_rcopy(char *d, const char *s, rapid::size_type size)
 {
-    null_return2(dst, src);
-    char *d = reinterpret_cast<char *>(dst) + size, *s = reinterpret_cast<char *>(src) + size;
-    size_type count = size / 8;
+    d += size;
+    s += size;
+    rapid::size_type count = size / 8;
     __mem_rcopy<uint64>(d, s, count);
     count = count * 8;
     __mem_rcopy<uint8>(d - count, s - count, size % 8);
 }
 
-void rapid::mem_clear(void *dst, const size_type size)
+static void __scalar_clear(char *d, rapid::size_type size)
 {
-    null_return1(dst);
-    char *d = reinterpret_cast<char *>(dst);
-    size_type count_8byte = size / 8;
+    rapid::size_type count_8byte = size / 8;
     while(count_8byte-- > 0)
     {
         *(reinterpret_cast<uint64 *>(d)) = 0;
@@ -85,47 +94,25 @@ void rapid::mem_clear(void *dst, const size_type size)
     uint8 count_remain = size % 8;
     while(count_remain-- > 0)
     {
-        *(reinterpret_cast<uint64 *>(d)) = 0;
+        *(reinterpret_cast<uint8 *>(d)) = 0;
         d++;
     }
 }
 
-void rapid::mem_scopy(void *dst, void *src, const size_type size)
-{
-    null_return2(dst, src);
-    unsigned long copy_size = static_cast<unsigned long>(size);
-    char *d = reinterpret_cast<char *>(dst), *s = reinterpret_cast<char *>(src);
-    if(address_to_integer(dst) > address_to_integer(src))
-    {
-        if(address_to_integer(src) + copy_size < address_to_integer(dst))
-        { mem_backward(s, size, static_cast<size_type>(address_to_integer(dst) - address_to_integer(src))); }
-        else
-        { mem_copy(d, s, size); }
-    }
-    else if(address_to_integer(dst) < address_to_integer(src))
-    {
-        if(address_to_integer(dst) + copy_size < address_to_integer(src))
-        { mem_forward(s, size, static_cast<size_type>(address_to_integer(src) - address_to_integer(dst))); }
-        else
-        { mem_copy(d, s, size); }
-    }
-}
-
-int rapid::mem_compare(void *arg1, void *arg2, const size_type size)
+static int __scalar_compare(const char *a1, const char *a2, rapid::size_type size)
 {
-    char *a1 = reinterpret_cast<char *>(arg1), *a2 = reinterpret_cast<char *>(arg2);
-    size_type count = size / 8;
-    for(size_type i = 0; i < count; i++)
+    rapid::size_type count = size / 8;
+    for(rapid::size_type i = 0; i < count; i++)
     {
-        if(*reinterpret_cast<uint64 *>(a1) > *reinterpret_cast<uint64 *>(a2))
+        if(*reinterpret_cast<const uint64 *>(a1) > *reinterpret_cast<const uint64 *>(a2))
             return 1;
-        if(*reinterpret_cast<uint64 *>(a1) < *reinterpret_cast<uint64 *>(a2))
+        if(*reinterpret_cast<const uint64 *>(a1) < *reinterpret_cast<const uint64 *>(a2))
             return -1;
         a1 += 8;
         a2 += 8;
     }
     count = size % 8;
-    for(size_type i = 0; i < count; i++)
+    for(rapid::size_type i = 0; i < count; i++)
     {
         if(*a1 > *a2)
             return 1;
@@ -137,11 +124,10 @@ int rapid::mem_compare(void *arg1, void *arg2, const size_type size)
     return 0;
 }
 
-void rapid::mem_swap(void *arg1, void *arg2, const size_type size)
+static void __scalar_swap(char *a1, char *a2, rapid::size_type size)
 {
-    char *a1 = reinterpret_cast<char *>(arg1), *a2 = reinterpret_cast<char *>(arg2);
-    size_type count = size / 8;
-    for(size_type i = 0; i < count; i++)
+    rapid::size_type count = size / 8;
+    for(rapid::size_type i = 0; i < count; i++)
     {
         uint64 temp = *reinterpret_cast<uint64 *>(a1);
         *reinterpret_cast<uint64 *>(a1) = *reinterpret_cast<uint64 *>(a2);
@@ -150,7 +136,7 @@ void rapid::mem_swap(void *arg1, void *arg2, const size_type size)
         a2 += 8;
     }
     count = size % 8;
-    for(size_type i = 0; i < count; i++)
+    for(rapid::size_type i = 0; i < count; i++)
     {
         char ch = *a1;
         *a1 = *a2;
@@ -160,6 +146,579 @@ void rapid::mem_swap(void *arg1, void *arg2, const size_type size)
     }
 }
 
+//-----------------------scalar search and hash-----------------------//
+
+static inline uint64 __load64(const char *p)
+{
+    uint64 value;
+    __builtin_memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32 __load32(const char *p)
+{
+    uint32 value;
+    __builtin_memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// index of the first element in [begin, count) of [p] equal to [value], [count] if not found
+template<typename T>
+static rapid::size_type __scalar_find(const char *p, rapid::size_type begin, rapid::size_type count, T value)
+{
+    for(rapid::size_type i = begin; i < count; i++)
+    {
+        T element;
+        __builtin_memcpy(&element, p + i * sizeof(T), sizeof(T));
+        if(element == value)
+            return i;
+    }
+    return count;
+}
+
+static rapid::size_type __scalar_find_element(const char *p, rapid::size_type count, uint64 value, rapid::size_type width)
+{
+    switch(width)
+    {
+    case 1: return __scalar_find<uint8>(p, 0, count, static_cast<uint8>(value));
+    case 2: return __scalar_find<uint16>(p, 0, count, static_cast<uint16>(value));
+    case 4: return __scalar_find<uint32>(p, 0, count, static_cast<uint32>(value));
+    default: return __scalar_find<uint64>(p, 0, count, value);
+    }
+}
+
+static rapid::size_type __scalar_count(const char *p, uint8 value, rapid::size_type size)
+{
+    rapid::size_type count = 0;
+    for(rapid::size_type i = 0; i < size; i++)
+    {
+        if(static_cast<uint8>(p[i]) == value)
+            count++;
+    }
+    return count;
+}
+
+// [pattern_size] is 2 at least
+static const char* __scalar_find_pattern(const char *p, rapid::size_type size,
+                                         const char *pattern, rapid::size_type pattern_size)
+{
+    for(rapid::size_type i = 0; i + pattern_size <= size; i++)
+    {
+        if(p[i] == pattern[0] && p[i + pattern_size - 1] == pattern[pattern_size - 1] &&
+           __scalar_compare(p + i + 1, pattern + 1, pattern_size - 2) == 0)
+            return p + i;
+    }
+    return nullptr;
+}
+
+/* add [stripes] stripes of 32 bytes to the 4 lanes of the hash accumulator,
+ * lane i takes bytes [8i, 8i + 8) of every stripe, the simd kernels give the same result
+ */
+static void __scalar_hash_stripes(uint64 *acc, const char *p, rapid::size_type stripes, const uint64 *secret)
+{
+    for(; stripes > 0; stripes--, p += 32)
+    {
+        for(int i = 0; i < 4; i++)
+        {
+            uint64 data = __load64(p + 8 * i);
+            uint64 key = data ^ secret[i];
+            acc[i] += data + (key & 0xFFFFFFFFULL) * (key >> 32);
+        }
+    }
+}
+
+// the byte number before [p] reaches the [align] boundary, not more than [size]
+static inline rapid::size_type __align_head(const void *p, rapid::size_type align, rapid::size_type size)
+{
+    rapid::size_type head = (align - (rapid::address_to_integer(p) & (align - 1))) & (align - 1);
+    return head < size ? head : size;
+}
+
+// the byte number after the last [align] boundary before [p], not more than [size]
+static inline rapid::size_type __align_tail(const void *p, rapid::size_type align, rapid::size_type size)
+{
+    rapid::size_type tail = rapid::address_to_integer(p) & (align - 1);
+    return tail < size ? tail : size;
+}
+
+//-----------------------simd kernel-----------------------//
+
+#ifdef RAPID_SIMD_X86
+
+/* generate the copy, rcopy, clear, compare and swap kernels of one instruction set
+ * stores are aligned on the destination, head and tail are done by the scalar kernel,
+ * loads of every 4 vectors are issued before their stores, so that the forward copy
+ * stays correct when [dst] < [src] and the reverse copy stays correct when [dst] > [src]
+ * param[isa]: name prefix of the kernels
+ * param[tgt]: the target attribute of the kernels
+ * param[W]: vector byte width
+ * param[V]: vector type
+ * param[LOADU]: unaligned load
+ * param[STORE]: aligned store
+ * param[STOREU]: unaligned store
+ * param[ZERO]: zero vector
+ * param[DIFFER]: whether two vectors are different
+ * param[STREAM]: aligned non-temporal store
+ */
+#define REGIST_SIMD_KERNEL(isa, tgt, W, V, LOADU, STORE, STOREU, ZERO, DIFFER, STREAM) \
+    __attribute__((target(tgt))) \
+    static void isa##_copy(char *d, const char *s, rapid::size_type size) \
+    { \
+        rapid::size_type head = __align_head(d, W, size); \
+        __scalar_copy(d, s, head); \
+        d += head; s += head; size -= head; \
+        for(; size >= 4 * W; size -= 4 * W, d += 4 * W, s += 4 * W) \
+        { \
+            V x0 = LOADU(reinterpret_cast<const V *>(s)); \
+            V x1 = LOADU(reinterpret_cast<const V *>(s + W)); \
+            V x2 = LOADU(reinterpret_cast<const V *>(s + 2 * W)); \
+            V x3 = LOADU(reinterpret_cast<const V *>(s + 3 * W)); \
+            STORE(reinterpret_cast<V *>(d), x0); \
+            STORE(reinterpret_cast<V *>(d + W), x1); \
+            STORE(reinterpret_cast<V *>(d + 2 * W), x2); \
+            STORE(reinterpret_cast<V *>(d + 3 * W), x3); \
+        } \
+        for(; size >= W; size -= W, d += W, s += W) \
+        { STORE(reinterpret_cast<V *>(d), LOADU(reinterpret_cast<const V *>(s))); } \
+        __scalar_copy(d, s, size); \
+    } \
+    __attribute__((target(tgt))) \
+    static void isa##_rcopy(char *d, const char *s, rapid::size_type size) \
+    { \
+        rapid::size_type tail = __align_tail(d + size, W, size); \
+        size -= tail; \
+        __scalar_rcopy(d + size, s + size, tail); \
+        for(; size >= 4 * W; size -= 4 * W) \
+        { \
+            char *de = d + size - 4 * W; \
+            const char *se = s + size - 4 * W; \
+            V x3 = LOADU(reinterpret_cast<const V *>(se + 3 * W)); \
+            V x2 = LOADU(reinterpret_cast<const V *>(se + 2 * W)); \
+            V x1 = LOADU(reinterpret_cast<const V *>(se + W)); \
+            V x0 = LOADU(reinterpret_cast<const V *>(se)); \
+            STORE(reinterpret_cast<V *>(de + 3 * W), x3); \
+            STORE(reinterpret_cast<V *>(de + 2 * W), x2); \
+            STORE(reinterpret_cast<V *>(de + W), x1); \
+            STORE(reinterpret_cast<V *>(de), x0); \
+        } \
+        for(; size >= W; size -= W) \
+        { STORE(reinterpret_cast<V *>(d + size - W), LOADU(reinterpret_cast<const V *>(s + size - W))); } \
+        __scalar_rcopy(d, s, size); \
+    } \
+    __attribute__((target(tgt))) \
+    static void isa##_clear(char *d, rapid::size_type size) \
+    { \
+        rapid::size_type head = __align_head(d, W, size); \
+        __scalar_clear(d, head); \
+        d += head; size -= head; \
+        V zero = ZERO(); \
+        for(; size >= 4 * W; size -= 4 * W, d += 4 * W) \
+        { \
+            STORE(reinterpret_cast<V *>(d), zero); \
+            STORE(reinterpret_cast<V *>(d + W), zero); \
+            STORE(reinterpret_cast<V *>(d + 2 * W), zero); \
+            STORE(reinterpret_cast<V *>(d + 3 * W), zero); \
+        } \
+        for(; size >= W; size -= W, d += W) \
+        { STORE(reinterpret_cast<V *>(d), zero); } \
+        __scalar_clear(d, size); \
+    } \
+    __attribute__((target(tgt))) \
+    static int isa##_compare(const char *a1, const char *a2, rapid::size_type size) \
+    { \
+        rapid::size_type offset = 0; \
+        for(; offset + W <= size; offset += W) \
+        { \
+            if(DIFFER(LOADU(reinterpret_cast<const V *>(a1 + offset)), \
+                      LOADU(reinterpret_cast<const V *>(a2 + offset)))) \
+            { break; } \
+        } \
+        return __scalar_compare(a1 + offset, a2 + offset, size - offset); \
+    } \
+    __attribute__((target(tgt))) \
+    static void isa##_swap(char *a1, char *a2, rapid::size_type size) \
+    { \
+        rapid::size_type head = __align_head(a1, W, size); \
+        __scalar_swap(a1, a2, head); \
+        a1 += head; a2 += head; size -= head; \
+        for(; size >= W; size -= W, a1 += W, a2 += W) \
+        { \
+            V x = LOADU(reinterpret_cast<const V *>(a1)); \
+            V y = LOADU(reinterpret_cast<const V *>(a2)); \
+            STORE(reinterpret_cast<V *>(a1), y); \
+            STOREU(reinterpret_cast<V *>(a2), x); \
+        } \
+        __scalar_swap(a1, a2, size); \
+    } \
+    __attribute__((target(tgt))) \
+    static void isa##_stream_copy(char *d, const char *s, rapid::size_type size) \
+    { \
+        rapid::size_type head = __align_head(d, W, size); \
+        __scalar_copy(d, s, head); \
+        d += head; s += head; size -= head; \
+        for(; size >= 4 * W; size -= 4 * W, d += 4 * W, s += 4 * W) \
+        { \
+            V x0 = LOADU(reinterpret_cast<const V *>(s)); \
+            V x1 = LOADU(reinterpret_cast<const V *>(s + W)); \
+            V x2 = LOADU(reinterpret_cast<const V *>(s + 2 * W)); \
+            V x3 = LOADU(reinterpret_cast<const V *>(s + 3 * W)); \
+            STREAM(reinterpret_cast<V *>(d), x0); \
+            STREAM(reinterpret_cast<V *>(d + W), x1); \
+            STREAM(reinterpret_cast<V *>(d + 2 * W), x2); \
+            STREAM(reinterpret_cast<V *>(d + 3 * W), x3); \
+        } \
+        for(; size >= W; size -= W, d += W, s += W) \
+        { STREAM(reinterpret_cast<V *>(d), LOADU(reinterpret_cast<const V *>(s))); } \
+        _mm_sfence(); \
+        __scalar_copy(d, s, size); \
+    } \
+    __attribute__((target(tgt))) \
+    static void isa##_stream_clear(char *d, rapid::size_type size) \
+    { \
+        rapid::size_type head = __align_head(d, W, size); \
+        __scalar_clear(d, head); \
+        d += head; size -= head; \
+        V zero = ZERO(); \
+        for(; size >= W; size -= W, d += W) \
+        { STREAM(reinterpret_cast<V *>(d), zero); } \
+        _mm_sfence(); \
+        __scalar_clear(d, size); \
+    }
+
+#define SSE2_DIFFER(x, y) (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xFFFF)
+#define AVX2_DIFFER(x, y) (_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) != -1)
+#define AVX512_DIFFER(x, y) (_mm512_cmpneq_epi64_mask(x, y) != 0)
+
+REGIST_SIMD_KERNEL(__sse2, "sse2", 16, __m128i,
+                   _mm_loadu_si128, _mm_store_si128, _mm_storeu_si128,
+                   _mm_setzero_si128, SSE2_DIFFER, _mm_stream_si128)
+REGIST_SIMD_KERNEL(__avx2, "avx2", 32, __m256i,
+                   _mm256_loadu_si256, _mm256_store_si256, _mm256_storeu_si256,
+                   _mm256_setzero_si256, AVX2_DIFFER, _mm256_stream_si256)
+REGIST_SIMD_KERNEL(__avx512, "avx512f", 64, __m512i,
+                   _mm512_loadu_si512, _mm512_store_si512, _mm512_storeu_si512,
+                   _mm512_setzero_si512, AVX512_DIFFER, _mm512_stream_si512)
+
+/* generate the function of one instruction set finding an element of type [T]
+ * param[EQ]: lanes of [T] equal
+ * param[SET]: broadcast [T] to all lanes
+ * others are the same as REGIST_SIMD_SEARCH_KERNEL
+ */
+#define REGIST_SIMD_FIND(isa, tgt, W, PFX, BITS, T, EQ, SET) \
+    __attribute__((target(tgt))) \
+    static rapid::size_type isa##_find_##T(const char *p, rapid::size_type count, T value) \
+    { \
+        using V = __m##BITS##i; \
+        const V needle = SET(value); \
+        rapid::size_type bytes = count * sizeof(T), i = 0; \
+        uint32 mask; \
+        for(; i + 4 * W <= bytes; i += 4 * W) \
+        { \
+            V e0 = EQ(PFX##_loadu_si##BITS(reinterpret_cast<const V *>(p + i)), needle); \
+            V e1 = EQ(PFX##_loadu_si##BITS(reinterpret_cast<const V *>(p + i + W)), needle); \
+            V e2 = EQ(PFX##_loadu_si##BITS(reinterpret_cast<const V *>(p + i + 2 * W)), needle); \
+            V e3 = EQ(PFX##_loadu_si##BITS(reinterpret_cast<const V *>(p + i + 3 * W)), needle); \
+            if(PFX##_movemask_epi8(PFX##_or_si##BITS(PFX##_or_si##BITS(e0, e1), PFX##_or_si##BITS(e2, e3))) == 0) \
+            { continue; } \
+            if((mask = static_cast<uint32>(PFX##_movemask_epi8(e0))) != 0) \
+            { return (i + __builtin_ctz(mask)) / sizeof(T); } \
+            if((mask = static_cast<uint32>(PFX##_movemask_epi8(e1))) != 0) \
+            { return (i + W + __builtin_ctz(mask)) / sizeof(T); } \
+            if((mask = static_cast<uint32>(PFX##_movemask_epi8(e2))) != 0) \
+            { return (i + 2 * W + __builtin_ctz(mask)) / sizeof(T); } \
+            mask = static_cast<uint32>(PFX##_movemask_epi8(e3)); \
+            return (i + 3 * W + __builtin_ctz(mask)) / sizeof(T); \
+        } \
+        for(; i + W <= bytes; i += W) \
+        { \
+            mask = static_cast<uint32>(PFX##_movemask_epi8(EQ(PFX##_loadu_si##BITS(reinterpret_cast<const V *>(p + i)), needle))); \
+            if(mask != 0) \
+            { return (i + __builtin_ctz(mask)) / sizeof(T); } \
+        } \
+        return __scalar_find<T>(p, i / sizeof(T), count, value); \
+    }
+
+/* generate the search and hash kernels of one instruction set, the intrinsics are
+ * named by [PFX] and [BITS], such as _mm_loadu_si128 and _mm256_loadu_si256
+ * head and tail shorter than a vector are done by the scalar kernel
+ * param[isa]: name prefix of the kernels
+ * param[tgt]: the target attribute of the kernels
+ * param[W]: vector byte width, 16 or 32
+ * param[PFX]: intrinsic prefix
+ * param[BITS]: vector bit width
+ * param[EQ64]: 64 bit lanes equal
+ */
+#define REGIST_SIMD_SEARCH_KERNEL(isa, tgt, W, PFX, BITS, EQ64) \
+    REGIST_SIMD_FIND(isa, tgt, W, PFX, BITS, uint8, PFX##_cmpeq_epi8, PFX##_set1_epi8) \
+    REGIST_SIMD_FIND(isa, tgt, W, PFX, BITS, uint16, PFX##_cmpeq_epi16, PFX##_set1_epi16) \
+    REGIST_SIMD_FIND(isa, tgt, W, PFX, BITS, uint32, PFX##_cmpeq_epi32, PFX##_set1_epi32) \
+    REGIST_SIMD_FIND(isa, tgt, W, PFX, BITS, uint64, EQ64, PFX##_set1_epi64x) \
+    static rapid::size_type isa##_find_element(const char *p, rapid::size_type count, uint64 value, rapid::size_type width) \
+    { \
+        switch(width) \
+        { \
+        case 1: return isa##_find_uint8(p, count, static_cast<uint8>(value)); \
+        case 2: return isa##_find_uint16(p, count, static_cast<uint16>(value)); \
+        case 4: return isa##_find_uint32(p, count, static_cast<uint32>(value)); \
+        default: return isa##_find_uint64(p, count, value); \
+        } \
+    } \
+    __attribute__((target(tgt))) \
+    static rapid::size_type isa##_count(const char *p, uint8 value, rapid::size_type size) \
+    { \
+        using V = __m##BITS##i; \
+        const V needle = PFX##_set1_epi8(static_cast<char>(value)), zero = PFX##_setzero_si##BITS(); \
+        rapid::size_type count = 0, i = 0; \
+        while(i + W <= size) \
+        { \
+            /* every byte lane counts up to 255 matches before it is summed */ \
+            rapid::size_type round = (size - i) / W; \
+            if(round > 255) round = 255; \
+            V sum = zero; \
+            for(; round > 0; round--, i += W) \
+            { sum = PFX##_sub_epi8(sum, PFX##_cmpeq_epi8(PFX##_loadu_si##BITS(reinterpret_cast<const V *>(p + i)), needle)); } \
+            uint64 lanes[W / 8]; \
+            PFX##_storeu_si##BITS(reinterpret_cast<V *>(lanes), PFX##_sad_epu8(sum, zero)); \
+            for(rapid::size_type k = 0; k < W / 8; k++) \
+            { count += lanes[k]; } \
+        } \
+        return count + __scalar_count(p + i, value, size - i); \
+    } \
+    __attribute__((target(tgt))) \
+    static const char* isa##_find_pattern(const char *p, rapid::size_type size, \
+                                          const char *pattern, rapid::size_type pattern_size) \
+    { \
+        using V = __m##BITS##i; \
+        /* candidates match the first and the last byte, the middle is compared after */ \
+        const V first = PFX##_set1_epi8(pattern[0]), last = PFX##_set1_epi8(pattern[pattern_size - 1]); \
+        rapid::size_type end = size - pattern_size + 1, i = 0; \
+        for(; i + W <= end; i += W) \
+        { \
+            V f = PFX##_cmpeq_epi8(PFX##_loadu_si##BITS(reinterpret_cast<const V *>(p + i)), first); \
+            V l = PFX##_cmpeq_epi8(PFX##_loadu_si##BITS(reinterpret_cast<const V *>(p + i + pattern_size - 1)), last); \
+            uint32 mask = static_cast<uint32>(PFX##_movemask_epi8(PFX##_and_si##BITS(f, l))); \
+            for(; mask != 0; mask &= mask - 1) \
+            { \
+                rapid::size_type k = i + __builtin_ctz(mask); \
+                if(__scalar_compare(p + k + 1, pattern + 1, pattern_size - 2) == 0) \
+                { return p + k; } \
+            } \
+        } \
+        return __scalar_find_pattern(p + i, size - i, pattern, pattern_size); \
+    } \
+    __attribute__((target(tgt))) \
+    static void isa##_hash_stripes(uint64 *acc, const char *p, rapid::size_type stripes, const uint64 *secret) \
+    { \
+        using V = __m##BITS##i; \
+        constexpr int N = 32 / W; \
+        V lane[N], key[N]; \
+        for(int j = 0; j < N; j++) \
+        { \
+            lane[j] = PFX##_loadu_si##BITS(reinterpret_cast<const V *>(acc + j * W / 8)); \
+            key[j] = PFX##_loadu_si##BITS(reinterpret_cast<const V *>(secret + j * W / 8)); \
+        } \
+        for(; stripes > 0; stripes--, p += 32) \
+        { \
+            for(int j = 0; j < N; j++) \
+            { \
+                V data = PFX##_loadu_si##BITS(reinterpret_cast<const V *>(p + j * W)); \
+                V k = PFX##_xor_si##BITS(data, key[j]); \
+                V product = PFX##_mul_epu32(k, PFX##_srli_epi64(k, 32)); \
+                lane[j] = PFX##_add_epi64(lane[j], PFX##_add_epi64(data, product)); \
+            } \
+        } \
+        for(int j = 0; j < N; j++) \
+        { PFX##_storeu_si##BITS(reinterpret_cast<V *>(acc + j * W / 8), lane[j]); } \
+    }
+
+// sse2 has no 64 bit compare, both 32 bit halves must be equal
+__attribute__((target("sse2")))
+static inline __m128i __sse2_cmpeq_epi64(__m128i x, __m128i y)
+{
+    __m128i e = _mm_cmpeq_epi32(x, y);
+    return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+REGIST_SIMD_SEARCH_KERNEL(__sse2, "sse2", 16, _mm, 128, __sse2_cmpeq_epi64)
+REGIST_SIMD_SEARCH_KERNEL(__avx2, "avx2", 32, _mm256, 256, _mm256_cmpeq_epi64)
+
+#endif // RAPID_SIMD_X86
+
+// there is no non-temporal store without simd, stream with the ordinary kernel
+#define __scalar_stream_copy __scalar_copy
+#define __scalar_stream_clear __scalar_clear
+
+//-----------------------dispatch-----------------------//
+
+struct MemoryKernel
+{
+    rapid::size_type Width;
+    void (*Copy)(char *, const char *, rapid::size_type);
+    void (*RCopy)(char *, const char *, rapid::size_type);
+    void (*Clear)(char *, rapid::size_type);
+    int (*Compare)(const char *, const char *, rapid::size_type);
+    void (*Swap)(char *, char *, rapid::size_type);
+    void (*StreamCopy)(char *, const char *, rapid::size_type);
+    void (*StreamClear)(char *, rapid::size_type);
+    rapid::size_type (*FindElement)(const char *, rapid::size_type, uint64, rapid::size_type);
+    rapid::size_type (*Count)(const char *, uint8, rapid::size_type);
+    const char* (*FindPattern)(const char *, rapid::size_type, const char *, rapid::size_type);
+    void (*HashStripes)(uint64 *, const char *, rapid::size_type, const uint64 *);
+};
+
+// [search] is the prefix of the search kernels, avx512f has no byte compare, it searches with avx2
+#define KERNEL_OF(isa, search, W) \
+    MemoryKernel{ W, isa##_copy, isa##_rcopy, isa##_clear, isa##_compare, isa##_swap, \
+                  isa##_stream_copy, isa##_stream_clear, \
+                  search##_find_element, search##_count, search##_find_pattern, search##_hash_stripes }
+
+// choose the widest kernel supported by cpu, only called once
+static MemoryKernel __select_kernel()
+{
+#ifdef RAPID_SIMD_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+    { return KERNEL_OF(__avx512, __avx2, 64); }
+    if(__builtin_cpu_supports("avx2"))
+    { return KERNEL_OF(__avx2, __avx2, 32); }
+    if(__builtin_cpu_supports("sse2"))
+    { return KERNEL_OF(__sse2, __sse2, 16); }
+#endif
+    return KERNEL_OF(__scalar, __scalar, 8);
+}
+
+static const MemoryKernel& __kernel()
+{
+    static const MemoryKernel kernel = __select_kernel();
+    return kernel;
+}
+
+// select the kernel at startup instead of at the first call
+__attribute__((unused)) static const MemoryKernel &__startup_kernel = __kernel();
+
+// the last level cache size, or 8MB if it is unknown
+static rapid::size_type __default_stream_threshold()
+{
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if(llc > 0)
+    { return static_cast<rapid::size_type>(llc); }
+#endif
+    return 8 * 1024 * 1024;
+}
+
+static rapid::size_type& __stream_threshold_value()
+{
+    static rapid::size_type threshold = __default_stream_threshold();
+    return threshold;
+}
+
+// read by every copy on any thread while it may be set, relaxed is enough for a tuning value
+static inline rapid::size_type __stream_threshold()
+{ return __atomic_load_n(&__stream_threshold_value(), __ATOMIC_RELAXED); }
+
+rapid::size_type rapid::mem_simd_width()
+{ return __kernel().Width; }
+
+rapid::size_type rapid::mem_stream_threshold()
+{ return __stream_threshold(); }
+
+void rapid::mem_set_stream_threshold(const size_type size)
+{ __atomic_store_n(&__stream_threshold_value(), size, __ATOMIC_RELAXED); }
+
+void rapid::mem_copy(void *dst, void *src, const size_type size)
+{
+    null_return2(dst, src);
+    char *d = reinterpret_cast<char *>(dst), *s = reinterpret_cast<char *>(src);
+    if(size < __kernel().Width)
+    { __scalar_copy(d, s, size); }
+    // overlapping areas are moved in cache, they will be read again immediately
+    else if(size >= __stream_threshold() && (d + size <= s || s + size <= d))
+    { __kernel().StreamCopy(d, s, size); }
+    else
+    { __kernel().Copy(d, s, size); }
+}
+
+void rapid::mem_stream_copy(void *dst, void *src, const size_type size)
+{
+    null_return2(dst, src);
+    char *d = reinterpret_cast<char *>(dst), *s = reinterpret_cast<char *>(src);
+    if(size < __kernel().Width)
+    { __scalar_copy(d, s, size); }
+    else
+    { __kernel().StreamCopy(d, s, size); }
+}
+
+void rapid::mem_rcopy(void *dst, void *src, const size_type size)
+{
+    null_return2(dst, src);
+    char *d = reinterpret_cast<char *>(dst), *s = reinterpret_cast<char *>(src);
+    if(size < __kernel().Width)
+    { __scalar_rcopy(d, s, size); }
+    else
+    { __kernel().RCopy(d, s, size); }
+}
+
+void rapid::mem_clear(void *dst, const size_type size)
+{
+    null_return1(dst);
+    char *d = reinterpret_cast<char *>(dst);
+    if(size < __kernel().Width)
+    { __scalar_clear(d, size); }
+    else if(size >= __stream_threshold())
+    { __kernel().StreamClear(d, size); }
+    else
+    { __kernel().Clear(d, size); }
+}
+
+void rapid::mem_stream_clear(void *dst, const size_type size)
+{
+    null_return1(dst);
+    char *d = reinterpret_cast<char *>(dst);
+    if(size < __kernel().Width)
+    { __scalar_clear(d, size); }
+    else
+    { __kernel().StreamClear(d, size); }
+}
+
+void rapid::mem_scopy(void *dst, void *src, const size_type size)
+{
+    null_return2(dst, src);
+    unsigned long copy_size = static_cast<unsigned long>(size);
+    char *d = reinterpret_cast<char *>(dst), *s = reinterpret_cast<char *>(src);
+    if(address_to_integer(dst) > address_to_integer(src))
+    {
+        if(address_to_integer(src) + copy_size < address_to_integer(dst))
+        { mem_backward(s, size, static_cast<size_type>(address_to_integer(dst) - address_to_integer(src))); }
+        else
+        { mem_copy(d, s, size); }
+    }
+    else if(address_to_integer(dst) < address_to_integer(src))
+    {
+        if(address_to_integer(dst) + copy_size < address_to_integer(src))
+        { mem_forward(s, size, static_cast<size_type>(address_to_integer(src) - address_to_integer(dst))); }
+        else
+        { mem_copy(d, s, size); }
+    }
+}
+
+int rapid::mem_compare(void *arg1, void *arg2, const size_type size)
+{
+    const char *a1 = reinterpret_cast<const char *>(arg1), *a2 = reinterpret_cast<const char *>(arg2);
+    if(size < __kernel().Width)
+    { return __scalar_compare(a1, a2, size); }
+    return __kernel().Compare(a1, a2, size);
+}
+
+void rapid::mem_swap(void *arg1, void *arg2, const size_type size)
+{
+    char *a1 = reinterpret_cast<char *>(arg1), *a2 = reinterpret_cast<char *>(arg2);
+    if(size < __kernel().Width)
+    { __scalar_swap(a1, a2, size); }
+    else
+    { __kernel().Swap(a1, a2, size); }
+}
+
 void rapid::mem_backward(void *begin, const rapid::size_type size, const rapid::size_type move_distance)
 {
     mem_rcopy(reinterpret_cast<char *>(begin) + move_distance, reinterpret_cast<char *>(begin), size);
@@ -175,3 +734,129 @@ void rapid::mem_move(void *dst, void *src, const rapid::size_type size)
     mem_scopy(dst, src, size);
 }
 
+void* rapid::mem_find(const void *src, int value, const size_type size)
+{
+    if(src == nullptr) return nullptr;
+    const char *p = reinterpret_cast<const char *>(src);
+    size_type index = __kernel().FindElement(p, size, static_cast<uint8>(value), 1);
+    return index == size ? nullptr : const_cast<char *>(p + index);
+}
+
+void* rapid::mem_find_pattern(const void *src, const size_type size, const void *pattern, const size_type pattern_size)
+{
+    if(src == nullptr || pattern_size > size) return nullptr;
+    const char *p = reinterpret_cast<const char *>(src), *pat = reinterpret_cast<const char *>(pattern);
+    if(pattern_size == 0)
+    { return const_cast<char *>(p); }
+    if(pattern_size == 1)
+    { return mem_find(src, static_cast<uint8>(pat[0]), size); }
+    return const_cast<char *>(__kernel().FindPattern(p, size, pat, pattern_size));
+}
+
+rapid::size_type rapid::mem_count(const void *src, int value, const size_type size)
+{
+    if(src == nullptr) return 0;
+    return __kernel().Count(reinterpret_cast<const char *>(src), static_cast<uint8>(value), size);
+}
+
+rapid::size_type rapid::mem_find_element(const void *src, const size_type count, const void *value, const size_type width)
+{
+    if(src == nullptr || value == nullptr) return count;
+    uint64 v = 0;
+    switch(width)
+    {
+    case 1: v = *reinterpret_cast<const uint8 *>(value); break;
+    case 2: __builtin_memcpy(&v, value, 2); v = static_cast<uint16>(v); break;
+    case 4: __builtin_memcpy(&v, value, 4); v = static_cast<uint32>(v); break;
+    case 8: __builtin_memcpy(&v, value, 8); break;
+    default: return count;
+    }
+    return __kernel().FindElement(reinterpret_cast<const char *>(src), count, v, width);
+}
+
+//-----------------------hash-----------------------//
+
+static constexpr uint64 __hash_secret[8] =
+{
+    0x9E3779B185EBCA87ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0x85EBCA77C2B2AE63ULL,
+    0x27D4EB2F165667C5ULL, 0xBE4BA423396CFEB8ULL, 0x1CAD21F72C81017CULL, 0xDB979083E96DD4DEULL
+};
+
+// fold the 128 bit product of [a] and [b]
+static inline uint64 __hash_mix(uint64 a, uint64 b)
+{
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64>(product) ^ static_cast<uint64>(product >> 64);
+}
+
+static inline uint64 __hash_avalanche(uint64 h)
+{
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+// spread the high bits of the accumulator, done every 16 stripes
+static inline void __hash_scramble(uint64 *acc)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        acc[i] ^= acc[i] >> 47;
+        acc[i] ^= __hash_secret[4 + i];
+        acc[i] *= 0x9E3779B1ULL;
+    }
+}
+
+rapid::size_type rapid::mem_hash(const void *src, const size_type size, const size_type seed)
+{
+    const char *p = reinterpret_cast<const char *>(src);
+    uint64 h;
+    if(size <= 16)
+    {
+        uint64 a = 0, b = 0;
+        if(size >= 8)
+        {
+            a = __load64(p);
+            b = __load64(p + size - 8);
+        }
+        else if(size >= 4)
+        {
+            a = __load32(p);
+            b = __load32(p + size - 4);
+        }
+        else if(size > 0)
+        {
+            a = static_cast<uint8>(p[0]);
+            a = (a << 8) | static_cast<uint8>(p[size >> 1]);
+            a = (a << 8) | static_cast<uint8>(p[size - 1]);
+        }
+        h = __hash_mix(a ^ (__hash_secret[0] + seed), b ^ (__hash_secret[1] - seed));
+    }
+    else if(size <= 32)
+    {
+        h = __hash_mix(__load64(p) ^ (__hash_secret[0] + seed), __load64(p + 8) ^ (__hash_secret[1] - seed)) +
+            __hash_mix(__load64(p + size - 16) ^ (__hash_secret[2] + seed), __load64(p + size - 8) ^ (__hash_secret[3] - seed));
+    }
+    else
+    {
+        const uint64 secret[4] = { __hash_secret[0] + seed, __hash_secret[1] - seed,
+                                   __hash_secret[2] + seed, __hash_secret[3] - seed };
+        uint64 acc[4] = { __hash_secret[4], __hash_secret[5], __hash_secret[6], __hash_secret[7] };
+        // the last stripe is taken from the end, it may overlap the one before
+        const char *last = p + size - 32;
+        for(size_type stripes = (size - 1) / 32; stripes > 0;)
+        {
+            size_type round = stripes < 16 ? stripes : 16;
+            __kernel().HashStripes(acc, p, round, secret);
+            if(round == 16)
+            { __hash_scramble(acc); }
+            p += round * 32;
+            stripes -= round;
+        }
+        __kernel().HashStripes(acc, last, 1, secret);
+        h = __hash_mix(acc[0] ^ __hash_secret[4], acc[1] ^ __hash_secret[5]) +
+            __hash_mix(acc[2] ^ __hash_secret[6], acc[3] ^ __hash_secret[7]);
+    }
+    return __hash_avalanche(h + size * __hash_secret[2]);
+}
@@ -2,6 +2,8 @@
 #define MEMORY_H
 
 #include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include <new>
 
 namespace rapid
 {
@@ -74,6 +76,166 @@ void mem_swap(void *arg1, void *arg2, const size_type size);
 // set memory to 0
 void mem_clear(void *dst, const size_type size);
 
+/* copy memory with non-temporal stores, the destination is not kept in cache,
+ * not check overlapping areas
+ * param[dst]: the begin pos of the destination memory
+ * param[src]: the begin pos of the source memory
+ * param[size]: the size required to copy
+ */
+void mem_stream_copy(void *dst, void *src, const size_type size);
+
+// set memory to 0 with non-temporal stores, the memory is not kept in cache
+void mem_stream_clear(void *dst, const size_type size);
+
+/* mem_copy and mem_clear switch to the stream way when size >= threshold
+ * the default threshold is the size of the last level cache
+ */
+size_type mem_stream_threshold();
+void mem_set_stream_threshold(const size_type size);
+
+/* the byte width of the vector kernel selected by cpuid at startup
+ * return: 64(avx512), 32(avx2), 16(sse2) or 8(scalar)
+ */
+size_type mem_simd_width();
+
+/* find the first byte equal to [value]
+ * param[src]: the begin pos of the memory
+ * param[value]: converted to unsigned char
+ * param[size]: byte size of the memory
+ * return: pointer to the byte, nullptr if not found
+ */
+void* mem_find(const void *src, int value, const size_type size);
+
+/* find the first occurrence of [pattern] in [src]
+ * param[src]: the begin pos of the memory
+ * param[size]: byte size of the memory
+ * param[pattern]: the begin pos of the bytes to be found
+ * param[pattern_size]: byte size of the pattern, [src] is returned if it is 0
+ * return: pointer to the occurrence, nullptr if not found
+ */
+void* mem_find_pattern(const void *src, const size_type size, const void *pattern, const size_type pattern_size);
+
+/* count the bytes equal to [value]
+ * param[value]: converted to unsigned char
+ */
+size_type mem_count(const void *src, int value, const size_type size);
+
+/* find the first element whose bytes are equal to the bytes of [value]
+ * param[src]: the begin pos of an array
+ * param[count]: element number of the array
+ * param[value]: pointer to the element to be found
+ * param[width]: byte size of an element, 1, 2, 4 or 8
+ * return: index of the element, [count] if not found or [width] is not supported
+ */
+size_type mem_find_element(const void *src, const size_type count, const void *value, const size_type width);
+
+/* 64 bit hash of [size] bytes, the result depends only on the bytes and [seed],
+ * not on the simd kernel, so it can key tables shared by different machines of one byte order
+ * param[seed]: gives another hash function
+ */
+size_type mem_hash(const void *src, const size_type size, const size_type seed = 0);
+
+/* destroy [n] objects of [p], nothing is done for trivially destructible objects
+ * param[p]: the begin pos of the objects
+ * param[n]: object number
+ */
+template<typename T>
+void destroy(T *p, size_type n)
+{
+    if(IsTriviallyDestructible<T>::value) return;
+    for(size_type i = 0; i < n; i++)
+    { p[i].~T(); }
+}
+
+/* copy construct [n] objects of [src] in the raw memory [dst], not check overlapping areas
+ * trivially copyable objects are copied by mem_copy
+ * if a constructor throws, the objects constructed are destroyed and the exception is thrown again
+ * return: the end of the objects constructed
+ */
+template<typename T>
+T* uninitialized_copy(T *dst, const T *src, size_type n)
+{
+    if(IsTriviallyCopyable<T>::value)
+    {
+        mem_copy(dst, const_cast<T *>(src), n * sizeof(T));
+        return dst + n;
+    }
+    size_type i = 0;
+    try
+    {
+        for(; i < n; i++)
+        { ::new(static_cast<void *>(dst + i)) T(src[i]); }
+    }
+    catch(...)
+    {
+        rapid::destroy(dst, i);
+        throw;
+    }
+    return dst + n;
+}
+
+/* move construct [n] objects of [src] in the raw memory [dst], not check overlapping areas,
+ * the objects of [src] are left moved from
+ * trivially copyable objects are copied by mem_copy
+ * return: the end of the objects constructed
+ */
+template<typename T>
+T* uninitialized_move(T *dst, T *src, size_type n)
+{
+    if(IsTriviallyCopyable<T>::value)
+    {
+        mem_copy(dst, src, n * sizeof(T));
+        return dst + n;
+    }
+    size_type i = 0;
+    try
+    {
+        for(; i < n; i++)
+        { ::new(static_cast<void *>(dst + i)) T(rapid::move(src[i])); }
+    }
+    catch(...)
+    {
+        rapid::destroy(dst, i);
+        throw;
+    }
+    return dst + n;
+}
+
+/* move [n] objects of [src] to the raw memory [dst], [src] becomes raw memory,
+ * the areas can overlap
+ * trivially relocatable objects are moved by mem_copy, others are move constructed
+ * and destroyed one by one
+ */
+template<typename T>
+void relocate(T *dst, T *src, size_type n)
+{
+    if(dst == src || n == 0) return;
+    if(IsTriviallyRelocatable<T>::value)
+    {
+        if(dst < src)
+        { mem_copy(dst, src, n * sizeof(T)); }
+        else
+        { mem_rcopy(dst, src, n * sizeof(T)); }
+        return;
+    }
+    if(dst < src)
+    {
+        for(size_type i = 0; i < n; i++)
+        {
+            ::new(static_cast<void *>(dst + i)) T(rapid::move(src[i]));
+            src[i].~T();
+        }
+    }
+    else
+    {
+        for(size_type i = n; i > 0; i--)
+        {
+            ::new(static_cast<void *>(dst + i - 1)) T(rapid::move(src[i - 1]));
+            src[i - 1].~T();
+        }
+    }
+}
+
 
 };
 
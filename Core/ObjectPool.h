@@ -0,0 +1,412 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include "Core/Version.h"
+#include <cstddef> // std::max_align_t
+#include <new>
+
+namespace rapid
+{
+
+/* memory from ::operator new aligned to [align], which only guarantees the alignment of std::max_align_t
+ * an over-aligned block keeps the pointer ::operator new returned just before it
+ */
+inline void* __pool_allocate(size_type size, size_type align)
+{
+    if(align <= alignof(std::max_align_t))
+    { return ::operator new(static_cast<std::size_t>(size)); }
+    char *raw = static_cast<char *>(::operator new(static_cast<std::size_t>(size + align)));
+    unsigned long p = (reinterpret_cast<unsigned long>(raw) + align) & ~static_cast<unsigned long>(align - 1);
+    reinterpret_cast<void **>(p)[-1] = raw;
+    return reinterpret_cast<void *>(p);
+}
+
+// param[align]: the alignment [p] was allocated with
+inline void __pool_deallocate(void *p, size_type align)
+{
+    if(align <= alignof(std::max_align_t))
+    { ::operator delete(p); }
+    else
+    { ::operator delete(static_cast<void **>(p)[-1]); }
+}
+
+/* fixed-size pool of [T], memory is cut from slabs and freed objects
+ * are kept on an intrusive freelist, so the latest freed one is handed out first
+ * slabs are given back only when the pool is destroyed or release() is called
+ * not thread safe
+ */
+template<typename T>
+class ObjectPool
+{
+public:
+    using ValueType = T;
+    using Pointer = ValueType*;
+    using SizeType = size_type;
+
+    static constexpr SizeType DefaultSlabBytes = 16 * 1024;
+private:
+    union Slot
+    {
+        Slot *Next;
+        alignas(alignof(ValueType)) unsigned char Data[sizeof(ValueType)];
+    };
+    struct Slab
+    {
+        Slab *Next;
+        SizeType Size;
+
+        Slot* begin()
+        { return reinterpret_cast<Slot *>(reinterpret_cast<char *>(this) + _SF_header_size()); }
+        Slot* end()
+        { return begin() + Size; }
+    };
+
+    Slot *_M_free = nullptr;
+    SizeType _M_free_count = 0;
+    Slab *_M_slabs = nullptr;
+    Slot *_M_cursor = nullptr;// slots after it in the newest slab have never been handed out
+    Slot *_M_limit = nullptr;
+    SizeType _M_slab_size;
+
+    static constexpr SizeType _SF_header_size()
+    { return (sizeof(Slab) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot); }
+
+    Pointer _F_allocate_slow();
+public:
+    // param[slab_size]: object count of each slab
+    explicit ObjectPool(SizeType slab_size = DefaultSlabBytes / sizeof(Slot) + 1)
+        : _M_slab_size(slab_size) { }
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool& operator=(const ObjectPool &) = delete;
+    ~ObjectPool()
+    { release(); }
+
+    // memory of one [T], nothing is constructed
+    Pointer allocate()
+    {
+        if(_M_free != nullptr)
+        {
+            Slot *s = _M_free;
+            _M_free = s->Next;
+            --_M_free_count;
+            return reinterpret_cast<Pointer>(s);
+        }
+        if(_M_cursor != _M_limit)
+        { return reinterpret_cast<Pointer>(_M_cursor++); }
+        return _F_allocate_slow();
+    }
+    // param[p]: memory from allocate() of this pool
+    void deallocate(Pointer p)
+    {
+        Slot *s = reinterpret_cast<Slot *>(p);
+        s->Next = _M_free;
+        _M_free = s;
+        ++_M_free_count;
+    }
+
+    template<typename ... Args>
+    Pointer create(const Args & ... args)
+    {
+        Pointer p = allocate();
+        try
+        { ::new(p) ValueType(args...); }
+        catch(...)
+        {
+            deallocate(p);
+            throw;
+        }
+        return p;
+    }
+    void destroy(Pointer p)
+    {
+        if(p == nullptr) return;
+        p->~ValueType();
+        deallocate(p);
+    }
+
+    /* move all free memory and slabs of [pool] into this pool
+     * objects of [pool] can be given back to this pool since then
+     */
+    void merge(ObjectPool &pool);
+    /* move at most [count] freed objects to the freelist of [pool], the slabs stay with this pool
+     * so this pool must not be released while [pool] may hand them out
+     * return: number of objects moved
+     */
+    SizeType transfer(ObjectPool &pool, SizeType count);
+    // give back all slabs, objects handed out become invalid
+    void release();
+
+    SizeType slab_size() const
+    { return _M_slab_size; }
+    // object count of all slabs
+    SizeType capacity() const;
+    // object count on the freelist, slots never handed out are not counted
+    SizeType free_count() const
+    { return _M_free_count; }
+};
+
+/* standard allocator whose single object allocations come from a per-thread ObjectPool
+ * an object can be deallocated by any thread, it joins the freelist of that thread
+ * a thread holding more than CacheLimit freed objects moves CacheBatch of them to a shared pool,
+ * a thread whose freelist is empty takes them back from there before cutting a new slab,
+ * so objects freed by a consumer thread return to the producer thread and memory stays bounded
+ * when a thread exits, its pool is moved into the shared one that is adopted by the next new thread
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+    using ValueType = T;
+    using Pointer = ValueType*;
+    using SizeType = size_type;
+    using PoolType = ObjectPool<ValueType>;
+
+    using value_type = ValueType;// std
+
+    static constexpr SizeType CacheLimit = 256;
+    static constexpr SizeType CacheBatch = 128;
+private:
+    struct ThreadGuard
+    {
+        ~ThreadGuard()
+        { _SF_retire(); }
+    };
+
+    static PoolType*& _SF_local()
+    {
+        static thread_local PoolType *pool = nullptr;
+        return pool;
+    }
+    static bool& _SF_retired()
+    {
+        static thread_local bool retired = false;
+        return retired;
+    }
+    // never destroyed, objects may still be given back after all thread pools are gone
+    static PoolType& _SF_orphan()
+    {
+        static PoolType *pool = new PoolType();
+        return *pool;
+    }
+    // free count of the shared pool, written under the lock, read without it as a hint
+    static SizeType& _SF_orphan_free()
+    {
+        static SizeType count = 0;
+        return count;
+    }
+    static volatile int& _SF_orphan_lock()
+    {
+        static volatile int lock = 0;
+        return lock;
+    }
+    static void _SF_lock()
+    {
+        while(__sync_lock_test_and_set(&_SF_orphan_lock(), 1))
+        {
+            while(__atomic_load_n(&_SF_orphan_lock(), __ATOMIC_RELAXED) != 0)
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+        }
+    }
+    static void _SF_unlock()
+    {
+        __atomic_store_n(&_SF_orphan_free(), _SF_orphan().free_count(), __ATOMIC_RELAXED);
+        __sync_lock_release(&_SF_orphan_lock());
+    }
+
+    static PoolType* _SF_pool()
+    {
+        PoolType *pool = _SF_local();
+        if(pool != nullptr || _SF_retired())
+        { return pool; }
+        pool = new PoolType();
+        _SF_lock();
+        pool->merge(_SF_orphan());
+        _SF_unlock();
+        static thread_local ThreadGuard guard;
+        un_use(guard);
+        return _SF_local() = pool;
+    }
+    static void _SF_retire()
+    {
+        PoolType *pool = _SF_local();
+        _SF_local() = nullptr;
+        _SF_retired() = true;
+        if(pool == nullptr) return;
+        _SF_lock();
+        _SF_orphan().merge(*pool);
+        _SF_unlock();
+        delete pool;
+    }
+public:
+    PoolAllocator() noexcept { }
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U> &) noexcept { }
+
+    Pointer allocate(SizeType n)
+    {
+        if(n != 1)
+        { return static_cast<Pointer>(__pool_allocate(n * sizeof(ValueType), alignof(ValueType))); }
+        PoolType *pool = _SF_pool();
+        if(pool != nullptr)
+        {
+            if(pool->free_count() == 0 && __atomic_load_n(&_SF_orphan_free(), __ATOMIC_RELAXED) != 0)
+            {
+                _SF_lock();
+                _SF_orphan().transfer(*pool, CacheBatch);
+                _SF_unlock();
+            }
+            return pool->allocate();
+        }
+        _SF_lock();
+        Pointer p = _SF_orphan().allocate();
+        _SF_unlock();
+        return p;
+    }
+    void deallocate(Pointer p, SizeType n)
+    {
+        if(n != 1)
+        {
+            __pool_deallocate(p, alignof(ValueType));
+            return;
+        }
+        PoolType *pool = _SF_pool();
+        if(pool != nullptr)
+        {
+            pool->deallocate(p);
+            if(pool->free_count() > CacheLimit)
+            {
+                _SF_lock();
+                pool->transfer(_SF_orphan(), CacheBatch);
+                _SF_unlock();
+            }
+            return;
+        }
+        _SF_lock();
+        _SF_orphan().deallocate(p);
+        _SF_unlock();
+    }
+
+    // object count of the shared pool's slabs, it owns every slab once the threads using it have exited
+    static SizeType capacity()
+    {
+        _SF_lock();
+        SizeType result = _SF_orphan().capacity();
+        _SF_unlock();
+        return result;
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U> &) const noexcept
+    { return true; }
+    template<typename U>
+    bool operator!=(const PoolAllocator<U> &) const noexcept
+    { return false; }
+};
+
+//-----------------------impl-----------------------//
+//-----------------------impl-----------------------//
+//-----------------------impl-----------------------//
+//-----------------------impl-----------------------//
+//-----------------------impl-----------------------//
+
+template<typename T>
+typename ObjectPool<T>::Pointer ObjectPool<T>::_F_allocate_slow()
+{
+    SizeType size = _M_slab_size == 0 ? 1 : _M_slab_size;
+    Slab *slab = static_cast<Slab *>(__pool_allocate(_SF_header_size() + size * sizeof(Slot), alignof(Slot)));
+    slab->Size = size;
+    slab->Next = _M_slabs;
+    _M_slabs = slab;
+    _M_cursor = slab->begin();
+    _M_limit = slab->end();
+    return reinterpret_cast<Pointer>(_M_cursor++);
+}
+
+template<typename T>
+void ObjectPool<T>::merge(ObjectPool &pool)
+{
+    if(&pool == this) return;
+    // the slots never handed out are put on the freelist
+    while(pool._M_cursor != pool._M_limit)
+    { pool.deallocate(reinterpret_cast<Pointer>(pool._M_cursor++)); }
+    if(pool._M_free != nullptr)
+    {
+        Slot *last = pool._M_free;
+        while(last->Next != nullptr)
+        { last = last->Next; }
+        last->Next = _M_free;
+        _M_free = pool._M_free;
+        _M_free_count += pool._M_free_count;
+    }
+    if(pool._M_slabs != nullptr)
+    {
+        Slab *last = pool._M_slabs;
+        while(last->Next != nullptr)
+        { last = last->Next; }
+        // keep the newest slab of this pool at the head, _M_cursor points into it
+        if(_M_slabs == nullptr)
+        { _M_slabs = pool._M_slabs; }
+        else
+        {
+            last->Next = _M_slabs->Next;
+            _M_slabs->Next = pool._M_slabs;
+        }
+    }
+    pool._M_free = nullptr;
+    pool._M_free_count = 0;
+    pool._M_slabs = nullptr;
+    pool._M_cursor = pool._M_limit = nullptr;
+}
+
+template<typename T>
+typename ObjectPool<T>::SizeType ObjectPool<T>::transfer(ObjectPool &pool, SizeType count)
+{
+    if(&pool == this || _M_free == nullptr || count == 0) return 0;
+    Slot *first = _M_free;
+    Slot *last = first;
+    SizeType moved = 1;
+    while(last->Next != nullptr && moved < count)
+    {
+        last = last->Next;
+        ++moved;
+    }
+    _M_free = last->Next;
+    _M_free_count -= moved;
+    last->Next = pool._M_free;
+    pool._M_free = first;
+    pool._M_free_count += moved;
+    return moved;
+}
+
+template<typename T>
+void ObjectPool<T>::release()
+{
+    Slab *slab = _M_slabs;
+    while(slab != nullptr)
+    {
+        Slab *next = slab->Next;
+        __pool_deallocate(slab, alignof(Slot));
+        slab = next;
+    }
+    _M_slabs = nullptr;
+    _M_free = nullptr;
+    _M_free_count = 0;
+    _M_cursor = _M_limit = nullptr;
+}
+
+template<typename T>
+typename ObjectPool<T>::SizeType ObjectPool<T>::capacity() const
+{
+    SizeType result = 0;
+    for(Slab *slab = _M_slabs; slab != nullptr; slab = slab->Next)
+    { result += slab->Size; }
+    return result;
+}
+
+};
+
+#endif // OBJECTPOOL_H
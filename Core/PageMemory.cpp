@@ -0,0 +1,222 @@
+#include "PageMemory.h"
+#include "Memory.h"
+
+#if defined(__unix__)
+#include <sys/mman.h>
+#include <unistd.h> // sysconf
+#else
+#include <cstdlib> // std::malloc std::free
+#endif
+#if defined(__linux__)
+#include <cstdio> // std::fopen
+#endif
+
+static inline rapid::size_type __round_up(rapid::size_type size, rapid::size_type align)
+{ return (size + align - 1) & ~(align - 1); }
+
+static rapid::size_type __page_size()
+{
+#if defined(__unix__)
+    long size = sysconf(_SC_PAGESIZE);
+    if(size > 0)
+    { return static_cast<rapid::size_type>(size); }
+#endif
+    return 4096;
+}
+
+static rapid::size_type __huge_page_size()
+{
+#if defined(__linux__)
+    std::FILE *f = std::fopen("/proc/meminfo", "r");
+    if(f != nullptr)
+    {
+        char line[128];
+        unsigned long kb = 0;
+        while(std::fgets(line, sizeof(line), f) != nullptr)
+        {
+            if(std::sscanf(line, "Hugepagesize: %lu kB", &kb) == 1)
+            { break; }
+        }
+        std::fclose(f);
+        if(kb > 0)
+        { return static_cast<rapid::size_type>(kb) * 1024; }
+    }
+#endif
+    return 2 * 1024 * 1024;
+}
+
+rapid::size_type rapid::page_size()
+{
+    static size_type size = __page_size();
+    return size;
+}
+
+rapid::size_type rapid::huge_page_size()
+{
+    static size_type size = __huge_page_size();
+    return size;
+}
+
+#if defined(__unix__)
+
+static void* __map(rapid::size_type size, int flags)
+{
+    void *p = mmap(nullptr, static_cast<std::size_t>(size), PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+static void __advise_huge(void *p, rapid::size_type size)
+{
+#if defined(MADV_HUGEPAGE)
+    if(size >= rapid::huge_page_size())
+    { madvise(p, static_cast<std::size_t>(size), MADV_HUGEPAGE); }
+#else
+    un_use(p);
+    un_use(size);
+#endif
+}
+
+/* reserve [size] bytes of address space aligned to [align]
+ * param[size]: multiple of the page size
+ */
+static void* __map_aligned(rapid::size_type size, rapid::size_type align, int prot)
+{
+    rapid::size_type total = size + align - rapid::page_size();
+    void *p = mmap(nullptr, static_cast<std::size_t>(total), prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p == MAP_FAILED) return nullptr;
+    unsigned long begin = reinterpret_cast<unsigned long>(p);
+    unsigned long aligned = __round_up(begin, align);
+    if(aligned > begin)
+    { munmap(p, aligned - begin); }
+    unsigned long end = begin + total;
+    if(aligned + size < end)
+    { munmap(reinterpret_cast<void *>(aligned + size), end - aligned - size); }
+    return reinterpret_cast<void *>(aligned);
+}
+
+// hugetlb regions can only be unmapped and moved in whole huge pages
+static inline rapid::size_type __region_size(rapid::size_type size, rapid::PageHint hint)
+{ return __round_up(size, hint == rapid::PageHint::Huge ? rapid::huge_page_size() : rapid::page_size()); }
+
+void* rapid::page_allocate(size_type size, PageHint hint, size_type align, PageHint *mapped)
+{
+    if(size == 0) return nullptr;
+    if(align < page_size())
+    { align = page_size(); }
+#if defined(MAP_HUGETLB)
+    if(hint == PageHint::Huge && align <= huge_page_size())
+    {
+        void *p = __map(__region_size(size, hint), MAP_HUGETLB);
+        if(p != nullptr)
+        {
+            if(mapped != nullptr)
+            { *mapped = PageHint::Huge; }
+            return p;
+        }
+    }
+#endif
+    if(hint == PageHint::Huge)
+    { hint = PageHint::Transparent; }
+    size = __round_up(size, page_size());
+    void *p = align == page_size() ? __map(size, 0) : __map_aligned(size, align, PROT_READ | PROT_WRITE);
+    if(p != nullptr && hint != PageHint::Normal)
+    { __advise_huge(p, size); }
+    if(mapped != nullptr)
+    { *mapped = hint; }
+    return p;
+}
+
+bool rapid::page_release(void *p, size_type size, PageHint hint)
+{
+    if(p == nullptr) return true;
+    return munmap(p, static_cast<std::size_t>(__region_size(size, hint))) == 0;
+}
+
+void* rapid::page_reallocate(void *p, size_type old_size, size_type new_size, PageHint hint,
+                             size_type align, PageHint *mapped)
+{
+    if(p == nullptr)
+    { return page_allocate(new_size, hint, align, mapped); }
+    if(align < page_size())
+    { align = page_size(); }
+    if(mapped != nullptr)
+    { *mapped = hint; }
+    size_type old_total = __region_size(old_size, hint);
+    size_type new_total = __region_size(new_size, hint);
+    if(new_total == old_total)
+    { return p; }
+    if(new_total < old_total)
+    {
+        if(munmap(static_cast<char *>(p) + new_total, static_cast<std::size_t>(old_total - new_total)) != 0)
+        { return nullptr; }
+        return p;
+    }
+#if defined(__linux__)
+    // grow in place, then move the pages to a new place
+    void *result = mremap(p, static_cast<std::size_t>(old_total), static_cast<std::size_t>(new_total), 0);
+    if(result == MAP_FAILED)
+    {
+        // a hugetlb region is aligned to the huge page size by the kernel wherever it is moved
+        if(align == page_size() || hint == PageHint::Huge)
+        { result = mremap(p, static_cast<std::size_t>(old_total), static_cast<std::size_t>(new_total), MREMAP_MAYMOVE); }
+        else
+        {
+            void *target = __map_aligned(new_total, align, PROT_NONE);
+            result = target == nullptr ? MAP_FAILED :
+                     mremap(p, static_cast<std::size_t>(old_total), static_cast<std::size_t>(new_total),
+                            MREMAP_MAYMOVE | MREMAP_FIXED, target);
+            if(result == MAP_FAILED && target != nullptr)
+            { munmap(target, static_cast<std::size_t>(new_total)); }
+        }
+    }
+    if(result != MAP_FAILED)
+    {
+        if(hint == PageHint::Transparent)
+        { __advise_huge(result, new_total); }
+        return result;
+    }
+#endif
+    // hugetlb regions the kernel can not move and systems without mremap are copied
+    void *copy = page_allocate(new_size, hint, align, mapped);
+    if(copy == nullptr) return nullptr;
+    mem_copy(copy, p, old_size);
+    page_release(p, old_size, hint);
+    return copy;
+}
+
+void rapid::page_discard(void *p, size_type size)
+{
+    if(p == nullptr) return;
+    unsigned long begin = __round_up(reinterpret_cast<unsigned long>(p), page_size());
+    unsigned long end = (reinterpret_cast<unsigned long>(p) + size) & ~(page_size() - 1);
+    if(begin >= end) return;
+    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED);
+}
+
+#else
+
+void* rapid::page_allocate(size_type size, PageHint, size_type, PageHint *mapped)
+{
+    if(mapped != nullptr)
+    { *mapped = PageHint::Normal; }
+    return std::calloc(1, static_cast<std::size_t>(size));
+}
+
+bool rapid::page_release(void *p, size_type, PageHint)
+{
+    std::free(p);
+    return true;
+}
+
+void* rapid::page_reallocate(void *p, size_type, size_type new_size, PageHint, size_type, PageHint *mapped)
+{
+    if(mapped != nullptr)
+    { *mapped = PageHint::Normal; }
+    return std::realloc(p, static_cast<std::size_t>(new_size));
+}
+
+void rapid::page_discard(void *, size_type)
+{ }
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef PAGEMEMORY_H
+#define PAGEMEMORY_H
+
+#include "Core/Version.h"
+
+namespace rapid
+{
+
+enum class PageHint : unsigned char
+{
+    Normal,
+    Transparent,// ask the kernel to back the region with transparent huge pages
+    Huge// map from the huge page pool, fall back to Transparent if the pool is empty
+};
+
+// byte size of a normal page
+size_type page_size();
+
+// byte size of a huge page, 2M if it is unknown
+size_type huge_page_size();
+
+/* map a region of whole pages from the system
+ * param[size]: byte size required, rounded up to the page size, or the huge page size for the huge page pool
+ * param[hint]: what kind of page backs the region
+ * param[align]: power of 2, 0 means the page size
+ * param[mapped]: if not nullptr, receives the hint the region really got, Huge only if it is from the huge page pool
+ * return: the region filled with 0, nullptr if out of memory
+ */
+void* page_allocate(size_type size, PageHint hint = PageHint::Normal, size_type align = 0, PageHint *mapped = nullptr);
+
+/* unmap a region from page_allocate or page_reallocate
+ * param[size]: the byte size it was asked for
+ * param[hint]: the hint received through [mapped], a region from the huge page pool is unmapped in huge pages
+ * return: false if the system refuses, [size] or [hint] does not match the region
+ */
+bool page_release(void *p, size_type size, PageHint hint = PageHint::Normal);
+
+/* resize a region, the pages are moved by the kernel instead of being copied
+ * param[old_size]: the byte size it was asked for
+ * param[new_size]: byte size required
+ * param[hint]: the hint received through [mapped], also applied to the pages added
+ * param[align]: the alignment it was asked for
+ * param[mapped]: if not nullptr, receives the hint the new region really got
+ * return: the new region, nullptr if out of memory or the system refuses, [p] is untouched then
+ */
+void* page_reallocate(void *p, size_type old_size, size_type new_size, PageHint hint = PageHint::Normal,
+                      size_type align = 0, PageHint *mapped = nullptr);
+
+/* give the physical pages inside [p, p + size) back to the system, the region stays mapped
+ * and reads 0 since then, pages only partly covered are kept
+ */
+void page_discard(void *p, size_type size);
+
+};
+
+#endif // PAGEMEMORY_H
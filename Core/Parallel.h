@@ -0,0 +1,157 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include "Core/Range.h"
+#include "Core/ThreadPool.h"
+
+namespace rapid
+{
+
+/* the order parallel_reduce combines the partial results in
+ * Any: the chunks depend on the number of workers of the pool
+ * Deterministic: the chunks only depend on the size and the grain, so a floating point
+ * result is the same on any machine and any pool
+ */
+enum class ReduceOrder : unsigned char
+{
+    Any,
+    Deterministic
+};
+
+// chunk count of ReduceOrder::Deterministic when the grain is not given
+constexpr size_type DeterministicChunks = 256;
+
+/* items run by one task when the grain is not given, about 8 chunks per thread
+ * so stealing balances items of uneven cost
+ */
+inline size_type parallel_grain(size_type size, size_type threads)
+{
+    size_type grain = size / (threads * 8);
+    return grain == 0 ? 1 : grain;
+}
+
+/* split [begin, end) in halves until a half is not larger than [grain], the right halves
+ * are spawned and the left ones are run by this thread
+ * param[chunk]: chunk(begin, end) runs the items of a half
+ */
+template<typename _Chunk>
+void __parallel_split(ThreadPool &pool, size_type begin, size_type end, size_type grain, _Chunk &chunk)
+{
+    if(end - begin <= grain)
+    {
+        chunk(begin, end);
+        return;
+    }
+    size_type middle = begin + (end - begin) / 2;
+    TaskGroup group(pool);
+    group.spawn([&pool, middle, end, grain, &chunk]() { __parallel_split(pool, middle, end, grain, chunk); });
+    __parallel_split(pool, begin, middle, grain, chunk);
+    group.sync();
+}
+
+// the same split as __parallel_split, the result of a half is combine(left, right)
+template<typename V, typename _Chunk, typename _Combine>
+V __parallel_reduce(ThreadPool &pool, size_type begin, size_type end, size_type grain,
+                    const V &identity, _Chunk &chunk, _Combine &combine)
+{
+    if(end - begin <= grain)
+    { return chunk(identity, begin, end); }
+    size_type middle = begin + (end - begin) / 2;
+    V right = identity;
+    TaskGroup group(pool);
+    group.spawn([&]() { right = __parallel_reduce(pool, middle, end, grain, identity, chunk, combine); });
+    V left = __parallel_reduce(pool, begin, middle, grain, identity, chunk, combine);
+    group.sync();
+    return combine(rapid::move(left), rapid::move(right));
+}
+
+inline size_type __reduce_grain(size_type size, size_type grain, ReduceOrder order, const ThreadPool &pool)
+{
+    if(grain != 0) return grain;
+    if(order == ReduceOrder::Any) return parallel_grain(size, pool.thread_count());
+    grain = size / DeterministicChunks;
+    return grain == 0 ? 1 : grain;
+}
+
+/* call body(i) for every i of [range] on [pool], it returns when all calls return
+ * the calls run at the same time, [body] must not change state shared by them
+ * the first exception thrown by [body] is thrown again here
+ * param[grain]: items run by one task, 0 chooses by the size and the pool
+ */
+template<typename T, typename _Body>
+void parallel_for(const Range<T> &range, _Body body, size_type grain = 0, ThreadPool &pool = ThreadPool::global())
+{
+    static_assert(IsIntegral<T>::value, "only support integral range");
+    if(range.last() < range.first()) return;
+    T first = range.first();
+    size_type size = static_cast<size_type>(range.last() - range.first()) + 1;
+    auto chunk = [first, &body](size_type begin, size_type end)
+    {
+        for(size_type i = begin; i < end; ++i)
+        { body(static_cast<T>(first + static_cast<T>(i))); }
+    };
+    __parallel_split(pool, 0, size, grain == 0 ? parallel_grain(size, pool.thread_count()) : grain, chunk);
+}
+
+// call body(*it) for every it of [first, last), a random access iterator range such as Vector's
+template<typename _Iterator, typename _Body>
+void parallel_for(_Iterator first, _Iterator last, _Body body, size_type grain = 0, ThreadPool &pool = ThreadPool::global())
+{
+    size_type size = static_cast<size_type>(last - first);
+    if(size == 0) return;
+    auto chunk = [&first, &body](size_type begin, size_type end)
+    {
+        _Iterator it = first + begin;
+        for(size_type i = begin; i < end; ++i, ++it)
+        { body(*it); }
+    };
+    __parallel_split(pool, 0, size, grain == 0 ? parallel_grain(size, pool.thread_count()) : grain, chunk);
+}
+
+/* fold every i of [range] on [pool]
+ * every chunk starts from a copy of [identity] and folds with acc = body(acc, i) in order,
+ * the results of two neighbouring chunks are merged by combine(left, right)
+ * param[identity]: combine(identity, x) must equal x
+ * param[order]: whether the merge order may depend on the pool
+ */
+template<typename T, typename V, typename _Body, typename _Combine>
+V parallel_reduce(const Range<T> &range, const V &identity, _Body body, _Combine combine, size_type grain = 0,
+                  ReduceOrder order = ReduceOrder::Any, ThreadPool &pool = ThreadPool::global())
+{
+    static_assert(IsIntegral<T>::value, "only support integral range");
+    if(range.last() < range.first()) return identity;
+    T first = range.first();
+    size_type size = static_cast<size_type>(range.last() - range.first()) + 1;
+    auto chunk = [first, &body](const V &init, size_type begin, size_type end)
+    {
+        V acc = init;
+        for(size_type i = begin; i < end; ++i)
+        { acc = body(rapid::move(acc), static_cast<T>(first + static_cast<T>(i))); }
+        return acc;
+    };
+    return __parallel_reduce(pool, 0, size, __reduce_grain(size, grain, order, pool), identity, chunk, combine);
+}
+
+// fold every *it of [first, last) with acc = body(acc, *it), see the Range version
+template<typename _Iterator, typename V, typename _Body, typename _Combine>
+V parallel_reduce(_Iterator first, _Iterator last, const V &identity, _Body body, _Combine combine, size_type grain = 0,
+                  ReduceOrder order = ReduceOrder::Any, ThreadPool &pool = ThreadPool::global())
+{
+    size_type size = static_cast<size_type>(last - first);
+    if(size == 0) return identity;
+    auto chunk = [&first, &body](const V &init, size_type begin, size_type end)
+    {
+        V acc = init;
+        _Iterator it = first + begin;
+        for(size_type i = begin; i < end; ++i, ++it)
+        { acc = body(rapid::move(acc), *it); }
+        return acc;
+    };
+    return __parallel_reduce(pool, 0, size, __reduce_grain(size, grain, order, pool), identity, chunk, combine);
+}
+
+};
+
+#endif // PARALLEL_H
@@ -3,6 +3,7 @@
 
 #include "Core/Version.h"
 #include "Core/TypeTraits.h"
+#include <cstddef> // std::size_t
 
 namespace rapid
 {
@@ -124,6 +125,12 @@ public:
     iterator end() const
     { return iterator(_M_end); }
 
+    // the first and the last value, both are in the range
+    ConstReference first() const
+    { return _M_start; }
+    ConstReference last() const
+    { return _M_end; }
+
     reverse_iterator rbegin()
     { return reverse_iterator(_M_end); }
     reverse_iterator rend()
@@ -135,7 +142,7 @@ public:
 
 };
 
-Range<int> operator""_i(const char *c, size_type n)
+inline Range<int> operator""_i(const char *c, std::size_t n)
 {
     int start = 0, end = 0;
     bool is_start = true;
@@ -2,19 +2,40 @@
 #define RAPIDCONFIG_H
 
 #include "Version.h"
+#include "AllocStats.h"
+#include "Allocator.h"
+#include "Arena.h"
 #include "Atomic.h"
 #include "AVLTree.h"
 #include "BinaryTree.h"
+#include "ConcurrentStack.h"
 #include "Conver.h"
+#include "Deque.h"
 #include "DoubleLinkedList.h"
+#include "Epoch.h"
 #include "Exception.h"
+#include "Futex.h"
+#include "Hash.h"
+#include "HazardPointer.h"
 #include "IO.h"
+#include "Malloc.h"
 #include "Matrix.h"
+#include "MPMCQueue.h"
 #include "Memory.h"
+#include "PageMemory.h"
+#include "Parallel.h"
+#include "ObjectPool.h"
+#include "ShardedCounter.h"
 #include "Range.h"
 #include "SingleLinkedList.h"
+#include "SmallVector.h"
+#include "SPSCQueue.h"
+#include "SpinLock.h"
 #include "Stack.h"
+#include "Sync.h"
+#include "ThreadPool.h"
 #include "TLNode.h"
 #include "Vector.h"
+#include "WorkStealingDeque.h"
 
 #endif // RAPIDCONFIG_H
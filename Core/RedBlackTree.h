@@ -16,7 +16,7 @@ struct RBDataNode
         RED = false,
         BLACK = true
     };
-    NodeBase<DataType> *_M_data;
+    DataType _M_data;
     Color _M_color;
 
     using ValueType = DataType;
@@ -24,16 +24,13 @@ struct RBDataNode
     using ConstReference = const ValueType &;
 
     RBDataNode(const DataType &arg)
-        : _M_data(new NodeBase<DataType>(arg)), _M_color(Color::RED)
+        : _M_data(arg), _M_color(Color::RED)
     { }
 
-    void dealloc()
-    { delete _M_data; }
-
     Reference data()
-    { return _M_data->ref_content(); }
+    { return _M_data; }
     Reference data() const
-    { return _M_data->ref_content(); }
+    { return const_cast<Reference>(_M_data); }
     Color& color()
     { return _M_color; }
 
@@ -41,7 +38,9 @@ struct RBDataNode
     { return data() < arg.data(); }
 };
 
-template<typename _DataType, typename _Compare = Compare<_DataType>>
+template<typename _DataType,
+         typename _Compare = Compare<_DataType>,
+         typename _Alloc = NodeAllocator<_DataType, RedBlackTreeStatsTag>>
 class RedBlackTree
 {
 public:
@@ -53,8 +52,9 @@ public:
     using Self = RedBlackTree;
     using SizeType = size_type;
 
+    using AllocatorType = _Alloc;
     using DataNode = RBDataNode<ValueType>;
-    using TreeType = BinaryTree<DataNode>;
+    using TreeType = BinaryTree<DataNode, BTreeNode<DataNode>, RebindAllocator<AllocatorType, DataNode>>;
     using TreeNode = typename TreeType::TreeNode;
     using CompareType = _Compare;
 
@@ -93,7 +93,7 @@ public:
         iterator(const iterator &it)
             : _M_it(it._M_it) { }
         iterator(iterator &&it)
-            : _M_it(forward<iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<iterator>(it)._M_it) { }
 
         iterator operator++()
         {
@@ -141,7 +141,7 @@ public:
         const_iterator(const const_iterator &it)
             : _M_it(it._M_it) { }
         const_iterator(const_iterator &&it)
-            : _M_it(forward<const_iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_iterator>(it)._M_it) { }
 
         const_iterator operator++()
         {
@@ -189,7 +189,7 @@ public:
         reverse_iterator(const reverse_iterator &it)
             : _M_it(it._M_it) { }
         reverse_iterator(reverse_iterator &&it)
-            : _M_it(forward<reverse_iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<reverse_iterator>(it)._M_it) { }
 
         reverse_iterator operator++()
         {
@@ -237,7 +237,7 @@ public:
         const_reverse_iterator(const const_reverse_iterator &it)
             : _M_it(it._M_it) { }
         const_reverse_iterator(const_reverse_iterator &&it)
-            : _M_it(forward<const_reverse_iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_reverse_iterator>(it)._M_it) { }
 
         const_reverse_iterator operator++()
         {
@@ -286,7 +286,7 @@ public:
         fiterator(const fiterator &it)
             : _M_it(it._M_it) { }
         fiterator(fiterator &&it)
-            : _M_it(forward<fiterator>(it)._M_it) { }
+            : _M_it(rapid::forward<fiterator>(it)._M_it) { }
 
         fiterator operator++()
         {
@@ -334,7 +334,7 @@ public:
         aiterator(const aiterator &it)
             : _M_it(it._M_it) { }
         aiterator(aiterator &&it)
-            : _M_it(forward<aiterator>(it)._M_it) { }
+            : _M_it(rapid::forward<aiterator>(it)._M_it) { }
 
         aiterator operator++()
         {
@@ -382,7 +382,7 @@ public:
         const_aiterator(const const_aiterator &it)
             : _M_it(it._M_it) { }
         const_aiterator(const_aiterator &&it)
-            : _M_it(forward<const_aiterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_aiterator>(it)._M_it) { }
 
         const_aiterator operator++()
         {
@@ -430,7 +430,7 @@ public:
         const_fiterator(const const_fiterator &it)
             : _M_it(it._M_it) { }
         const_fiterator(const_fiterator &&it)
-            : _M_it(forward<const_fiterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_fiterator>(it)._M_it) { }
 
         const_fiterator operator++()
         {
@@ -476,11 +476,11 @@ private:
         node1->data()._M_color = node2->data()._M_color;
         node2->data()._M_color = c;
     }
+    // the colors stay in the place
     void _F_exchange_data(TreeNode *node1, TreeNode *node2)
     {
-        auto temp = node1->data()._M_data;
-        node1->data()._M_data = node2->data()._M_data;
-        node2->data()._M_data = temp;
+        node1->swap(node2);
+        _F_exchange_color(node1, node2);
     }
     // implement other's
     // param[node]: node to be added
@@ -504,7 +504,6 @@ private:
     { return node->data().color(); }
     void _F_release_node(TreeNode *node)
     {
-        node->data().dealloc();
         TreeNode *parent = _M_tree.parent(node);
         if(parent == nullptr)
         {
@@ -521,11 +520,13 @@ private:
     }
 public:
     RedBlackTree() { }
+    explicit RedBlackTree(const AllocatorType &alloc)
+        : _M_tree(typename TreeType::AllocatorType(alloc)) { }
 
     RedBlackTree(const Self &tree)
         : _M_tree(tree._M_tree) { }
     RedBlackTree(Self &&tree)
-        : _M_tree(forward<Self>(tree)._M_tree) { }
+        : _M_tree(rapid::forward<Self>(tree)._M_tree) { }
     RedBlackTree(std::initializer_list<ValueType> arg_list)
     { insert(arg_list); }
 
@@ -539,11 +540,11 @@ public:
     iterator find(ConstReference arg) const
     { return _F_find<ValueType, CompareType>(arg); }
     iterator find(RvalueReference arg) const
-    { return _F_find<ValueType, CompareType>(forward<ValueType>(arg)); }
+    { return _F_find<ValueType, CompareType>(rapid::forward<ValueType>(arg)); }
 
     template<typename _InputType, typename _CompareType>
     iterator find(_InputType &&arg) const
-    { return _F_find<_InputType, _CompareType>(forward<_InputType>(arg)); }
+    { return _F_find<_InputType, _CompareType>(rapid::forward<_InputType>(arg)); }
     template<typename _InputType, typename _CompareType>
     iterator find(const _InputType &arg) const
     { return _F_find<_InputType, _CompareType>(arg); }
@@ -569,14 +570,14 @@ public:
     void erase(ConstReference arg)
     { erase(find(arg)); }
     void erase(RvalueReference arg)
-    { erase(find(forward<ValueType>(arg))); }
+    { erase(find(rapid::forward<ValueType>(arg))); }
     void erase(iterator it)
     { _F_erase(_M_tree.tree_node(it._M_it)); }
 
     iterator insert(ConstReference arg)
     { return _F_insert(arg); }
     iterator insert(RvalueReference arg)
-    { return _F_insert(forward<ValueType>(arg)); }
+    { return _F_insert(rapid::forward<ValueType>(arg)); }
 
     iterator begin()
     { return _M_tree.begin(); }
@@ -632,11 +633,13 @@ public:
 
     TreeType to_ordinary_tree() const
     { return _M_tree; }
+    AllocatorType get_allocator() const
+    { return AllocatorType(_M_tree.get_allocator()); }
 };
 
-template<typename _DataType, typename _Compare>
-typename RedBlackTree<_DataType, _Compare>::iterator
-    RedBlackTree<_DataType, _Compare>::_F_insert(ConstReference arg)
+template<typename _DataType, typename _Compare, typename _Alloc>
+typename RedBlackTree<_DataType, _Compare, _Alloc>::iterator
+    RedBlackTree<_DataType, _Compare, _Alloc>::_F_insert(ConstReference arg)
 {
     iterator result = find_and_insert(arg);
     TreeNode *node = _M_tree.tree_node(result._M_it);
@@ -644,10 +647,10 @@ typename RedBlackTree<_DataType, _Compare>::iterator
     return result;
 }
 
-template<typename _DataType, typename _Compare>
+template<typename _DataType, typename _Compare, typename _Alloc>
 template<typename _InputType, typename _CompareType>
-typename RedBlackTree<_DataType, _Compare>::iterator
-    RedBlackTree<_DataType, _Compare>::_F_find(const _InputType &arg) const
+typename RedBlackTree<_DataType, _Compare, _Alloc>::iterator
+    RedBlackTree<_DataType, _Compare, _Alloc>::_F_find(const _InputType &arg) const
 {
     TreeNode *node = _M_tree.root();
     IteratorImpl result;
@@ -671,8 +674,8 @@ typename RedBlackTree<_DataType, _Compare>::iterator
 }
 
 
-template<typename _DataType, typename _Compare>
-void RedBlackTree<_DataType, _Compare>::_F_erase(TreeNode *node)
+template<typename _DataType, typename _Compare, typename _Alloc>
+void RedBlackTree<_DataType, _Compare, _Alloc>::_F_erase(TreeNode *node)
 {
     using Color = typename DataNode::Color;
     while(node != nullptr)
@@ -710,10 +713,10 @@ void RedBlackTree<_DataType, _Compare>::_F_erase(TreeNode *node)
     }
 }
 
-template<typename _DataType, typename _Compare>
+template<typename _DataType, typename _Compare, typename _Alloc>
 template<typename _InputType, typename _CompareType>
-typename RedBlackTree<_DataType, _Compare>::iterator
-    RedBlackTree<_DataType, _Compare>::find_and_insert(const _InputType &input)
+typename RedBlackTree<_DataType, _Compare, _Alloc>::iterator
+    RedBlackTree<_DataType, _Compare, _Alloc>::find_and_insert(const _InputType &input)
 {
     IteratorImpl result;
     if(empty())
@@ -756,8 +759,8 @@ typename RedBlackTree<_DataType, _Compare>::iterator
 
 
 
-template<typename _DataType, typename _Compare>
-void RedBlackTree<_DataType, _Compare>::_F_insert_adjust(TreeNode *node)
+template<typename _DataType, typename _Compare, typename _Alloc>
+void RedBlackTree<_DataType, _Compare, _Alloc>::_F_insert_adjust(TreeNode *node)
 {
     using Color = typename DataNode::Color;
     while(node != nullptr)
@@ -819,8 +822,8 @@ void RedBlackTree<_DataType, _Compare>::_F_insert_adjust(TreeNode *node)
     _F_node_color(_M_tree.root()) = Color::BLACK;
 }
 
-template<typename _DataType, typename _Compare>
-void RedBlackTree<_DataType, _Compare>::_F_erase_adjust(TreeNode *node)
+template<typename _DataType, typename _Compare, typename _Alloc>
+void RedBlackTree<_DataType, _Compare, _Alloc>::_F_erase_adjust(TreeNode *node)
 {
     using Color = typename DataNode::Color;
     while(node != nullptr)
@@ -0,0 +1,202 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include "Core/TLNode.h"
+#include "Core/Memory.h"
+#include "Core/Atomic.h"
+#include "Core/Allocator.h"
+
+namespace rapid
+{
+
+/* wait-free ring buffer for exactly one producer thread and one consumer thread
+ * the head and the tail are free running counters, each side keeps a cached copy of the
+ * other side's counter and only reads the shared one when the cache says full or empty
+ * slots can be written and read in place with reserve/commit and peek/release
+ * param[_Alloc]: allocator of the slots
+ */
+template<typename T, typename _Alloc = ContainerAllocator<T, SPSCQueueStatsTag>>
+class SPSCQueue
+{
+public:
+    using ValueType = T;
+    using Pointer = ValueType*;
+    using Reference = ValueType&;
+    using ConstReference = const ValueType &;
+    using RvalueReference = ValueType&&;
+    using SizeType = size_type;
+    using AllocatorType = _Alloc;
+
+    using value_type = ValueType;// std
+    using allocator_type = AllocatorType;// std
+private:
+    using DataAllocator = RebindAllocator<AllocatorType, NodeBase<ValueType>>;
+    using DataTraits = std::allocator_traits<DataAllocator>;
+
+    // read-only after construction
+    AllocatorType _M_alloc;
+    NodeBase<ValueType> *_M_data;
+    SizeType _M_mask;
+    // producer side, the next position to write and the last head seen
+    alignas(CacheLineSize) Atomic<SizeType> _M_tail;
+    SizeType _M_head_cache = 0;
+    // consumer side, the next position to read and the last tail seen
+    alignas(CacheLineSize) Atomic<SizeType> _M_head;
+    SizeType _M_tail_cache = 0;
+    char _M_padding[CacheLineSize - sizeof(Atomic<SizeType>) - sizeof(SizeType)];
+
+    static SizeType _SF_round_capacity(SizeType capacity)
+    {
+        SizeType result = 2;
+        while(result < capacity)
+        { result <<= 1; }
+        return result;
+    }
+
+    // free slots seen by the producer, the head is read again only if there are less than [n]
+    SizeType _F_free(SizeType tail, SizeType n)
+    {
+        SizeType free = capacity() - (tail - _M_head_cache);
+        if(free < n)
+        {
+            _M_head_cache = _M_head.load(MemoryOrder::Acquire);
+            free = capacity() - (tail - _M_head_cache);
+        }
+        return free;
+    }
+    // elements seen by the consumer, the tail is read again only if there are less than [n]
+    SizeType _F_ready(SizeType head, SizeType n)
+    {
+        SizeType ready = _M_tail_cache - head;
+        if(ready < n)
+        {
+            _M_tail_cache = _M_tail.load(MemoryOrder::Acquire);
+            ready = _M_tail_cache - head;
+        }
+        return ready;
+    }
+    // contiguous slots from [pos], not more than [n]
+    SizeType _F_contiguous(SizeType pos, SizeType n) const
+    {
+        SizeType to_end = capacity() - (pos & _M_mask);
+        return n < to_end ? n : to_end;
+    }
+public:
+    // param[capacity]: rounded up to a power of 2, 2 at least
+    explicit SPSCQueue(SizeType capacity, const AllocatorType &alloc = AllocatorType())
+        : _M_alloc(alloc), _M_data(nullptr), _M_mask(_SF_round_capacity(capacity) - 1)
+    {
+        DataAllocator a(_M_alloc);
+        _M_data = DataTraits::allocate(a, _M_mask + 1);
+    }
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue& operator=(const SPSCQueue &) = delete;
+    // neither thread may use the queue any more
+    ~SPSCQueue()
+    {
+        SizeType head = _M_head.load(MemoryOrder::Relaxed), tail = _M_tail.load(MemoryOrder::Relaxed);
+        for(; head != tail; head++)
+        { _M_data[head & _M_mask].destruct(); }
+        DataAllocator a(_M_alloc);
+        DataTraits::deallocate(a, _M_data, _M_mask + 1);
+    }
+
+    //-----------------------producer-----------------------//
+
+    // return: false if the queue is full
+    bool try_push(ConstReference arg)
+    { return try_emplace(arg); }
+    bool try_push(RvalueReference arg)
+    {
+        SizeType tail = _M_tail.load(MemoryOrder::Relaxed);
+        if(_F_free(tail, 1) == 0) return false;
+        ::new(_M_data[tail & _M_mask].address()) ValueType(rapid::move(arg));
+        _M_tail.store(tail + 1, MemoryOrder::Release);
+        return true;
+    }
+    template<typename ... Args>
+    bool try_emplace(const Args & ... args)
+    {
+        SizeType tail = _M_tail.load(MemoryOrder::Relaxed);
+        if(_F_free(tail, 1) == 0) return false;
+        _M_data[tail & _M_mask].construct(args...);
+        _M_tail.store(tail + 1, MemoryOrder::Release);
+        return true;
+    }
+
+    /* reserve up to [n] contiguous free slots to be written in place
+     * param[count]: set to the number reserved, less than [n] if the queue is nearly full
+     *               or the ring wraps around, then reserve again after commit
+     * return: the first slot, raw memory which must be constructed before commit
+     *         (trivially constructible elements can simply be written)
+     */
+    Pointer reserve(SizeType n, SizeType &count)
+    {
+        SizeType tail = _M_tail.load(MemoryOrder::Relaxed);
+        SizeType free = _F_free(tail, n);
+        count = _F_contiguous(tail, n < free ? n : free);
+        return _M_data[tail & _M_mask].address();
+    }
+    // publish the first [n] slots reserved to the consumer
+    void commit(SizeType n)
+    { _M_tail.store(_M_tail.load(MemoryOrder::Relaxed) + n, MemoryOrder::Release); }
+
+    //-----------------------consumer-----------------------//
+
+    /* param[out]: assigned by the element popped
+     * return: false if the queue is empty
+     */
+    bool try_pop(Reference out)
+    {
+        SizeType head = _M_head.load(MemoryOrder::Relaxed);
+        if(_F_ready(head, 1) == 0) return false;
+        NodeBase<ValueType> &node = _M_data[head & _M_mask];
+        out = rapid::move(node.ref_content());
+        node.destruct();
+        _M_head.store(head + 1, MemoryOrder::Release);
+        return true;
+    }
+
+    /* look at up to [n] contiguous elements in place
+     * param[count]: set to the number of elements, less than [n] if the queue has less
+     *               or the ring wraps around
+     * return: the first element
+     */
+    Pointer peek(SizeType n, SizeType &count)
+    {
+        SizeType head = _M_head.load(MemoryOrder::Relaxed);
+        SizeType ready = _F_ready(head, n);
+        count = _F_contiguous(head, n < ready ? n : ready);
+        return _M_data[head & _M_mask].address();
+    }
+    // destroy the first [n] elements peeked and give their slots back to the producer
+    void release(SizeType n)
+    {
+        SizeType head = _M_head.load(MemoryOrder::Relaxed);
+        for(SizeType i = 0; i < n; i++)
+        { _M_data[(head + i) & _M_mask].destruct(); }
+        _M_head.store(head + n, MemoryOrder::Release);
+    }
+
+    //-----------------------both-----------------------//
+
+    SizeType capacity() const
+    { return _M_mask + 1; }
+    // exact only on a side which is not racing with the other
+    SizeType size() const
+    {
+        // the head never passes a tail read after it
+        SizeType head = _M_head.load(MemoryOrder::Acquire);
+        return _M_tail.load(MemoryOrder::Acquire) - head;
+    }
+    bool empty() const
+    { return size() == 0; }
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
+};
+
+};
+
+#endif // SPSCQUEUE_H
@@ -17,6 +17,9 @@ public:
 
 private:
     using TreeType = _TreeType;
+public:
+    using AllocatorType = typename TreeType::AllocatorType;
+private:
 
     using FormerIteratorImpl = typename TreeType::fiterator;
     using ConstFormerIteratorImpl = typename TreeType::const_fiterator;
@@ -49,7 +52,7 @@ public:
         iterator(const iterator &it)
             : _M_it(it._M_it) { }
         iterator(iterator &&it)
-            : _M_it(forward<iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<iterator>(it)._M_it) { }
 
         iterator operator++()
         {
@@ -97,7 +100,7 @@ public:
         const_iterator(const const_iterator &it)
             : _M_it(it._M_it) { }
         const_iterator(const_iterator &&it)
-            : _M_it(forward<const_iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_iterator>(it)._M_it) { }
 
         const_iterator operator++()
         {
@@ -145,7 +148,7 @@ public:
         reverse_iterator(const reverse_iterator &it)
             : _M_it(it._M_it) { }
         reverse_iterator(reverse_iterator &&it)
-            : _M_it(forward<reverse_iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<reverse_iterator>(it)._M_it) { }
 
         reverse_iterator operator++()
         {
@@ -193,7 +196,7 @@ public:
         const_reverse_iterator(const const_reverse_iterator &it)
             : _M_it(it._M_it) { }
         const_reverse_iterator(const_reverse_iterator &&it)
-            : _M_it(forward<const_reverse_iterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_reverse_iterator>(it)._M_it) { }
 
         const_reverse_iterator operator++()
         {
@@ -242,7 +245,7 @@ public:
         fiterator(const fiterator &it)
             : _M_it(it._M_it) { }
         fiterator(fiterator &&it)
-            : _M_it(forward<fiterator>(it)._M_it) { }
+            : _M_it(rapid::forward<fiterator>(it)._M_it) { }
 
         fiterator operator++()
         {
@@ -290,7 +293,7 @@ public:
         aiterator(const aiterator &it)
             : _M_it(it._M_it) { }
         aiterator(aiterator &&it)
-            : _M_it(forward<aiterator>(it)._M_it) { }
+            : _M_it(rapid::forward<aiterator>(it)._M_it) { }
 
         aiterator operator++()
         {
@@ -338,7 +341,7 @@ public:
         const_aiterator(const const_aiterator &it)
             : _M_it(it._M_it) { }
         const_aiterator(const_aiterator &&it)
-            : _M_it(forward<const_aiterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_aiterator>(it)._M_it) { }
 
         const_aiterator operator++()
         {
@@ -386,7 +389,7 @@ public:
         const_fiterator(const const_fiterator &it)
             : _M_it(it._M_it) { }
         const_fiterator(const_fiterator &&it)
-            : _M_it(forward<const_fiterator>(it)._M_it) { }
+            : _M_it(rapid::forward<const_fiterator>(it)._M_it) { }
 
         const_fiterator operator++()
         {
@@ -427,18 +430,21 @@ private:
 
 public:
     SetBase() { }
+    explicit SetBase(const AllocatorType &alloc) : _M_tree(alloc) { }
     SetBase(const SetBase &m) : _M_tree(m._M_tree) { }
-    SetBase(SetBase &&m) : _M_tree(forward<SetBase>(m)._M_tree) { }
+    SetBase(SetBase &&m) : _M_tree(rapid::forward<SetBase>(m)._M_tree) { }
 
     bool empty() const
     { return _M_tree.empty(); }
     SizeType size() const
     { return _M_tree.size(); }
+    AllocatorType get_allocator() const
+    { return _M_tree.get_allocator(); }
 
     iterator insert(const ValueType &data)
     { return _M_tree.insert(data); }
     iterator insert(ValueType &&data)
-    { return _M_tree.insert(forward<ValueType>(data)); }
+    { return _M_tree.insert(rapid::forward<ValueType>(data)); }
     iterator insert(std::initializer_list<ValueType> arg)
     { return _M_tree.insert(arg); }
 
@@ -448,7 +454,7 @@ public:
     iterator find(const ValueType &key) const
     { return iterator(_M_tree.find(key)); }
     iterator find(ValueType &&key) const
-    { return iterator(_M_tree.find(forward<ValueType>(key))); }
+    { return iterator(_M_tree.find(rapid::forward<ValueType>(key))); }
 
     iterator begin()
     { return iterator(_M_tree.begin()); }
@@ -508,12 +514,14 @@ public:
 
 
 template<typename _Value,
-         typename _Compare = Compare<_Value>>
-using Set = SetBase<_Value, RedBlackTree<_Value, _Compare>>;
+         typename _Compare = Compare<_Value>,
+         typename _Alloc = NodeAllocator<_Value, SetStatsTag>>
+using Set = SetBase<_Value, RedBlackTree<_Value, _Compare, _Alloc>>;
 
 template<typename _Value,
-         typename _Compare = Compare<_Value>>
-using AVLSet = SetBase<_Value, AVLTree<_Value, _Compare>>;
+         typename _Compare = Compare<_Value>,
+         typename _Alloc = NodeAllocator<_Value, AVLSetStatsTag>>
+using AVLSet = SetBase<_Value, AVLTree<_Value, _Compare, 2, _Alloc>>;
 
 }
 
@@ -0,0 +1,128 @@
+#ifndef SHARDEDCOUNTER_H
+#define SHARDEDCOUNTER_H
+
+#include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include "Core/Atomic.h"
+#include <new> // operator new
+#include <thread> // std::thread::hardware_concurrency
+
+namespace rapid
+{
+
+// small index of this thread, 0 for the first thread asking, 1 for the next and so on
+inline size_type this_thread_index()
+{
+    static Atomic<size_type> next(0);
+    static thread_local size_type index = next.fetch_add(1, MemoryOrder::Relaxed);
+    return index;
+}
+
+/* counter written by many threads and read rarely
+ * every thread adds to a slot of its own on its own cache line, so increments do not
+ * bounce a shared line between cores, a read sums all slots
+ * threads share a slot only when there are more threads than slots, it stays correct
+ * param[T]: integral type
+ */
+template<typename T = long>
+class ShardedCounter
+{
+public:
+    using ValueType = T;
+    using SizeType = size_type;
+private:
+    static_assert(IsIntegral<T>::value, "only support integral type");
+
+    struct alignas(CacheLineSize) Slot
+    {
+        Atomic<ValueType> Value;
+    };
+
+    void *_M_memory;
+    Slot *_M_slots;
+    SizeType _M_mask;
+
+    static SizeType _SF_default_shards()
+    {
+        SizeType threads = std::thread::hardware_concurrency();
+        return threads == 0 ? 1 : threads;
+    }
+    Slot& _F_slot()
+    { return _M_slots[this_thread_index() & _M_mask]; }
+public:
+    // param[shards]: number of slots, rounded up to a power of 2, 0 means one per cpu
+    explicit ShardedCounter(SizeType shards = 0)
+    {
+        if(shards == 0)
+        { shards = _SF_default_shards(); }
+        SizeType n = 1;
+        while(n < shards)
+        { n <<= 1; }
+        // aligned by hand so it does not depend on aligned new of C++17
+        _M_memory = ::operator new(static_cast<std::size_t>(n * sizeof(Slot) + CacheLineSize));
+        unsigned long aligned = (reinterpret_cast<unsigned long>(_M_memory) + CacheLineSize - 1) &
+                                ~static_cast<unsigned long>(CacheLineSize - 1);
+        _M_slots = reinterpret_cast<Slot *>(aligned);
+        for(SizeType i = 0; i < n; ++i)
+        { ::new(_M_slots + i) Slot(); }
+        _M_mask = n - 1;
+    }
+    ShardedCounter(const ShardedCounter &) = delete;
+    ShardedCounter& operator=(const ShardedCounter &) = delete;
+    ~ShardedCounter()
+    { ::operator delete(_M_memory); }
+
+    void add(ValueType value)
+    { _F_slot().Value.fetch_add(value, MemoryOrder::Relaxed); }
+    void sub(ValueType value)
+    { _F_slot().Value.fetch_sub(value, MemoryOrder::Relaxed); }
+    void increment()
+    { add(1); }
+    void decrement()
+    { sub(1); }
+
+    // the sum of all slots, exact only if no thread is adding
+    ValueType load() const
+    {
+        ValueType sum = 0;
+        for(SizeType i = 0; i <= _M_mask; ++i)
+        { sum += _M_slots[i].Value.load(MemoryOrder::Relaxed); }
+        return sum;
+    }
+    // set to 0, additions at the same time may be lost
+    void reset()
+    {
+        for(SizeType i = 0; i <= _M_mask; ++i)
+        { _M_slots[i].Value.store(0, MemoryOrder::Relaxed); }
+    }
+
+    SizeType shard_count() const
+    { return _M_mask + 1; }
+
+    ShardedCounter& operator+=(ValueType value)
+    {
+        add(value);
+        return *this;
+    }
+    ShardedCounter& operator-=(ValueType value)
+    {
+        sub(value);
+        return *this;
+    }
+    ShardedCounter& operator++()
+    {
+        increment();
+        return *this;
+    }
+    ShardedCounter& operator--()
+    {
+        decrement();
+        return *this;
+    }
+    operator ValueType() const
+    { return load(); }
+};
+
+};
+
+#endif // SHARDEDCOUNTER_H
@@ -2,19 +2,22 @@
 #define SINGLELINKEDLIST_H
 
 #include "Core/TLNode.h"
+#include "Core/Allocator.h"
 #include "Core/TypeTraits.h"
 #include "Core/Version.h"
 #include "Core/Compare.h"
+#include "Core/Exception.h"
 
 namespace rapid
 {
 
-template<typename T>
+template<typename T, typename _Alloc = NodeAllocator<T, SingleLinkedListStatsTag>>
 class SingleLinkedList
 {
 public:
     class iterator;
     class const_iterator;
+    using AllocatorType = _Alloc;
 private:
     using ValueType = T;
     using Pointer = ValueType*;
@@ -27,12 +30,9 @@ private:
     {
         NodeBase<ValueType> *Data;
         Node *Next;
-        Node() : Data(new NodeBase<ValueType>()), Next(nullptr) { }
-        template<typename ... Args>
-        Node(Node *n, const Args & ... args)
-            : Data(new NodeBase<ValueType>(args...)), Next(n) { }
+        Node(Node *n, NodeBase<ValueType> *data)
+            : Data(data), Next(n) { }
 
-        ~Node() { delete Data; }
         Reference data() const
         { return Data->ref_content(); }
         Pointer address() const
@@ -44,12 +44,21 @@ private:
             node->Data = temp;
         }
     };
-    Node *_M_head = new Node();
+    AllocatorType _M_alloc;
+    Node *_M_head = _F_construct_head();
     SizeType _M_size = 0;
 
+    // the head node holds no data
+    Node* _F_construct_head()
+    { return allocate_object<Node>(_M_alloc, static_cast<Node *>(nullptr), static_cast<NodeBase<ValueType> *>(nullptr)); }
     template<typename ... Args>
     Node* _F_construct_node(Node *n, const Args & ... args)
-    { return new Node(n, args...); }
+    { return allocate_object<Node>(_M_alloc, n, allocate_data<ValueType>(_M_alloc, args...)); }
+    void _F_release_node(Node *n)
+    {
+        release_data(_M_alloc, n->Data);
+        release_object(_M_alloc, n);
+    }
 
     void _F_add_size(SizeType i)
     { _M_size += i; }
@@ -67,7 +76,7 @@ private:
         if(it._M_current->Next != nullptr)
         {
             Node *temp = it._M_current->Next->Next;
-            delete it._M_current->Next;
+            _F_release_node(it._M_current->Next);
             it._M_current->Next = temp;
         }
         _F_add_size(-1);
@@ -88,7 +97,7 @@ public:
         iterator(Node *c) : _M_current(c) { }
         iterator() : _M_current(nullptr) { }
         iterator(const iterator &it) : _M_current(it._M_current) { }
-        iterator(iterator && it) : _M_current(forward<iterator>(it)._M_current) { }
+        iterator(iterator && it) : _M_current(rapid::forward<iterator>(it)._M_current) { }
 
         iterator operator=(const iterator &arg)
         { return iterator(_M_current = arg._M_current); }
@@ -129,11 +138,11 @@ public:
         const_iterator(const const_iterator &it)
             : _M_current(it._M_current) { }
         const_iterator(const_iterator && it)
-            : _M_current(forward<const_iterator>(it)._M_current) { }
+            : _M_current(rapid::forward<const_iterator>(it)._M_current) { }
         const_iterator(const iterator &it)
             : _M_current(it._M_current) { }
         const_iterator(iterator &&it)
-            : _M_current(forward<iterator>(it)._M_current) { }
+            : _M_current(rapid::forward<iterator>(it)._M_current) { }
 
         const_iterator operator=(const const_iterator &arg)
         { return const_iterator(_M_current = arg._M_current); }
@@ -163,16 +172,22 @@ public:
     };
 
     SingleLinkedList() { }
-    SingleLinkedList(const SingleLinkedList<T> &sll)
+    explicit SingleLinkedList(const AllocatorType &alloc)
+        : _M_alloc(alloc) { }
+    SingleLinkedList(const SingleLinkedList &sll)
+        : _M_alloc(sll._M_alloc)
     { insert_after(before_begin(), sll.begin(), sll.end()); }
     ~SingleLinkedList()
     {
         clear();
-        delete _M_head;
+        release_object(_M_alloc, _M_head);
     }
 
-    void swap(const SingleLinkedList &sll)
+    void swap(SingleLinkedList &sll)
     {
+        AllocatorType temp_alloc = _M_alloc;
+        _M_alloc = sll._M_alloc;
+        sll._M_alloc = temp_alloc;
         Node *temp_node = _M_head;
         SizeType temp_size = _M_size;
         _M_head = sll._M_head;
@@ -186,10 +201,13 @@ public:
     bool empty()
     { return size() == 0; }
 
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
+
     void push_front(ConstReference arg)
     { _F_insert_after(before_begin(), arg); }
     void push_front(RvalueReference arg)
-    { _F_insert_after(before_begin(), forward<ValueType>(arg)); }
+    { _F_insert_after(before_begin(), rapid::forward<ValueType>(arg)); }
 
     void pop_front()
     { _F_erase_after(before_begin()); }
@@ -202,12 +220,12 @@ public:
     iterator insert_after(iterator it, ConstReference arg)
     { return _F_insert_after(it, arg); }
     iterator insert_after(iterator it, RvalueReference arg)
-    { return _F_insert_after(it, forward<ValueType>(arg)); }
+    { return _F_insert_after(it, rapid::forward<ValueType>(arg)); }
 
     iterator insert_after(const_iterator it, ConstReference arg)
     { return _F_insert_after(it._F_const_cast(), arg); }
     iterator insert_after(const_iterator it, RvalueReference arg)
-    { return _F_insert_after(it._F_const_cast(), forward<ValueType>(arg)); }
+    { return _F_insert_after(it._F_const_cast(), rapid::forward<ValueType>(arg)); }
 
     template<typename IteratorType>
     iterator insert_after(const_iterator pos, IteratorType b, IteratorType e);
@@ -235,26 +253,34 @@ public:
     { return const_iterator(); }
 
     Reference front()
-    { return empty() ? NodeBase<ValueType>().ref_content() : *begin(); }
+    {
+        if(empty())
+        { throw IndexOutOfArrayException("exception: front of an empty list !"); }
+        return *begin();
+    }
     Reference front() const
-    { return empty() ? NodeBase<ValueType>().ref_content() : *begin(); }
+    {
+        if(empty())
+        { throw IndexOutOfArrayException("exception: front of an empty list !"); }
+        return *begin();
+    }
 
     iterator find(ConstReference arg)
     { return _F_find(arg); }
     iterator find(RvalueReference arg)
-    { return _F_find(forward<ValueType>(arg)); }
+    { return _F_find(rapid::forward<ValueType>(arg)); }
 
     iterator find(ConstReference arg) const
     { return _F_find(arg); }
     iterator find(RvalueReference arg) const
-    { return _F_find(forward<ValueType>(arg)); }
+    { return _F_find(rapid::forward<ValueType>(arg)); }
 
     template<typename ... Args>
     iterator emplace_front(const Args & ... args)
     { return _F_insert_after(before_begin(), args...); }
     template<typename ... Args>
     iterator emplace_front(Args && ... args)
-    { return _F_insert_after(before_begin(), forward<Args>(args)...); }
+    { return _F_insert_after(before_begin(), rapid::forward<Args>(args)...); }
     template<typename ... Args>
     iterator emplace_after(const_iterator it, const Args & ... args)
     { return _F_insert_after(it._F_const_cast(), args...); }
@@ -263,10 +289,10 @@ public:
     { return _F_insert_after(it, args...); }
     template<typename ... Args>
     iterator emplace_after(const_iterator it, Args && ... args)
-    { return _F_insert_after(it._F_const_cast(), forward<Args>(args)...); }
+    { return _F_insert_after(it._F_const_cast(), rapid::forward<Args>(args)...); }
     template<typename ... Args>
     iterator emplace_after(iterator it, Args && ... args)
-    { return _F_insert_after(it, forward<Args>(args)...); }
+    { return _F_insert_after(it, rapid::forward<Args>(args)...); }
 
     void sort()
     { sort(Compare<ValueType>()); }
@@ -288,21 +314,22 @@ public:
 //-----------------------impl-----------------------//
 //-----------------------impl-----------------------//
 
-template<typename T>
-void SingleLinkedList<T>::clear()
+template<typename T, typename _Alloc>
+void SingleLinkedList<T, _Alloc>::clear()
 {
     Node *n = _M_head->Next;
     while(n != nullptr)
     {
         Node *temp = n;
         n = n->Next;
-        delete temp;
+        _F_release_node(temp);
     }
+    _M_head->Next = nullptr;
     _M_size = 0;
 }
 
-template<typename T>
-void SingleLinkedList<T>::reverse()
+template<typename T, typename _Alloc>
+void SingleLinkedList<T, _Alloc>::reverse()
 {
 //    Stack<Node *> s;
 //    for(Node *n = _M_head->Next; n != nullptr; n = n->Next)
@@ -321,9 +348,9 @@ void SingleLinkedList<T>::reverse()
 //    }
 }
 
-template<typename T>
-typename SingleLinkedList<T>::iterator
-    SingleLinkedList<T>::_F_find(ConstReference arg) const
+template<typename T, typename _Alloc>
+typename SingleLinkedList<T, _Alloc>::iterator
+    SingleLinkedList<T, _Alloc>::_F_find(ConstReference arg) const
 {
    for(const_iterator it = begin(); it != end(); ++it)
    {
@@ -333,10 +360,10 @@ typename SingleLinkedList<T>::iterator
    return cend()._F_const_cast();
 }
 
-template<typename T>
+template<typename T, typename _Alloc>
 template<typename IteratorType>
-typename SingleLinkedList<T>::iterator
-    SingleLinkedList<T>::insert_after(const_iterator pos, IteratorType b, IteratorType e)
+typename SingleLinkedList<T, _Alloc>::iterator
+    SingleLinkedList<T, _Alloc>::insert_after(const_iterator pos, IteratorType b, IteratorType e)
 {
     iterator r;
     while(b != e)
@@ -347,9 +374,9 @@ typename SingleLinkedList<T>::iterator
     return r;
 }
 
-template<typename T>
+template<typename T, typename _Alloc>
 template<typename _Compare>
-void SingleLinkedList<T>::sort(_Compare c)
+void SingleLinkedList<T, _Alloc>::sort(_Compare c)
 {
     Node *last_pos = nullptr;
     for(Node *v = _M_head->Next; v != nullptr; v = v->Next)
@@ -372,8 +399,8 @@ void SingleLinkedList<T>::sort(_Compare c)
     }
 }
 
-template<typename T>
-using Slist = SingleLinkedList<T>;
+template<typename T, typename _Alloc = NodeAllocator<T, SingleLinkedListStatsTag>>
+using Slist = SingleLinkedList<T, _Alloc>;
 
 };
 #endif // SINGLELINKEDLIST_H
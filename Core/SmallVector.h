@@ -0,0 +1,434 @@
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include "Core/TypeTraits.h"
+#include "Core/Version.h"
+#include "Core/Exception.h"
+#include "Core/Memory.h"
+#include "Core/Allocator.h"
+#include <initializer_list>
+#include <iterator> // std::reverse_iterator
+#include <type_traits> // std::integral_constant
+
+namespace rapid
+{
+
+/* Vector which keeps its first [N] elements inside the object, the heap is only used
+ * once it grows past [N], and it moves back inside when it shrinks to fit [N]
+ * the iterators are pointers, they are invalidated when the elements move
+ * param[N]: inline capacity
+ */
+template<typename T, size_type N = 16, typename _Alloc = ContainerAllocator<T, SmallVectorStatsTag>>
+class SmallVector
+{
+public:
+    using ValueType = T;
+    using Pointer = ValueType*;
+    using ConstPointer = const ValueType*;
+    using Reference = ValueType&;
+    using ConstReference = const ValueType &;
+    using RvalueReference = ValueType&&;
+    using SizeType = size_type;
+    using DifferenceType = long long;
+    using AllocatorType = _Alloc;
+
+    using iterator = Pointer;
+    using const_iterator = ConstPointer;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    using value_type = ValueType;// std
+    using allocator_type = AllocatorType;// std
+
+    static constexpr SizeType InlineCapacity = N;
+private:
+    static_assert(N > 0, "the inline capacity can not be 0");
+
+    using DataAllocator = RebindAllocator<AllocatorType, ValueType>;
+    using DataTraits = std::allocator_traits<DataAllocator>;
+
+    AllocatorType _M_alloc;
+    Pointer _M_data;
+    SizeType _M_size = 0;
+    SizeType _M_capacity = N;
+    SizeType _M_growth = 0;
+    // raw bytes rather than NodeBase, which would clear them on every construction
+    alignas(ValueType) unsigned char _M_inline[N * sizeof(ValueType)];
+
+    Pointer _F_inline()
+    { return reinterpret_cast<Pointer>(_M_inline); }
+    void _F_release()
+    {
+        if(is_inline()) return;
+        DataAllocator a(_M_alloc);
+        DataTraits::deallocate(a, _M_data, _M_capacity);
+    }
+    // move the elements to a buffer of [s] elements, the inline one if [s] is not larger than N
+    void _F_reallocate(SizeType s)
+    {
+        Pointer p = _F_inline();
+        if(s <= N)
+        { s = N; }
+        else
+        {
+            DataAllocator a(_M_alloc);
+            p = DataTraits::allocate(a, s);
+        }
+        if(p == _M_data) return;
+        rapid::relocate(p, _M_data, _M_size);
+        _F_release();
+        _M_data = p;
+        _M_capacity = s;
+    }
+    // grow the capacity to hold at least [required] elements, doubling it unless set_growth() is used
+    void _F_growth(SizeType required)
+    {
+        SizeType s = _M_growth < 1 ? capacity() * 2 : capacity() + _M_growth;
+        _F_reallocate(s < required ? required : s);
+    }
+    SizeType _F_index(const_iterator it) const
+    { return static_cast<SizeType>(it - _M_data); }
+    template<typename ... Args>
+    iterator _F_insert(const_iterator it, Args && ... args);
+    // copy construct [n] elements of [first] into the raw memory [dst]
+    template<typename _Iterator>
+    void _F_copy_range(Pointer dst, _Iterator first, SizeType n, std::true_type)
+    { rapid::uninitialized_copy(dst, &*first, n); }
+    template<typename _Iterator>
+    void _F_copy_range(Pointer dst, _Iterator first, SizeType n, std::false_type);
+    SizeType _F_find_index(ConstReference arg, std::true_type) const
+    { return mem_find_element(_M_data, size(), &arg, sizeof(ValueType)); }
+    SizeType _F_find_index(ConstReference arg, std::false_type) const
+    {
+        for(SizeType i = 0; i < size(); i++)
+        {
+            if(_M_data[i] == arg)
+                return i;
+        }
+        return size();
+    }
+    void _F_copy_data(const SmallVector &v)
+    {
+        clear();
+        _M_growth = v._M_growth;
+        reserve(v.size());
+        rapid::uninitialized_copy(_M_data, v._M_data, v.size());
+        _M_size = v.size();
+    }
+    // take the elements of [v], which is left empty
+    void _F_move_data(SmallVector &v)
+    {
+        clear();
+        _M_growth = v._M_growth;
+        if(v.is_inline())
+        {
+            rapid::relocate(_M_data, v._M_data, v.size());
+            _M_size = v.size();
+            v._M_size = 0;
+            return;
+        }
+        _M_data = v._M_data;
+        _M_size = v._M_size;
+        _M_capacity = v._M_capacity;
+        v._M_data = v._F_inline();
+        v._M_size = 0;
+        v._M_capacity = N;
+    }
+public:
+    SmallVector() : _M_data(_F_inline()) { }
+    explicit SmallVector(const AllocatorType &alloc) : _M_alloc(alloc), _M_data(_F_inline()) { }
+    SmallVector(const SmallVector &v) : _M_alloc(v._M_alloc), _M_data(_F_inline())
+    { _F_copy_data(v); }
+    SmallVector(SmallVector &&v) : _M_alloc(v._M_alloc), _M_data(_F_inline())
+    { _F_move_data(v); }
+    SmallVector(std::initializer_list<ValueType> arg) : _M_data(_F_inline())
+    {
+        reserve(arg.size());
+        for(auto it = arg.begin(); it != arg.end(); ++it)
+        { push_back(*it); }
+    }
+    ~SmallVector()
+    { clear(); }
+
+    SmallVector& operator=(const SmallVector &v)
+    {
+        if(this != &v)
+        { _F_copy_data(v); }
+        return *this;
+    }
+    SmallVector& operator=(SmallVector &&v)
+    {
+        if(this != &v)
+        { _F_move_data(v); }
+        return *this;
+    }
+
+    void push_back(ConstReference arg)
+    { _F_insert(end(), arg); }
+    void push_back(RvalueReference arg)
+    { _F_insert(end(), rapid::move(arg)); }
+    void push_front(ConstReference arg)
+    { _F_insert(begin(), arg); }
+    void push_front(RvalueReference arg)
+    { _F_insert(begin(), rapid::move(arg)); }
+
+    void pop_back()
+    { erase(end() - 1); }
+    void pop_front()
+    { erase(begin()); }
+
+    // destroy the elements and go back to the inline storage
+    void clear()
+    {
+        rapid::destroy(_M_data, _M_size);
+        _F_release();
+        _M_data = _F_inline();
+        _M_size = 0;
+        _M_capacity = N;
+    }
+
+    Reference operator[](const SizeType index)
+    { return _M_data[index]; }
+    ConstReference operator[](const SizeType index) const
+    { return _M_data[index]; }
+
+    Pointer data()
+    { return _M_data; }
+    ConstPointer data() const
+    { return _M_data; }
+
+    iterator begin()
+    { return _M_data; }
+    iterator end()
+    { return _M_data + _M_size; }
+    const_iterator begin() const
+    { return _M_data; }
+    const_iterator end() const
+    { return _M_data + _M_size; }
+    const_iterator cbegin() const
+    { return begin(); }
+    const_iterator cend() const
+    { return end(); }
+
+    reverse_iterator rbegin()
+    { return reverse_iterator(end()); }
+    reverse_iterator rend()
+    { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const
+    { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const
+    { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const
+    { return rbegin(); }
+    const_reverse_iterator crend() const
+    { return rend(); }
+
+    Reference back() const
+    { return _M_data[size() - 1]; }
+    Reference front() const
+    { return _M_data[0]; }
+
+    iterator insert(const_iterator it, ConstReference arg)
+    { return _F_insert(it, arg); }
+    iterator insert(const_iterator it, RvalueReference arg)
+    { return _F_insert(it, rapid::move(arg)); }
+
+    // return: the position after the element erased
+    iterator erase(const_iterator it)
+    {
+        SizeType i = _F_index(it);
+        if(i >= size()) return end();
+        rapid::destroy(_M_data + i, 1);
+        rapid::relocate(_M_data + i, _M_data + i + 1, size() - i - 1);
+        --_M_size;
+        return _M_data + i;
+    }
+
+    /* insert the elements of [first, last) before [pos], the tail is moved once
+     * param[first]: forward iterator, not into this SmallVector
+     * return: the position of the first element inserted
+     */
+    template<typename _Iterator>
+    iterator insert(const_iterator pos, _Iterator first, _Iterator last);
+    // add the elements of [first, last) at the end
+    template<typename _Iterator>
+    iterator append(_Iterator first, _Iterator last)
+    { return insert(end(), first, last); }
+    // erase the elements of [first, last), the tail is moved once
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        SizeType i = _F_index(first), j = _F_index(last);
+        if(i >= j) return _M_data + i;
+        rapid::destroy(_M_data + i, j - i);
+        rapid::relocate(_M_data + i, _M_data + j, size() - j);
+        _M_size -= j - i;
+        return _M_data + i;
+    }
+    /* erase every element [pred] returns true for in a single pass
+     * return: the number of elements erased
+     */
+    template<typename _Pred>
+    SizeType erase_if(_Pred pred);
+
+    Reference at(const SizeType index)
+    {
+        if(index >= size())
+        { throw IndexOutOfArrayException("exception: index out of array !"); }
+        return _M_data[index];
+    }
+
+    // the elements added are value initialized
+    void resize(SizeType s)
+    {
+        if(s <= size())
+        {
+            rapid::destroy(_M_data + s, size() - s);
+            _M_size = s;
+            return;
+        }
+        reserve(s);
+        for(; _M_size < s; ++_M_size)
+        { ::new(static_cast<void *>(_M_data + _M_size)) ValueType(); }
+    }
+    // capacity for at least [s] elements, nothing is constructed
+    void reserve(SizeType s)
+    {
+        if(s > capacity())
+        { _F_reallocate(s); }
+    }
+    // give back the heap capacity beyond size(), the elements move inline if they fit
+    void shrink_to_fit()
+    {
+        if(!is_inline() && capacity() > size())
+        { _F_reallocate(size()); }
+    }
+
+    SizeType size() const
+    { return _M_size; }
+    SizeType capacity() const
+    { return _M_capacity; }
+    bool empty() const
+    { return size() == 0; }
+    // whether the elements are inside the object
+    bool is_inline() const
+    { return _M_data == reinterpret_cast<ConstPointer>(_M_inline); }
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
+    void set_growth(SizeType s)
+    { _M_growth = s; }
+
+    iterator find(ConstReference arg) const
+    {
+        // bitwise comparable elements of 1, 2, 4 or 8 bytes are searched by simd
+        using Bitwise = std::integral_constant<bool, IsBitwiseComparable<ValueType>::value &&
+            (sizeof(ValueType) == 1 || sizeof(ValueType) == 2 || sizeof(ValueType) == 4 || sizeof(ValueType) == 8)>;
+        return _M_data + _F_find_index(arg, Bitwise());
+    }
+
+    template<typename ... Args>
+    iterator emplace_front(Args && ... args)
+    { return _F_insert(begin(), rapid::forward<Args>(args)...); }
+    template<typename ... Args>
+    iterator emplace_back(Args && ... args)
+    { return _F_insert(end(), rapid::forward<Args>(args)...); }
+    template<typename ... Args>
+    iterator emplace(const_iterator it, Args && ... args)
+    { return _F_insert(it, rapid::forward<Args>(args)...); }
+};
+
+//-----------------------impl-----------------------//
+template<typename T, size_type N, typename _Alloc>
+template<typename ... Args>
+typename SmallVector<T, N, _Alloc>::iterator SmallVector<T, N, _Alloc>::_F_insert(const_iterator it, Args && ... args)
+{
+    SizeType i = _F_index(it);
+    if(i == size() && size() < capacity())
+    {
+        ::new(static_cast<void *>(_M_data + i)) ValueType(rapid::forward<Args>(args)...);
+        ++_M_size;
+        return _M_data + i;
+    }
+    // the arguments may refer to an element which moves below
+    ValueType value(rapid::forward<Args>(args)...);
+    if(size() >= capacity())
+    { _F_growth(size() + 1); }
+    rapid::relocate(_M_data + i + 1, _M_data + i, size() - i);
+    ::new(static_cast<void *>(_M_data + i)) ValueType(rapid::move(value));
+    ++_M_size;
+    return _M_data + i;
+}
+
+template<typename T, size_type N, typename _Alloc>
+template<typename _Iterator>
+void SmallVector<T, N, _Alloc>::_F_copy_range(Pointer dst, _Iterator first, SizeType n, std::false_type)
+{
+    SizeType i = 0;
+    try
+    {
+        for(; i < n; ++i, ++first)
+        { ::new(static_cast<void *>(dst + i)) ValueType(*first); }
+    }
+    catch(...)
+    {
+        rapid::destroy(dst, i);
+        throw;
+    }
+}
+
+template<typename T, size_type N, typename _Alloc>
+template<typename _Iterator>
+typename SmallVector<T, N, _Alloc>::iterator SmallVector<T, N, _Alloc>::insert(const_iterator pos, _Iterator first, _Iterator last)
+{
+    using Contiguous = std::integral_constant<bool, std::is_convertible<_Iterator, ConstPointer>::value>;
+    SizeType i = _F_index(pos);
+    SizeType n = static_cast<SizeType>(std::distance(first, last));
+    if(n == 0)
+    { return _M_data + i; }
+    if(size() + n > capacity())
+    { _F_growth(size() + n); }
+    rapid::relocate(_M_data + i + n, _M_data + i, size() - i);
+    try
+    { _F_copy_range(_M_data + i, first, n, Contiguous()); }
+    catch(...)
+    {
+        rapid::relocate(_M_data + i, _M_data + i + n, size() - i);
+        throw;
+    }
+    _M_size += n;
+    return _M_data + i;
+}
+
+template<typename T, size_type N, typename _Alloc>
+template<typename _Pred>
+typename SmallVector<T, N, _Alloc>::SizeType SmallVector<T, N, _Alloc>::erase_if(_Pred pred)
+{
+    SizeType n = size(), kept = 0, read = 0;
+    try
+    {
+        while(read < n)
+        {
+            // the elements kept are moved down a run at a time
+            SizeType run = read;
+            while(run < n && !pred(_M_data[run]))
+            { ++run; }
+            rapid::relocate(_M_data + kept, _M_data + read, run - read);
+            kept += run - read;
+            read = run;
+            if(read < n)
+            { rapid::destroy(_M_data + read++, 1); }
+        }
+    }
+    catch(...)
+    {
+        // the elements not visited yet are kept
+        rapid::relocate(_M_data + kept, _M_data + read, n - read);
+        _M_size = kept + n - read;
+        throw;
+    }
+    _M_size = kept;
+    return n - kept;
+}
+
+};
+
+#endif // SMALLVECTOR_H
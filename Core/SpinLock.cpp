@@ -0,0 +1,75 @@
+#include "SpinLock.h"
+
+void rapid::SpinLock::_F_lock_slow()
+{
+    Backoff backoff;
+    do
+    {
+        unsigned int unlocked = 0;
+        if(_M_state.load(MemoryOrder::Relaxed) == 0 &&
+           _M_state.compare_exchange_weak(unlocked, 1, MemoryOrder::Acquire, MemoryOrder::Relaxed))
+        { return; }
+    }
+    while(backoff.spin());
+    // mark the lock as having sleepers, the holder wakes one when it unlocks
+    while(_M_state.exchange(2, MemoryOrder::Acquire) != 0)
+    { futex_wait(_M_state, 2); }
+}
+
+void rapid::TicketLock::_F_wait(unsigned int ticket)
+{
+    Backoff backoff;
+    unsigned int serving;
+    while(((serving = _M_serving.load(MemoryOrder::Acquire)) & ~Sleeper) != ticket)
+    {
+        if(backoff.yielding())
+        {
+            futex_sleep(_M_serving, serving, Sleeper);
+            continue;
+        }
+        // the waiters behind wait longer before they look again
+        for(unsigned int i = (ticket - (serving & ~Sleeper)) / Step - 1; i > 0; --i)
+        { cpu_relax(); }
+        backoff.spin();
+    }
+}
+
+void rapid::RWSpinLock::_F_lock_slow()
+{
+    Backoff backoff;
+    while(true)
+    {
+        unsigned int state = _M_state.load(MemoryOrder::Relaxed);
+        if((state & ~(WriterWaiting | Sleeper)) == 0)
+        {
+            // taking the lock clears WriterWaiting, the other waiting writers set it again
+            if(_M_state.compare_exchange_weak(state, Writer | (state & Sleeper), MemoryOrder::Acquire, MemoryOrder::Relaxed))
+            { return; }
+            continue;
+        }
+        if((state & WriterWaiting) == 0)
+        {
+            _M_state.fetch_or(WriterWaiting, MemoryOrder::Relaxed);
+            continue;
+        }
+        if(!backoff.spin())
+        { futex_sleep(_M_state, state, Sleeper); }
+    }
+}
+
+void rapid::RWSpinLock::_F_lock_shared_slow()
+{
+    Backoff backoff;
+    while(true)
+    {
+        unsigned int state = _M_state.load(MemoryOrder::Relaxed);
+        if((state & (Writer | WriterWaiting)) == 0)
+        {
+            if(_M_state.compare_exchange_weak(state, state + 1, MemoryOrder::Acquire, MemoryOrder::Relaxed))
+            { return; }
+            continue;
+        }
+        if(!backoff.spin())
+        { futex_sleep(_M_state, state, Sleeper); }
+    }
+}
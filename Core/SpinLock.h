@@ -0,0 +1,196 @@
+#ifndef SPINLOCK_H
+#define SPINLOCK_H
+
+#include "Core/Version.h"
+#include "Core/Atomic.h"
+#include "Core/Futex.h"
+
+namespace rapid
+{
+
+/* locks for short critical sections
+ * a waiter spins with exponential backoff first, and sleeps on a futex once its spin
+ * budget is used up, so a preempted holder does not burn the cpu of the waiters
+ * the uncontended paths are a single atomic instruction and stay inline
+ */
+
+/* test and test-and-set lock, not fair
+ * a waiter only reads the lock word while it is held, so the cache line is not bounced
+ */
+class SpinLock
+{
+private:
+    // 0 unlocked, 1 locked, 2 locked and a thread may sleep on it
+    Atomic<unsigned int> _M_state;
+
+    void _F_lock_slow();
+public:
+    constexpr SpinLock() : _M_state(0) { }
+    SpinLock(const SpinLock &) = delete;
+    SpinLock& operator=(const SpinLock &) = delete;
+
+    void lock()
+    {
+        unsigned int unlocked = 0;
+        if(!_M_state.compare_exchange_strong(unlocked, 1, MemoryOrder::Acquire, MemoryOrder::Relaxed))
+        { _F_lock_slow(); }
+    }
+    bool try_lock()
+    {
+        unsigned int unlocked = 0;
+        return _M_state.load(MemoryOrder::Relaxed) == 0 &&
+               _M_state.compare_exchange_strong(unlocked, 1, MemoryOrder::Acquire, MemoryOrder::Relaxed);
+    }
+    void unlock()
+    {
+        if(_M_state.exchange(0, MemoryOrder::Release) == 2)
+        { futex_wake(_M_state, 1); }
+    }
+    bool locked() const
+    { return _M_state.load(MemoryOrder::Relaxed) != 0; }
+};
+
+/* ticket lock, threads get the lock in the order they asked for it
+ * a waiter backs off in proportion to its distance from the ticket being served
+ */
+class TicketLock
+{
+private:
+    // tickets step by 2, the lowest bit of _M_serving is set when a thread may sleep on it
+    static constexpr unsigned int Sleeper = 1;
+    static constexpr unsigned int Step = 2;
+
+    Atomic<unsigned int> _M_next;
+    Atomic<unsigned int> _M_serving;
+
+    void _F_wait(unsigned int ticket);
+public:
+    constexpr TicketLock() : _M_next(0), _M_serving(0) { }
+    TicketLock(const TicketLock &) = delete;
+    TicketLock& operator=(const TicketLock &) = delete;
+
+    void lock()
+    {
+        unsigned int ticket = _M_next.fetch_add(Step, MemoryOrder::Relaxed);
+        if((_M_serving.load(MemoryOrder::Acquire) & ~Sleeper) != ticket)
+        { _F_wait(ticket); }
+    }
+    bool try_lock()
+    {
+        unsigned int serving = _M_serving.load(MemoryOrder::Acquire) & ~Sleeper;
+        unsigned int ticket = serving;
+        return _M_next.compare_exchange_strong(ticket, serving + Step, MemoryOrder::Acquire, MemoryOrder::Relaxed);
+    }
+    void unlock()
+    {
+        // the lock is not touched after the ticket moves on, the next owner may destroy it
+        unsigned int serving = _M_serving.load(MemoryOrder::Relaxed);
+        while(!_M_serving.compare_exchange_weak(serving, (serving & ~Sleeper) + Step,
+                                                MemoryOrder::Release, MemoryOrder::Relaxed))
+        { }
+        if((serving & Sleeper) != 0)
+        { futex_wake_all(_M_serving); }
+    }
+    bool locked() const
+    { return _M_next.load(MemoryOrder::Relaxed) != (_M_serving.load(MemoryOrder::Relaxed) & ~Sleeper); }
+};
+
+/* reader-writer lock for read-heavy data, any number of readers or one writer
+ * a waiting writer stops new readers from coming in, so writers are not starved
+ */
+class RWSpinLock
+{
+private:
+    static constexpr unsigned int Writer = 1u << 31;
+    static constexpr unsigned int WriterWaiting = 1u << 30;
+    // a thread may sleep on the lock
+    static constexpr unsigned int Sleeper = 1u << 29;
+    static constexpr unsigned int ReaderMask = Sleeper - 1;
+
+    // the number of readers with the flags above
+    Atomic<unsigned int> _M_state;
+
+    void _F_lock_slow();
+    void _F_lock_shared_slow();
+public:
+    constexpr RWSpinLock() : _M_state(0) { }
+    RWSpinLock(const RWSpinLock &) = delete;
+    RWSpinLock& operator=(const RWSpinLock &) = delete;
+
+    void lock()
+    {
+        unsigned int unlocked = 0;
+        if(!_M_state.compare_exchange_strong(unlocked, Writer, MemoryOrder::Acquire, MemoryOrder::Relaxed))
+        { _F_lock_slow(); }
+    }
+    bool try_lock()
+    {
+        unsigned int state = _M_state.load(MemoryOrder::Relaxed);
+        return (state & ~(WriterWaiting | Sleeper)) == 0 &&
+               _M_state.compare_exchange_strong(state, Writer | (state & Sleeper), MemoryOrder::Acquire, MemoryOrder::Relaxed);
+    }
+    void unlock()
+    {
+        if((_M_state.fetch_and(~(Writer | Sleeper), MemoryOrder::Release) & Sleeper) != 0)
+        { futex_wake_all(_M_state); }
+    }
+
+    void lock_shared()
+    {
+        unsigned int state = _M_state.load(MemoryOrder::Relaxed);
+        if((state & (Writer | WriterWaiting)) != 0 ||
+           !_M_state.compare_exchange_weak(state, state + 1, MemoryOrder::Acquire, MemoryOrder::Relaxed))
+        { _F_lock_shared_slow(); }
+    }
+    bool try_lock_shared()
+    {
+        unsigned int state = _M_state.load(MemoryOrder::Relaxed);
+        return (state & (Writer | WriterWaiting)) == 0 &&
+               _M_state.compare_exchange_strong(state, state + 1, MemoryOrder::Acquire, MemoryOrder::Relaxed);
+    }
+    void unlock_shared()
+    {
+        // only a writer waits for the readers, the last one leaving wakes the sleepers
+        unsigned int state = _M_state.load(MemoryOrder::Relaxed);
+        unsigned int next;
+        do
+        { next = (state & ReaderMask) == 1 ? (state - 1) & ~Sleeper : state - 1; }
+        while(!_M_state.compare_exchange_weak(state, next, MemoryOrder::Release, MemoryOrder::Relaxed));
+        if((state & ReaderMask) == 1 && (state & Sleeper) != 0)
+        { futex_wake_all(_M_state); }
+    }
+};
+
+// hold [_Lock] in a scope
+template<typename _Lock>
+class LockGuard
+{
+private:
+    _Lock &_M_lock;
+public:
+    explicit LockGuard(_Lock &lock) : _M_lock(lock)
+    { _M_lock.lock(); }
+    ~LockGuard()
+    { _M_lock.unlock(); }
+    LockGuard(const LockGuard &) = delete;
+    LockGuard& operator=(const LockGuard &) = delete;
+};
+
+// hold [_Lock] shared in a scope
+template<typename _Lock>
+class SharedLockGuard
+{
+private:
+    _Lock &_M_lock;
+public:
+    explicit SharedLockGuard(_Lock &lock) : _M_lock(lock)
+    { _M_lock.lock_shared(); }
+    ~SharedLockGuard()
+    { _M_lock.unlock_shared(); }
+    SharedLockGuard(const SharedLockGuard &) = delete;
+    SharedLockGuard& operator=(const SharedLockGuard &) = delete;
+};
+
+};
+
+#endif // SPINLOCK_H
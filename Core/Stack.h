@@ -2,17 +2,19 @@
 #define STACK_H
 
 #include "Core/TLNode.h"
+#include "Core/Allocator.h"
 #include "Core/TypeTraits.h"
 #include "Core/Version.h"
 #include <initializer_list>
 
 namespace rapid
 {
-template<typename T>
+template<typename T, typename _Alloc = NodeAllocator<T, StackStatsTag>>
 class Stack
 {
 public:
     using ValueType = T;
+    using AllocatorType = _Alloc;
     using Pointer = ValueType*;
     using Reference = ValueType&;
     using ConstReference = const ValueType &;
@@ -23,11 +25,11 @@ private:
     {
         Node *Next;
         NodeBase<ValueType> *Data;
-        Node(ConstReference arg, Node *n = nullptr)
-            : Next(n), Data(new NodeBase<ValueType>(arg)) {}
-        ~Node() { delete Data; }
+        Node(NodeBase<ValueType> *data, Node *n = nullptr)
+            : Next(n), Data(data) {}
     };
 
+    AllocatorType _M_alloc;
     SizeType _M_size = 0;
     Node *_M_top = nullptr;
 
@@ -36,8 +38,11 @@ private:
         _M_top = _F_construct_node(arg, _M_top);
         _F_add_size(1);
     }
-    void _F_exchange(const Stack &s)
+    void _F_exchange(Stack &s)
     {
+        AllocatorType a = _M_alloc;
+        _M_alloc = s._M_alloc;
+        s._M_alloc = a;
         Node *temp = _M_top;
         SizeType st = _M_size;
         _M_top = s._M_top;
@@ -46,13 +51,21 @@ private:
         s._M_size = st;
     }
     Node* _F_construct_node(ConstReference arg, Node *next = nullptr)
-    { return new Node(arg, next); }
+    { return allocate_object<Node>(_M_alloc, allocate_data<ValueType>(_M_alloc, arg), next); }
+    void _F_release_node(Node *n)
+    {
+        release_data(_M_alloc, n->Data);
+        release_object(_M_alloc, n);
+    }
 
     void _F_add_size(SizeType arg)
     { _M_size += arg; }
 public:
     Stack() { }
+    explicit Stack(const AllocatorType &alloc)
+        : _M_alloc(alloc) { }
     Stack(const Stack &arg)
+        : _M_alloc(arg._M_alloc)
     {
         Node *n = arg._M_top;
         while(n != nullptr)
@@ -67,7 +80,8 @@ public:
         { push(*it); }
     }
     Stack(Stack &&arg)
-    { _F_exchange(forward<Stack>(arg)); }
+        : _M_alloc(arg._M_alloc)
+    { _F_exchange(arg); }
 
     ~Stack()
     { clear(); }
@@ -78,11 +92,14 @@ public:
     bool empty() const
     { return size() == 0; }
 
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
+
     void push(ConstReference arg)
     { _F_push(arg); }
 
     void push(RvalueReference arg)
-    { _F_push(forward<ValueType>(arg)); }
+    { _F_push(rapid::forward<ValueType>(arg)); }
 
     ValueType top() const
     { return _M_top != nullptr ? _M_top->Data->content() : NodeBase<ValueType>().content(); }
@@ -92,7 +109,7 @@ public:
         if(empty()) return;
         Node *n = _M_top;
         _M_top = _M_top->Next;
-        delete n;
+        _F_release_node(n);
         _F_add_size(-1);
     }
     void clear()
@@ -101,10 +118,10 @@ public:
         { pop(); }
     }
 
-    void swap(const Stack &s)
+    void swap(Stack &s)
     { _F_exchange(s); }
     void swap(Stack &&s)
-    { _F_exchange(forward<Stack>(s)); }
+    { _F_exchange(s); }
 };
 
 };
@@ -0,0 +1,107 @@
+#include "Sync.h"
+
+/* spin until [ready] returns true or the short spin budget is used up
+ * return: the last result of [ready]
+ */
+template<typename _Ready>
+static inline bool __spin_until(_Ready ready)
+{
+    for(rapid::Backoff backoff; !backoff.yielding(); backoff.spin())
+    {
+        if(ready()) return true;
+    }
+    return ready();
+}
+
+//-----------------------Mutex-----------------------//
+
+void rapid::Mutex::_F_lock_slow()
+{
+    if(__spin_until([this]()
+       {
+           unsigned int unlocked = 0;
+           return _M_state.load(MemoryOrder::Relaxed) == 0 &&
+                  _M_state.compare_exchange_weak(unlocked, 1, MemoryOrder::Acquire, MemoryOrder::Relaxed);
+       }))
+    { return; }
+    while(_M_state.exchange(2, MemoryOrder::Acquire) != 0)
+    { futex_wait(_M_state, 2); }
+}
+
+//-----------------------Condition-----------------------//
+
+void rapid::Condition::wait(Mutex &mutex)
+{
+    // a notify after this changes the sequence, the sleep below returns at once then
+    unsigned int sequence = _M_sequence.fetch_or(Sleeper, MemoryOrder::Relaxed) | Sleeper;
+    mutex.unlock();
+    futex_wait(_M_sequence, sequence);
+    // other waiters may have been woken with this one, mark the mutex contended
+    while(mutex._M_state.exchange(2, MemoryOrder::Acquire) != 0)
+    { futex_wait(mutex._M_state, 2); }
+}
+
+void rapid::Condition::notify_all()
+{
+    unsigned int sequence = _M_sequence.load(MemoryOrder::Relaxed);
+    while(!_M_sequence.compare_exchange_weak(sequence, (sequence & ~Sleeper) + Step,
+                                             MemoryOrder::Release, MemoryOrder::Relaxed))
+    { }
+    if((sequence & Sleeper) != 0)
+    { futex_wake_all(_M_sequence); }
+}
+
+//-----------------------Semaphore-----------------------//
+
+void rapid::Semaphore::_F_acquire_slow()
+{
+    __spin_until([this]() { return count() != 0; });
+    while(!try_acquire())
+    {
+        unsigned int count = _M_count.load(MemoryOrder::Relaxed);
+        if((count & ~Sleeper) == 0)
+        { futex_sleep(_M_count, count, Sleeper); }
+    }
+}
+
+void rapid::Semaphore::release(unsigned int n)
+{
+    // all sleepers are woken, the ones left without a permit set the bit again
+    unsigned int count = _M_count.load(MemoryOrder::Relaxed);
+    while(!_M_count.compare_exchange_weak(count, (count & ~Sleeper) + n, MemoryOrder::Release, MemoryOrder::Relaxed))
+    { }
+    if((count & Sleeper) != 0)
+    { futex_wake_all(_M_count); }
+}
+
+//-----------------------Latch-----------------------//
+
+void rapid::Latch::wait()
+{
+    if(__spin_until([this]() { return try_wait(); }))
+    { return; }
+    unsigned int count;
+    while(((count = _M_count.load(MemoryOrder::Acquire)) & ~Sleeper) != 0)
+    { futex_sleep(_M_count, count, Sleeper); }
+}
+
+//-----------------------Barrier-----------------------//
+
+bool rapid::Barrier::arrive_and_wait()
+{
+    unsigned int phase = _M_phase.load(MemoryOrder::Acquire) & ~Sleeper;
+    if(_M_arrived.fetch_add(1, MemoryOrder::AcqRel) + 1 == _M_count)
+    {
+        // the threads of the next phase arrive after they see the new phase
+        _M_arrived.store(0, MemoryOrder::Relaxed);
+        if((_M_phase.exchange(phase + Step, MemoryOrder::Release) & Sleeper) != 0)
+        { futex_wake_all(_M_phase); }
+        return true;
+    }
+    if(__spin_until([this, phase]() { return (_M_phase.load(MemoryOrder::Acquire) & ~Sleeper) != phase; }))
+    { return false; }
+    unsigned int state;
+    while(((state = _M_phase.load(MemoryOrder::Acquire)) & ~Sleeper) == phase)
+    { futex_sleep(_M_phase, state, Sleeper); }
+    return false;
+}
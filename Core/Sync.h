@@ -0,0 +1,184 @@
+#ifndef SYNC_H
+#define SYNC_H
+
+#include "Core/Version.h"
+#include "Core/Atomic.h"
+#include "Core/Futex.h"
+
+namespace rapid
+{
+
+/* blocking primitives on futex words, each one is a few words instead of a pthread object
+ * the paths without a waiter are inline and never enter the kernel, a waiter spins a short
+ * while before it sleeps
+ * a waker touches the object with a single atomic operation and then only calls futex wake,
+ * whether a thread sleeps is a bit of the word itself, so a woken thread may destroy the
+ * object right away
+ */
+
+/* mutex with 3 states, unlock only makes a system call when a thread may be sleeping
+ * unlike SpinLock it does not yield, it sleeps as soon as a short spin fails
+ */
+class Mutex
+{
+private:
+    // 0 unlocked, 1 locked, 2 locked and a thread may sleep on it
+    Atomic<unsigned int> _M_state;
+
+    void _F_lock_slow();
+
+    friend class Condition;
+public:
+    constexpr Mutex() : _M_state(0) { }
+    Mutex(const Mutex &) = delete;
+    Mutex& operator=(const Mutex &) = delete;
+
+    void lock()
+    {
+        unsigned int unlocked = 0;
+        if(!_M_state.compare_exchange_strong(unlocked, 1, MemoryOrder::Acquire, MemoryOrder::Relaxed))
+        { _F_lock_slow(); }
+    }
+    bool try_lock()
+    {
+        unsigned int unlocked = 0;
+        return _M_state.compare_exchange_strong(unlocked, 1, MemoryOrder::Acquire, MemoryOrder::Relaxed);
+    }
+    void unlock()
+    {
+        if(_M_state.exchange(0, MemoryOrder::Release) == 2)
+        { futex_wake(_M_state, 1); }
+    }
+};
+
+/* condition variable used with a Mutex
+ * wait may return without a notify, check the condition in a loop or use the predicate version
+ */
+class Condition
+{
+private:
+    // the sequence steps by 2, the lowest bit is set when a thread may sleep on it
+    static constexpr unsigned int Sleeper = 1;
+    static constexpr unsigned int Step = 2;
+
+    Atomic<unsigned int> _M_sequence;
+public:
+    constexpr Condition() : _M_sequence(0) { }
+    Condition(const Condition &) = delete;
+    Condition& operator=(const Condition &) = delete;
+
+    // param[mutex]: locked by this thread, it is unlocked while waiting and locked again after
+    void wait(Mutex &mutex);
+    template<typename _Pred>
+    void wait(Mutex &mutex, _Pred pred)
+    {
+        while(!pred())
+        { wait(mutex); }
+    }
+
+    // the sleeper bit stays, there may be more sleepers
+    void notify_one()
+    {
+        if((_M_sequence.fetch_add(Step, MemoryOrder::Release) & Sleeper) != 0)
+        { futex_wake(_M_sequence, 1); }
+    }
+    void notify_all();
+};
+
+/* counting semaphore
+ * the highest bit of the count is set when a thread may sleep on it
+ */
+class Semaphore
+{
+private:
+    static constexpr unsigned int Sleeper = 1u << 31;
+
+    Atomic<unsigned int> _M_count;
+
+    void _F_acquire_slow();
+public:
+    constexpr explicit Semaphore(unsigned int count = 0) : _M_count(count) { }
+    Semaphore(const Semaphore &) = delete;
+    Semaphore& operator=(const Semaphore &) = delete;
+
+    bool try_acquire()
+    {
+        unsigned int count = _M_count.load(MemoryOrder::Relaxed);
+        while((count & ~Sleeper) != 0)
+        {
+            if(_M_count.compare_exchange_weak(count, count - 1, MemoryOrder::Acquire, MemoryOrder::Relaxed))
+            { return true; }
+        }
+        return false;
+    }
+    void acquire()
+    {
+        if(!try_acquire())
+        { _F_acquire_slow(); }
+    }
+    void release(unsigned int n = 1);
+
+    unsigned int count() const
+    { return _M_count.load(MemoryOrder::Relaxed) & ~Sleeper; }
+};
+
+/* single use countdown, the waiters are released when it reaches 0
+ * the highest bit of the count is set when a thread may sleep on it
+ */
+class Latch
+{
+private:
+    static constexpr unsigned int Sleeper = 1u << 31;
+
+    Atomic<unsigned int> _M_count;
+public:
+    constexpr explicit Latch(unsigned int count) : _M_count(count) { }
+    Latch(const Latch &) = delete;
+    Latch& operator=(const Latch &) = delete;
+
+    void count_down(unsigned int n = 1)
+    {
+        unsigned int count = _M_count.fetch_sub(n, MemoryOrder::Release);
+        if(count == (n | Sleeper))
+        { futex_wake_all(_M_count); }
+    }
+    bool try_wait() const
+    { return (_M_count.load(MemoryOrder::Acquire) & ~Sleeper) == 0; }
+    void wait();
+    void arrive_and_wait(unsigned int n = 1)
+    {
+        count_down(n);
+        wait();
+    }
+};
+
+// reusable rendezvous of a fixed number of threads
+class Barrier
+{
+private:
+    // the phase steps by 2, the lowest bit is set when a thread may sleep on it
+    static constexpr unsigned int Sleeper = 1;
+    static constexpr unsigned int Step = 2;
+
+    const unsigned int _M_count;
+    Atomic<unsigned int> _M_arrived;
+    Atomic<unsigned int> _M_phase;
+public:
+    constexpr explicit Barrier(unsigned int count)
+        : _M_count(count), _M_arrived(0), _M_phase(0) { }
+    Barrier(const Barrier &) = delete;
+    Barrier& operator=(const Barrier &) = delete;
+
+    /* block until [count] threads have arrived in this phase
+     * return: true for exactly one thread of each phase, the last one to arrive
+     */
+    bool arrive_and_wait();
+
+    // number of phases completed
+    unsigned int phase() const
+    { return _M_phase.load(MemoryOrder::Acquire) / Step; }
+};
+
+};
+
+#endif // SYNC_H
@@ -22,6 +22,10 @@ public:
     void construct(const Args &... args)
     { ::new(address()) T(args...); }
 
+    // call T's destructor, the content must be constructed
+    void destruct()
+    { address()->~T(); }
+
     T* address()
     { return reinterpret_cast<T *>(&__Data[0]); }
 
@@ -0,0 +1,206 @@
+#include "ThreadPool.h"
+
+// the pool and the worker index of this thread, nullptr if it is not a worker
+static thread_local rapid::ThreadPool *__current_pool = nullptr;
+static thread_local rapid::size_type __current_index = 0;
+// victim choice of the threads which are not workers
+static thread_local unsigned int __steal_seed = 0;
+
+static inline unsigned int __xorshift(unsigned int &seed)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+rapid::ThreadPool::ThreadPool(SizeType threads)
+    : _M_workers(nullptr), _M_count(threads), _M_inject_head(nullptr), _M_inject_tail(nullptr),
+      _M_injected(0), _M_wake(0), _M_sleepers(0), _M_stop(false)
+{
+    if(_M_count == 0)
+    {
+        _M_count = std::thread::hardware_concurrency();
+        if(_M_count == 0) _M_count = 1;
+    }
+    _M_workers = new Worker[_M_count];
+    for(SizeType i = 0; i < _M_count; ++i)
+    { _M_workers[i].Seed = static_cast<unsigned int>(i) * 2654435761u + 1; }
+    for(SizeType i = 0; i < _M_count; ++i)
+    { _M_workers[i].Thread = std::thread(&ThreadPool::_F_worker_main, this, i); }
+}
+
+rapid::ThreadPool::~ThreadPool()
+{
+    _M_stop.store(true, MemoryOrder::SeqCst);
+    _M_wake.fetch_add(1, MemoryOrder::SeqCst);
+    futex_wake_all(_M_wake);
+    for(SizeType i = 0; i < _M_count; ++i)
+    { _M_workers[i].Thread.join(); }
+    delete[] _M_workers;
+}
+
+rapid::ThreadPool& rapid::ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+rapid::ThreadPool::Worker* rapid::ThreadPool::_F_self() const
+{ return __current_pool == this ? _M_workers + __current_index : nullptr; }
+
+rapid::Task* rapid::ThreadPool::_F_pop_injected()
+{
+    // pairs with the fence of _F_notify when a worker parks
+    if(_M_injected.load(MemoryOrder::SeqCst) == 0)
+    { return nullptr; }
+    LockGuard<Mutex> guard(_M_inject_lock);
+    Task *task = _M_inject_head;
+    if(task != nullptr)
+    {
+        _M_inject_head = task->Next;
+        if(_M_inject_head == nullptr)
+        { _M_inject_tail = nullptr; }
+        _M_injected.fetch_sub(1, MemoryOrder::Relaxed);
+    }
+    return task;
+}
+
+rapid::Task* rapid::ThreadPool::_F_find_task(Worker *self)
+{
+    Task *task = nullptr;
+    if(self != nullptr && self->Deque.pop(task))
+    { return task; }
+    if((task = _F_pop_injected()) != nullptr)
+    { return task; }
+    // visit every other worker once, from a random one
+    unsigned int &seed = self != nullptr ? self->Seed : __steal_seed;
+    if(seed == 0)
+    { seed = static_cast<unsigned int>(reinterpret_cast<unsigned long>(&seed) >> 4) | 1; }
+    SizeType start = __xorshift(seed) % _M_count;
+    for(SizeType i = 0; i < _M_count; ++i)
+    {
+        Worker *victim = _M_workers + (start + i) % _M_count;
+        if(victim != self && victim->Deque.steal(task))
+        { return task; }
+    }
+    return nullptr;
+}
+
+void rapid::ThreadPool::_F_push(Task *task)
+{
+    Worker *self = _F_self();
+    if(self != nullptr)
+    { self->Deque.push(task); }
+    else
+    {
+        LockGuard<Mutex> guard(_M_inject_lock);
+        if(_M_inject_tail == nullptr)
+        { _M_inject_head = task; }
+        else
+        { _M_inject_tail->Next = task; }
+        _M_inject_tail = task;
+        _M_injected.fetch_add(1, MemoryOrder::Release);
+    }
+    _F_notify();
+}
+
+void rapid::ThreadPool::_F_notify()
+{
+    // the push above and the load below are not reordered, a parking worker sees the task or is counted here
+    atomic_thread_fence(MemoryOrder::SeqCst);
+    if(_M_sleepers.load(MemoryOrder::Relaxed) == 0)
+    { return; }
+    _M_wake.fetch_add(1, MemoryOrder::Release);
+    futex_wake(_M_wake, 1);
+}
+
+bool rapid::ThreadPool::run_one()
+{
+    Task *task = _F_find_task(_F_self());
+    if(task == nullptr)
+    { return false; }
+    task->Run(task);
+    return true;
+}
+
+void rapid::ThreadPool::_F_worker_main(SizeType index)
+{
+    __current_pool = this;
+    __current_index = index;
+    Worker *self = _M_workers + index;
+    Backoff backoff;
+    while(true)
+    {
+        Task *task = _F_find_task(self);
+        if(task != nullptr)
+        {
+            task->Run(task);
+            backoff.reset();
+            continue;
+        }
+        if(backoff.spin())
+        { continue; }
+        // count this worker as a sleeper before the last look, a push after it wakes this worker
+        _M_sleepers.fetch_add(1, MemoryOrder::SeqCst);
+        unsigned int wake = _M_wake.load(MemoryOrder::SeqCst);
+        task = _F_find_task(self);
+        bool stop = _M_stop.load(MemoryOrder::SeqCst);
+        if(task == nullptr && !stop)
+        { futex_wait(_M_wake, wake); }
+        _M_sleepers.fetch_sub(1, MemoryOrder::Relaxed);
+        if(task != nullptr)
+        { task->Run(task); }
+        else if(stop)
+        { break; }
+        backoff.reset();
+    }
+    __current_pool = nullptr;
+}
+
+//-----------------------TaskGroup-----------------------//
+
+void rapid::TaskGroup::_F_fail()
+{
+    if(!_M_failed.exchange(true, MemoryOrder::AcqRel))
+    { _M_error = std::current_exception(); }
+}
+
+void rapid::TaskGroup::_F_finish()
+{
+    unsigned int pending = _M_pending.load(MemoryOrder::Relaxed);
+    unsigned int next;
+    do
+    {
+        next = pending - 1;
+        // the last task clears the sleeper bit, the group may be destroyed right after
+        if((next & ~Sleeper) == 0)
+        { next = 0; }
+    }
+    while(!_M_pending.compare_exchange_weak(pending, next, MemoryOrder::AcqRel, MemoryOrder::Relaxed));
+    if(next == 0 && (pending & Sleeper) != 0)
+    { futex_wake_all(_M_pending); }
+}
+
+void rapid::TaskGroup::_F_wait()
+{
+    _M_pool.help_until([this]() { return _M_pending.load(MemoryOrder::Acquire) == 0; },
+                       [this]()
+                       {
+                           unsigned int pending = _M_pending.load(MemoryOrder::Relaxed);
+                           if((pending & ~Sleeper) != 0)
+                           { futex_sleep(_M_pending, pending, Sleeper); }
+                       });
+}
+
+void rapid::TaskGroup::sync()
+{
+    _F_wait();
+    if(_M_failed.load(MemoryOrder::Acquire))
+    {
+        std::exception_ptr error = _M_error;
+        _M_error = nullptr;
+        _M_failed.store(false, MemoryOrder::Relaxed);
+        std::rethrow_exception(error);
+    }
+}
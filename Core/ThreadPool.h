@@ -0,0 +1,372 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include "Core/TLNode.h"
+#include "Core/Atomic.h"
+#include "Core/Futex.h"
+#include "Core/Sync.h"
+#include "Core/SpinLock.h" // LockGuard
+#include "Core/WorkStealingDeque.h"
+#include <exception> // std::exception_ptr
+#include <thread>
+
+namespace rapid
+{
+
+// a unit of work, Run executes and frees it
+struct Task
+{
+    void (*Run)(Task *);
+    Task *Next;// link of the injection queue
+};
+
+template<typename _Func>
+struct FunctionTask : Task
+{
+    _Func Func;
+
+    template<typename F>
+    explicit FunctionTask(F &&f) : Func(rapid::forward<F>(f))
+    {
+        Run = &_SF_run;
+        Next = nullptr;
+    }
+    static void _SF_run(Task *task)
+    {
+        FunctionTask *self = static_cast<FunctionTask *>(task);
+        try
+        { self->Func(); }
+        catch(...)
+        {
+            delete self;
+            throw;
+        }
+        delete self;
+    }
+};
+
+template<typename R>
+class Future;
+
+/* work stealing thread pool
+ * every worker owns a Chase-Lev deque, a task spawned by a worker goes to the bottom of its
+ * own deque and is run there last in first out, which keeps nested fork-join depth first
+ * and cache warm, an idle worker steals from the top of the deque of a random victim
+ * tasks from other threads go to a shared injection queue
+ * a worker finding nothing spins a while, then parks on a futex until a task is pushed
+ * a thread waiting for a Future or a TaskGroup runs pending tasks meanwhile
+ */
+class ThreadPool
+{
+public:
+    using SizeType = size_type;
+private:
+    struct Worker
+    {
+        WorkStealingDeque<Task *> Deque;
+        std::thread Thread;
+        unsigned int Seed;
+    };
+
+    Worker *_M_workers;
+    SizeType _M_count;
+    Mutex _M_inject_lock;
+    Task *_M_inject_head;
+    Task *_M_inject_tail;
+    Atomic<SizeType> _M_injected;
+    // parked workers sleep on _M_wake, a push changes it when _M_sleepers is not 0
+    Atomic<unsigned int> _M_wake;
+    Atomic<unsigned int> _M_sleepers;
+    Atomic<bool> _M_stop;
+
+    Worker* _F_self() const;
+    Task* _F_pop_injected();
+    Task* _F_find_task(Worker *self);
+    void _F_push(Task *task);
+    void _F_notify();
+    void _F_worker_main(SizeType index);
+public:
+    // param[threads]: number of workers, 0 means one per cpu
+    explicit ThreadPool(SizeType threads = 0);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool& operator=(const ThreadPool &) = delete;
+    // the tasks pushed before are run, then the workers exit
+    ~ThreadPool();
+
+    // the pool shared by the library, one worker per cpu
+    static ThreadPool& global();
+
+    SizeType thread_count() const
+    { return _M_count; }
+    // whether this thread is a worker of this pool
+    bool in_worker() const
+    { return _F_self() != nullptr; }
+
+    // run [f] on the pool, it should not throw
+    template<typename _Func>
+    void execute(_Func &&f)
+    { _F_push(new FunctionTask<typename std::decay<_Func>::type>(rapid::forward<_Func>(f))); }
+
+    // run [f] on the pool, the Future gets its result or its exception
+    template<typename _Func>
+    auto submit(_Func &&f) -> Future<typename std::decay<decltype(f())>::type>;
+
+    /* run one pending task in this thread
+     * return: false if no task is found
+     */
+    bool run_one();
+
+    /* run pending tasks in this thread until [done] returns true
+     * a thread not in the pool calls [sleep] instead of spinning when there is no task to run
+     */
+    template<typename _Done, typename _Sleep>
+    void help_until(_Done done, _Sleep sleep)
+    {
+        Backoff backoff;
+        bool worker = in_worker();
+        while(!done())
+        {
+            if(run_one())
+            {
+                backoff.reset();
+                continue;
+            }
+            if(!backoff.spin())
+            {
+                // a worker keeps looking, all workers sleeping on results would never run the tasks
+                if(worker) std::this_thread::yield();
+                else sleep();
+            }
+        }
+    }
+};
+
+//-----------------------Future-----------------------//
+
+template<typename R>
+struct FutureValue
+{
+    NodeBase<R> Data;
+
+    template<typename _Func>
+    void set(_Func &f)
+    { ::new(Data.address()) R(f()); }
+    R take()
+    {
+        R value = rapid::move(Data.ref_content());
+        Data.destruct();
+        return value;
+    }
+    void drop()
+    { Data.destruct(); }
+};
+
+template<>
+struct FutureValue<void>
+{
+    template<typename _Func>
+    void set(_Func &f)
+    { f(); }
+    void take() { }
+    void drop() { }
+};
+
+// the result shared by a task and its Future, freed by the last of them
+template<typename R>
+struct FutureState
+{
+    static constexpr unsigned int Ready = 1;
+    static constexpr unsigned int Taken = 2;
+    static constexpr unsigned int Sleeper = 4;
+
+    Atomic<unsigned int> Status;
+    Atomic<unsigned int> References;
+    std::exception_ptr Error;
+    FutureValue<R> Value;
+
+    FutureState() : Status(0), References(2) { }
+
+    template<typename _Func>
+    void run(_Func &f)
+    {
+        try
+        { Value.set(f); }
+        catch(...)
+        { Error = std::current_exception(); }
+        if((Status.exchange(Ready, MemoryOrder::AcqRel) & Sleeper) != 0)
+        { futex_wake_all(Status); }
+    }
+    bool ready() const
+    { return (Status.load(MemoryOrder::Acquire) & Ready) != 0; }
+    void release()
+    {
+        if(References.fetch_sub(1, MemoryOrder::AcqRel) != 1) return;
+        if((Status.load(MemoryOrder::Relaxed) & (Ready | Taken)) == Ready && !Error)
+        { Value.drop(); }
+        delete this;
+    }
+};
+
+// the result of a task submitted to a ThreadPool, it can be taken once
+template<typename R>
+class Future
+{
+private:
+    using State = FutureState<R>;
+
+    State *_M_state;
+    ThreadPool *_M_pool;
+public:
+    Future() : _M_state(nullptr), _M_pool(nullptr) { }
+    Future(State *state, ThreadPool *pool) : _M_state(state), _M_pool(pool) { }
+    Future(Future &&f) : _M_state(f._M_state), _M_pool(f._M_pool)
+    { f._M_state = nullptr; }
+    Future& operator=(Future &&f)
+    {
+        if(this != &f)
+        {
+            if(_M_state != nullptr) _M_state->release();
+            _M_state = f._M_state;
+            _M_pool = f._M_pool;
+            f._M_state = nullptr;
+        }
+        return *this;
+    }
+    Future(const Future &) = delete;
+    Future& operator=(const Future &) = delete;
+    // a result not taken is dropped, the task still runs
+    ~Future()
+    {
+        if(_M_state != nullptr) _M_state->release();
+    }
+
+    bool valid() const
+    { return _M_state != nullptr; }
+    bool ready() const
+    { return _M_state->ready(); }
+
+    // run pending tasks of the pool until the result is ready
+    void wait()
+    {
+        State *state = _M_state;
+        _M_pool->help_until([state]() { return state->ready(); },
+                            [state]()
+                            {
+                                unsigned int status = state->Status.load(MemoryOrder::Relaxed);
+                                if((status & State::Ready) == 0)
+                                { futex_sleep(state->Status, status, State::Sleeper); }
+                            });
+    }
+
+    // return: the result, the exception of the task is thrown again here
+    R get()
+    {
+        wait();
+        State *state = _M_state;
+        _M_state = nullptr;
+        state->Status.fetch_or(State::Taken, MemoryOrder::Relaxed);
+        struct Release
+        {
+            State *S;
+            ~Release() { S->release(); }
+        } guard{state};
+        if(state->Error)
+        { std::rethrow_exception(state->Error); }
+        return state->Value.take();
+    }
+};
+
+template<typename _Func>
+auto ThreadPool::submit(_Func &&f) -> Future<typename std::decay<decltype(f())>::type>
+{
+    using R = typename std::decay<decltype(f())>::type;
+    using Function = typename std::decay<_Func>::type;
+    FutureState<R> *state = new FutureState<R>();
+    struct Run
+    {
+        FutureState<R> *State;
+        Function Func;
+
+        void operator()()
+        {
+            State->run(Func);
+            State->release();
+        }
+    };
+    try
+    { execute(Run{state, rapid::forward<_Func>(f)}); }
+    catch(...)
+    {
+        delete state;
+        throw;
+    }
+    return Future<R>(state, this);
+}
+
+//-----------------------TaskGroup-----------------------//
+
+/* fork-join over a ThreadPool, spawn() runs tasks on the pool and sync() waits for all of them
+ * tasks may spawn into the same group or into groups of their own
+ */
+class TaskGroup
+{
+private:
+    // the highest bit of _M_pending is set when a thread may sleep on it
+    static constexpr unsigned int Sleeper = 1u << 31;
+
+    ThreadPool &_M_pool;
+    Atomic<unsigned int> _M_pending;
+    Atomic<bool> _M_failed;
+    std::exception_ptr _M_error;
+
+    void _F_fail();
+    void _F_finish();
+    void _F_wait();
+public:
+    explicit TaskGroup(ThreadPool &pool = ThreadPool::global())
+        : _M_pool(pool), _M_pending(0), _M_failed(false) { }
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup& operator=(const TaskGroup &) = delete;
+    // waits for the tasks, an exception not taken by sync() is dropped
+    ~TaskGroup()
+    { _F_wait(); }
+
+    template<typename _Func>
+    void spawn(_Func &&f)
+    {
+        using Function = typename std::decay<_Func>::type;
+        struct Run
+        {
+            TaskGroup *Group;
+            Function Func;
+
+            void operator()()
+            {
+                try
+                { Func(); }
+                catch(...)
+                { Group->_F_fail(); }
+                Group->_F_finish();
+            }
+        };
+        _M_pending.fetch_add(1, MemoryOrder::Relaxed);
+        try
+        { _M_pool.execute(Run{this, rapid::forward<_Func>(f)}); }
+        catch(...)
+        {
+            _F_finish();
+            throw;
+        }
+    }
+
+    /* wait for every task spawned, running pending tasks meanwhile
+     * the first exception of the tasks is thrown again here
+     */
+    void sync();
+};
+
+};
+
+#endif // THREADPOOL_H
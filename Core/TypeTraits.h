@@ -1,6 +1,8 @@
 #ifndef TYPETRAITS_H
 #define TYPETRAITS_H
 
+#include <type_traits>
+
 namespace rapid
 {
 
@@ -68,6 +70,34 @@ struct IsRvalueReference : FalseType {};
 template<typename T>
 struct IsRvalueReference<T&&> : TrueType {};
 
+template<typename T>
+struct IsIntegral : ReferenceBase<bool, std::is_integral<T>::value>
+{ };
+
+template<typename T>
+struct IsTriviallyCopyable : ReferenceBase<bool, std::is_trivially_copyable<T>::value>
+{ };
+
+template<typename T>
+struct IsTriviallyDestructible : ReferenceBase<bool, std::is_trivially_destructible<T>::value>
+{ };
+
+/* whether moving [T] to another address and dropping the old one is the same as copying the bytes,
+ * then containers relocate it by mem_copy, otherwise by move construction
+ * specialize it for types which keep no pointer to themselves, such as containers owning a buffer
+ */
+template<typename T>
+struct IsTriviallyRelocatable : ReferenceBase<bool, std::is_trivially_copyable<T>::value>
+{ };
+
+/* whether operator== of [T] is the same as comparing the bytes, then [T] can be searched by simd,
+ * specialize it for custom types without padding
+ */
+template<typename T>
+struct IsBitwiseComparable : ReferenceBase<bool, std::is_integral<T>::value || std::is_enum<T>::value ||
+                                                 std::is_pointer<T>::value>
+{ };
+
 template<typename T>
 T remove_const(const T arg)
 { return const_cast<T>(arg); }
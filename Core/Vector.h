@@ -6,11 +6,14 @@
 #include "Core/Version.h"
 #include "Core/Exception.h"
 #include "Core/Memory.h"
+#include "Core/Allocator.h"
 #include <initializer_list>
+#include <iterator> // std::random_access_iterator_tag
+#include <type_traits> // std::is_trivially_copyable
 
 namespace rapid
 {
-template <typename T>
+template <typename T, typename _Alloc = ContainerAllocator<T, VectorStatsTag>>
 class Vector
 {
 public:
@@ -21,35 +24,69 @@ public:
 
     using ValueType = T;
     using Pointer = ValueType*;
+    using ConstPointer = const ValueType*;
     using Reference = ValueType&;
     using ConstReference = const ValueType &;
     using RvalueReference = ValueType&&;
     using SizeType = size_type;
+    using DifferenceType = long long;
+    using AllocatorType = _Alloc;
 
     using value_type = ValueType;// std
+    using allocator_type = AllocatorType;// std
 private:
+    using DataAllocator = RebindAllocator<AllocatorType, NodeBase<ValueType>>;
+    using DataTraits = std::allocator_traits<DataAllocator>;
+
+    AllocatorType _M_alloc;
     SizeType _M_size = 0;
     SizeType _M_capacity = 1;
     SizeType _M_growth = 0;
     NodeBase<ValueType> *_M_data = nullptr;
 
+    // raw capacity, an element is only constructed when it is added
+    NodeBase<ValueType>* _F_allocate(SizeType s)
+    {
+        DataAllocator a(_M_alloc);
+        return DataTraits::allocate(a, s);
+    }
+    void _F_deallocate(NodeBase<ValueType> *p, SizeType s)
+    {
+        DataAllocator a(_M_alloc);
+        DataTraits::deallocate(a, p, s);
+    }
+    // the elements are stored contiguously, NodeBase has the size and alignment of ValueType
+    Pointer _F_data() const
+    { return reinterpret_cast<Pointer>(_M_data); }
+    SizeType _F_index(const_iterator it) const
+    { return static_cast<SizeType>(it._M_current - _F_data()); }
     void _F_initialize(SizeType s);
     void _F_copy_data(const Vector &arg);
     template<typename ... Args>
-    void _F_insert(const iterator &it, const Args & ... arg);
+    iterator _F_insert(const_iterator it, Args && ... args);
+    // copy construct [n] elements of [first] into the raw memory [dst]
+    template<typename _Iterator>
+    void _F_copy_range(Pointer dst, _Iterator first, SizeType n, std::true_type)
+    { rapid::uninitialized_copy(dst, &*first, n); }
+    template<typename _Iterator>
+    void _F_copy_range(Pointer dst, _Iterator first, SizeType n, std::false_type);
     iterator _F_find(ConstReference arg) const;
-    void _F_erase(const iterator &it)
+    SizeType _F_find_index(ConstReference arg, std::true_type) const
+    { return mem_find_element(_M_data, size(), &arg, sizeof(ValueType)); }
+    SizeType _F_find_index(ConstReference arg, std::false_type) const;
+    void _F_erase(const_iterator it)
     {
         if(it == end()) return;
-        mem_forward(_M_data[it._M_current_index + 1].address(), (size() - it._M_current_index) * sizeof(ValueType), sizeof(ValueType));
+        SizeType i = _F_index(it);
+        rapid::destroy(_M_data[i].address(), 1);
+        rapid::relocate(_M_data[i].address(), _M_data[i + 1].address(), size() - i - 1);
         _F_add_size(-1);
     }
-    void _F_growth()
+    // grow the capacity to hold at least [required] elements, doubling it unless set_growth() is used
+    void _F_growth(SizeType required)
     {
-        if(_M_growth < 1)
-        { _F_initialize(capacity() * 2); }
-        else
-        { _F_initialize(capacity() + _M_growth); }
+        SizeType s = _M_growth < 1 ? capacity() * 2 : capacity() + _M_growth;
+        _F_initialize(s < required ? required : s);
     }
     void _F_add_size(SizeType s)
     { _M_size += s;}
@@ -57,395 +94,320 @@ public:
     class iterator
     {
     private:
-        SizeType _M_current_index;
-        SizeType _M_max_index;// not contained
-        ValueType *_M_data;
+        ValueType *_M_current;
 
         friend class Vector;
 
-        inline void _F_init(const iterator &it)
-        {
-            _M_current_index = it._M_current_index;
-            _M_max_index = it._M_max_index;
-            _M_data = it._M_data;
-        }
-        void _F_next()
-        {
-            if(_M_current_index >= 0 && _M_current_index < _M_max_index)
-            { _M_current_index++; }
-            else
-            { _M_current_index = _M_max_index; }
-        }
-        void _F_previous()
-        {
-            if(_M_current_index >= 0 && _M_current_index < _M_max_index)
-            { _M_current_index--; }
-            else
-            { _M_current_index = _M_max_index; }
-        }
-
-        iterator(const SizeType n, const SizeType max, ValueType *start)
-            : _M_current_index(n), _M_max_index(max), _M_data(start)
-        { }
+        explicit iterator(ValueType *p) : _M_current(p) { }
     public:
-        iterator() : _M_current_index(SizeType(-1)), _M_max_index(SizeType(-1)), _M_data(nullptr) { }
-        iterator(const iterator &it) { _F_init(it); }
-        iterator(iterator && it) { _F_init(forward<iterator>(it)); }
+        using iterator_category = std::random_access_iterator_tag;// std
+        using value_type = ValueType;// std
+        using difference_type = DifferenceType;// std
+        using pointer = Pointer;// std
+        using reference = Reference;// std
+
+        iterator() : _M_current(nullptr) { }
+
+        Reference operator*() const
+        { return *_M_current; }
+        Pointer operator->() const
+        { return _M_current; }
+        Reference operator[](DifferenceType n) const
+        { return _M_current[n]; }
 
-        iterator operator=(const iterator &it)
+        iterator& operator++()
         {
-            _F_init(it);
+            ++_M_current;
             return *this;
         }
-        SizeType operator-(const iterator &it) const
-        { return _M_current_index - it._M_current_index; }
-        iterator operator-(const SizeType s) const
-        {
-            iterator it = *this;
-            it._M_current_index -= s;
-            if(it._M_current_index < 0 || it._M_current_index > it._M_max_index)
-            { it._M_current_index = it._M_max_index + 1; }
-            return it;
-        }
-        iterator operator+(const SizeType s) const
+        iterator operator++(int)
         {
             iterator it = *this;
-            it._M_current_index += s;
-            if(it._M_current_index < 0 || it._M_current_index > it._M_max_index)
-            { it._M_current_index = it._M_max_index + 1; }
+            ++_M_current;
             return it;
         }
-        iterator operator-=(const SizeType s)
-        {
-            _M_current_index -= s;
-            if(_M_current_index < 0 || _M_current_index > _M_max_index)
-            { _M_current_index = _M_max_index + 1; }
-            return *this;
-        }
-        iterator operator+=(const SizeType s)
+        iterator& operator--()
         {
-            _M_current_index += s;
-            if(_M_current_index < 0 || _M_current_index > _M_max_index)
-            { _M_current_index = _M_max_index + 1; }
+            --_M_current;
             return *this;
         }
-        iterator operator++()
-        {
-            _F_next();
-            return *this;
-        }
-        iterator operator++(int)
+        iterator operator--(int)
         {
             iterator it = *this;
-            _F_next();
+            --_M_current;
             return it;
         }
-        iterator operator--()
+        iterator& operator+=(DifferenceType n)
         {
-            _F_previous();
+            _M_current += n;
             return *this;
         }
-        iterator operator--(int)
+        iterator& operator-=(DifferenceType n)
         {
-            iterator it = *this;
-            _F_previous();
-            return it;
+            _M_current -= n;
+            return *this;
         }
+        iterator operator+(DifferenceType n) const
+        { return iterator(*this) += n; }
+        iterator operator-(DifferenceType n) const
+        { return iterator(*this) -= n; }
+        DifferenceType operator-(const iterator &it) const
+        { return _M_current - it._M_current; }
+
+        bool operator==(const iterator &it) const
+        { return _M_current == it._M_current; }
+        bool operator!=(const iterator &it) const
+        { return _M_current != it._M_current; }
         bool operator<(const iterator &it) const
-        { return _M_current_index < it._M_current_index; }
-        Reference operator*()
-        { return _M_data[_M_current_index]; }
-
-        Pointer operator->()
-        { return _M_data[_M_current_index].address(); }
-
-        bool operator==(const iterator& arg) const
-        { return _M_current_index == arg._M_current_index; }
-        bool operator!=(const iterator& arg) const
-        { return _M_current_index != arg._M_current_index; }
+        { return _M_current < it._M_current; }
+        bool operator>(const iterator &it) const
+        { return _M_current > it._M_current; }
+        bool operator<=(const iterator &it) const
+        { return !(*this > it); }
+        bool operator>=(const iterator &it) const
+        { return !(*this < it); }
     };
 
     class const_iterator
     {
     private:
-        SizeType _M_current_index;
-        SizeType _M_max_index;// not contained
-        const ValueType *_M_data;
+        const ValueType *_M_current;
 
         friend class Vector;
 
-        inline void _F_init(const const_iterator &it)
-        {
-            _M_current_index = it._M_current_index;
-            _M_max_index = it._M_max_index;
-            _M_data = it._M_data;
-        }
-        void _F_next()
-        {
-            if(_M_current_index >= 0 && _M_current_index < _M_max_index)
-            { _M_current_index++; }
-            else
-            { _M_current_index = _M_max_index; }
-        }
-        void _F_previous()
-        {
-            if(_M_current_index >= 0 && _M_current_index < _M_max_index)
-            { _M_current_index--; }
-            else
-            { _M_current_index = _M_max_index; }
-        }
-        iterator _F_const_cast()
-        { return iterator(_M_current_index, _M_max_index, const_cast<ValueType *>(_M_data)); }
-
-        const_iterator(const SizeType n, const SizeType max, const ValueType *start)
-            : _M_current_index(n), _M_max_index(max), _M_data(start)
-        { }
+        explicit const_iterator(const ValueType *p) : _M_current(p) { }
     public:
-        const_iterator()
-            : _M_current_index(SizeType(-1)), _M_max_index(SizeType(-1)), _M_data(nullptr)
-        { }
-        const_iterator(const const_iterator &it)
-        { _F_init(it); }
-        const_iterator(const_iterator && it)
-        { _F_init(forward<const_iterator>(it)); }
-
-        const_iterator operator=(const const_iterator &it)
+        using iterator_category = std::random_access_iterator_tag;// std
+        using value_type = ValueType;// std
+        using difference_type = DifferenceType;// std
+        using pointer = ConstPointer;// std
+        using reference = ConstReference;// std
+
+        const_iterator() : _M_current(nullptr) { }
+        const_iterator(const iterator &it) : _M_current(it._M_current) { }
+
+        ConstReference operator*() const
+        { return *_M_current; }
+        ConstPointer operator->() const
+        { return _M_current; }
+        ConstReference operator[](DifferenceType n) const
+        { return _M_current[n]; }
+
+        const_iterator& operator++()
         {
-            _F_init(it);
+            ++_M_current;
             return *this;
         }
-        SizeType operator-(const const_iterator &it) const
-        { return _M_current_index - it._M_current_index; }
-        const_iterator operator-(const SizeType s) const
-        {
-            const_iterator it = *this;
-            it._M_current_index -= s;
-            if(it._M_current_index < 0 || it._M_current_index > it._M_max_index)
-            { it._M_current_index = it._M_max_index + 1; }
-            return it;
-        }
-        const_iterator operator+(const SizeType s) const
+        const_iterator operator++(int)
         {
             const_iterator it = *this;
-            it._M_current_index += s;
-            if(it._M_current_index < 0 || it._M_current_index > it._M_max_index)
-            { it._M_current_index = it._M_max_index + 1; }
+            ++_M_current;
             return it;
         }
-        const_iterator operator-=(const SizeType s)
-        {
-            _M_current_index -= s;
-            if(_M_current_index < 0 || _M_current_index > _M_max_index)
-            { _M_current_index = _M_max_index + 1; }
-            return *this;
-        }
-        const_iterator operator+=(const SizeType s)
-        {
-            _M_current_index += s;
-            if(_M_current_index < 0 || _M_current_index > _M_max_index)
-            { _M_current_index = _M_max_index + 1; }
-            return *this;
-        }
-        const_iterator operator++()
+        const_iterator& operator--()
         {
-            _F_next();
+            --_M_current;
             return *this;
         }
-        const_iterator operator++(int)
+        const_iterator operator--(int)
         {
             const_iterator it = *this;
-            _F_next();
+            --_M_current;
             return it;
         }
-        const_iterator operator--()
+        const_iterator& operator+=(DifferenceType n)
         {
-            _F_previous();
+            _M_current += n;
             return *this;
         }
-        const_iterator operator--(int)
+        const_iterator& operator-=(DifferenceType n)
         {
-            const_iterator it = *this;
-            _F_previous();
-            return it;
+            _M_current -= n;
+            return *this;
         }
+        const_iterator operator+(DifferenceType n) const
+        { return const_iterator(*this) += n; }
+        const_iterator operator-(DifferenceType n) const
+        { return const_iterator(*this) -= n; }
+        DifferenceType operator-(const const_iterator &it) const
+        { return _M_current - it._M_current; }
+
+        bool operator==(const const_iterator &it) const
+        { return _M_current == it._M_current; }
+        bool operator!=(const const_iterator &it) const
+        { return _M_current != it._M_current; }
         bool operator<(const const_iterator &it) const
-        { return _M_current_index < it._M_current_index; }
-        Reference operator*() const
-        { return _M_data[_M_current_index]; }
-
-        Pointer operator->() const
-        { return _M_data[_M_current_index].address(); }
-
-        bool operator==(const const_iterator& arg) const
-        { return _M_current_index == arg._M_current_index; }
-        bool operator!=(const const_iterator& arg) const
-        { return _M_current_index != arg._M_current_index; }
+        { return _M_current < it._M_current; }
+        bool operator>(const const_iterator &it) const
+        { return _M_current > it._M_current; }
+        bool operator<=(const const_iterator &it) const
+        { return !(*this > it); }
+        bool operator>=(const const_iterator &it) const
+        { return !(*this < it); }
     };
 
     class reverse_iterator
     {
     private:
-        SizeType _M_current_index;
-        SizeType _M_max_index;
-        ValueType *_M_data;
+        ValueType *_M_current;
 
         friend class Vector;
 
-        inline void _F_init(const iterator &it)
-        {
-            _M_current_index = it._M_current_index;
-            _M_max_index = it._M_max_index;
-            _M_data = it._M_data;
-        }
-        void _F_next()
-        {
-            if(_M_current_index >= 0 && _M_current_index < _M_max_index)
-            { _M_current_index--; }
-            else
-            { _M_current_index = _M_max_index; }
-        }
-        void _F_previous()
-        {
-            if(_M_current_index >= 0 && _M_current_index < _M_max_index)
-            { _M_current_index++; }
-            else
-            { _M_current_index = _M_max_index; }
-        }
-
-        reverse_iterator(const SizeType n, const SizeType max = 0, ValueType *start = nullptr)
-            : _M_current_index(n), _M_max_index(max), _M_data(start) { }
+        explicit reverse_iterator(ValueType *p) : _M_current(p) { }
     public:
-        reverse_iterator() : _M_current_index(SizeType(-1)), _M_max_index(SizeType(-1)), _M_data(nullptr) { }
-        reverse_iterator(const reverse_iterator &it) { _F_init(it); }
-        reverse_iterator(reverse_iterator && it) { _F_init(forward<reverse_iterator>(it)); }
+        using iterator_category = std::random_access_iterator_tag;// std
+        using value_type = ValueType;// std
+        using difference_type = DifferenceType;// std
+        using pointer = Pointer;// std
+        using reference = Reference;// std
 
-        reverse_iterator operator=(const reverse_iterator &it)
-        {
-            _F_init(it);
-            return *this;
-        }
-        SizeType operator-(const reverse_iterator &it) const
-        { return _M_current_index + it._M_current_index; }
-        reverse_iterator operator++()
+        reverse_iterator() : _M_current(nullptr) { }
+
+        Reference operator*() const
+        { return *(_M_current - 1); }
+        Pointer operator->() const
+        { return _M_current - 1; }
+        Reference operator[](DifferenceType n) const
+        { return *(_M_current - 1 - n); }
+
+        reverse_iterator& operator++()
         {
-            _F_next();
+            --_M_current;
             return *this;
         }
         reverse_iterator operator++(int)
         {
             reverse_iterator it = *this;
-            _F_next();
+            --_M_current;
             return it;
         }
-        reverse_iterator operator--()
+        reverse_iterator& operator--()
         {
-            _F_previous();
+            ++_M_current;
             return *this;
         }
         reverse_iterator operator--(int)
         {
             reverse_iterator it = *this;
-            _F_previous();
+            ++_M_current;
             return it;
         }
+        reverse_iterator& operator+=(DifferenceType n)
+        {
+            _M_current -= n;
+            return *this;
+        }
+        reverse_iterator& operator-=(DifferenceType n)
+        {
+            _M_current += n;
+            return *this;
+        }
+        reverse_iterator operator+(DifferenceType n) const
+        { return reverse_iterator(*this) += n; }
+        reverse_iterator operator-(DifferenceType n) const
+        { return reverse_iterator(*this) -= n; }
+        DifferenceType operator-(const reverse_iterator &it) const
+        { return it._M_current - _M_current; }
+
+        bool operator==(const reverse_iterator &it) const
+        { return _M_current == it._M_current; }
+        bool operator!=(const reverse_iterator &it) const
+        { return _M_current != it._M_current; }
         bool operator<(const reverse_iterator &it) const
-        { return _M_current_index > it._M_current_index; }
-        Reference operator*()
-        { return _M_data[_M_current_index]; }
-
-        Pointer operator->()
-        { return &_M_data[_M_current_index]; }
-
-        bool operator==(const iterator& arg) const
-        { return _M_current_index == arg._M_current_index; }
-        bool operator!=(const iterator& arg) const
-        { return _M_current_index != arg._M_current_index; }
+        { return _M_current > it._M_current; }
+        bool operator>(const reverse_iterator &it) const
+        { return _M_current < it._M_current; }
+        bool operator<=(const reverse_iterator &it) const
+        { return !(*this > it); }
+        bool operator>=(const reverse_iterator &it) const
+        { return !(*this < it); }
     };
 
     class const_reverse_iterator
     {
     private:
-        SizeType _M_current_index;
-        SizeType _M_max_index;
-        const ValueType *_M_data;
+        const ValueType *_M_current;
 
         friend class Vector;
 
-        inline void _F_init(const iterator &it)
-        {
-            _M_current_index = it._M_current_index;
-            _M_max_index = it._M_max_index;
-            _M_data = it._M_data;
-        }
-        void _F_next()
-        {
-            if(_M_current_index >= 0 && _M_current_index < _M_max_index)
-            { _M_current_index--; }
-            else
-            { _M_current_index = _M_max_index; }
-        }
-        void _F_previous()
-        {
-            if(_M_current_index >= 0 && _M_current_index < _M_max_index)
-            { _M_current_index++; }
-            else
-            { _M_current_index = _M_max_index; }
-        }
-
-        const_reverse_iterator(const SizeType n, const SizeType max = 0, const ValueType *start = nullptr)
-            : _M_current_index(n), _M_max_index(max), _M_data(start) { }
+        explicit const_reverse_iterator(const ValueType *p) : _M_current(p) { }
     public:
-        const_reverse_iterator() : _M_current_index(SizeType(-1)), _M_max_index(SizeType(-1)), _M_data(nullptr) { }
-        const_reverse_iterator(const const_reverse_iterator &it) { _F_init(it); }
-        const_reverse_iterator(const_reverse_iterator && it) { _F_init(forward<const_reverse_iterator>(it)); }
+        using iterator_category = std::random_access_iterator_tag;// std
+        using value_type = ValueType;// std
+        using difference_type = DifferenceType;// std
+        using pointer = ConstPointer;// std
+        using reference = ConstReference;// std
 
-        const_reverse_iterator operator=(const const_reverse_iterator &it)
-        {
-            _F_init(it);
-            return *this;
-        }
-        SizeType operator-(const const_reverse_iterator &it) const
-        { return _M_current_index + it._M_current_index; }
-        const_reverse_iterator operator++()
+        const_reverse_iterator() : _M_current(nullptr) { }
+        const_reverse_iterator(const reverse_iterator &it) : _M_current(it._M_current) { }
+
+        ConstReference operator*() const
+        { return *(_M_current - 1); }
+        ConstPointer operator->() const
+        { return _M_current - 1; }
+        ConstReference operator[](DifferenceType n) const
+        { return *(_M_current - 1 - n); }
+
+        const_reverse_iterator& operator++()
         {
-            _F_next();
+            --_M_current;
             return *this;
         }
         const_reverse_iterator operator++(int)
         {
             const_reverse_iterator it = *this;
-            _F_next();
+            --_M_current;
             return it;
         }
-        const_reverse_iterator operator--()
+        const_reverse_iterator& operator--()
         {
-            _F_previous();
+            ++_M_current;
             return *this;
         }
         const_reverse_iterator operator--(int)
         {
             const_reverse_iterator it = *this;
-            _F_previous();
+            ++_M_current;
             return it;
         }
+        const_reverse_iterator& operator+=(DifferenceType n)
+        {
+            _M_current -= n;
+            return *this;
+        }
+        const_reverse_iterator& operator-=(DifferenceType n)
+        {
+            _M_current += n;
+            return *this;
+        }
+        const_reverse_iterator operator+(DifferenceType n) const
+        { return const_reverse_iterator(*this) += n; }
+        const_reverse_iterator operator-(DifferenceType n) const
+        { return const_reverse_iterator(*this) -= n; }
+        DifferenceType operator-(const const_reverse_iterator &it) const
+        { return it._M_current - _M_current; }
+
+        bool operator==(const const_reverse_iterator &it) const
+        { return _M_current == it._M_current; }
+        bool operator!=(const const_reverse_iterator &it) const
+        { return _M_current != it._M_current; }
         bool operator<(const const_reverse_iterator &it) const
-        { return _M_current_index > it._M_current_index; }
-        Reference operator*() const
-        { return _M_data[_M_current_index]; }
-
-        Pointer operator->() const
-        { return &_M_data[_M_current_index]; }
-
-        bool operator==(const iterator& arg) const
-        { return _M_current_index == arg._M_current_index; }
-        bool operator!=(const iterator& arg) const
-        { return _M_current_index != arg._M_current_index; }
+        { return _M_current > it._M_current; }
+        bool operator>(const const_reverse_iterator &it) const
+        { return _M_current < it._M_current; }
+        bool operator<=(const const_reverse_iterator &it) const
+        { return !(*this > it); }
+        bool operator>=(const const_reverse_iterator &it) const
+        { return !(*this < it); }
     };
 
     Vector(SizeType size = 1)
     { _F_initialize(size); }
+    explicit Vector(const AllocatorType &alloc, SizeType size = 1)
+        : _M_alloc(alloc)
+    { _F_initialize(size); }
     Vector(const Vector &v)
-        : _M_size(v.size()), _M_capacity(v.capacity()), _M_growth(v._M_growth)
+        : _M_alloc(v._M_alloc), _M_size(v.size()), _M_capacity(v.capacity()), _M_growth(v._M_growth)
     { _F_copy_data(v); }
     Vector(std::initializer_list<ValueType> arg)
     {
@@ -459,11 +421,11 @@ public:
     void push_back(ConstReference arg)
     { _F_insert(end(), arg); }
     void push_back(RvalueReference arg)
-    { _F_insert(end(), forward<ValueType>(arg)); }
+    { _F_insert(end(), rapid::forward<ValueType>(arg)); }
     void push_front(ConstReference arg)
     { _F_insert(begin(), arg); }
     void push_front(RvalueReference arg)
-    { _F_insert(begin(),  forward<ValueType>(arg)); }
+    { _F_insert(begin(),  rapid::forward<ValueType>(arg)); }
 
     void pop_back()
     { _F_erase(end() - 1); }
@@ -473,41 +435,54 @@ public:
     void clear()
     {
         if(_M_data != nullptr)
-        { delete[] _M_data; }
+        {
+            rapid::destroy(_M_data[0].address(), _M_size);
+            _F_deallocate(_M_data, _M_capacity);
+        }
         _M_data = nullptr;
         _M_size = 0;
+        _M_capacity = 0;
     }
 
     Vector& operator=(const Vector &v)
-    { _F_copy_data(v); }
+    {
+        if(this != &v)
+        { _F_copy_data(v); }
+        return *this;
+    }
     Reference operator[](const SizeType index)
     { return _M_data[index].ref_content(); }
 
+    Pointer data()
+    { return _F_data(); }
+    ConstPointer data() const
+    { return _F_data(); }
+
     iterator begin()
-    { return iterator(0, _M_size, _M_data[0].address()); }
+    { return iterator(_F_data()); }
     iterator end()
-    { return iterator(_M_size, _M_size, _M_data[0].address()); }
+    { return iterator(_F_data() + _M_size); }
     const_iterator begin() const
-    { return const_iterator(0, _M_size, _M_data[0].address()); }
+    { return const_iterator(_F_data()); }
     const_iterator end() const
-    { return const_iterator(_M_size, _M_size, _M_data[0].address()); }
+    { return const_iterator(_F_data() + _M_size); }
     const_iterator cbegin() const
-    { return const_iterator(0, _M_size, _M_data[0].address()); }
+    { return begin(); }
     const_iterator cend() const
-    { return const_iterator(_M_size, _M_size, _M_data[0].address()); }
+    { return end(); }
 
     reverse_iterator rbegin()
-    { return reverse_iterator(_M_size - 1, _M_size, _M_data[0].address()); }
+    { return reverse_iterator(_F_data() + _M_size); }
     reverse_iterator rend()
-    { return reverse_iterator(-1, _M_size, _M_data[0].address()); }
+    { return reverse_iterator(_F_data()); }
     const_reverse_iterator rbegin() const
-    { return const_reverse_iterator(_M_size - 1, _M_size, _M_data[0].address()); }
+    { return const_reverse_iterator(_F_data() + _M_size); }
     const_reverse_iterator rend() const
-    { return const_reverse_iterator(-1, _M_size, _M_data[0].address()); }
+    { return const_reverse_iterator(_F_data()); }
     const_reverse_iterator crbegin() const
-    { return const_reverse_iterator(_M_size - 1, _M_size, _M_data[0].address()); }
+    { return rbegin(); }
     const_reverse_iterator crend() const
-    { return const_reverse_iterator(-1, _M_size, _M_data[0].address()); }
+    { return rend(); }
 
     Reference back() const
     { return _M_data[size() - 1].ref_content(); }
@@ -517,16 +492,34 @@ public:
     void insert(const iterator &it, ConstReference arg)
     { _F_insert(it, arg); }
     void insert(const iterator &it, RvalueReference arg)
-    { _F_insert(it, forward<ValueType>(arg)); }
+    { _F_insert(it, rapid::forward<ValueType>(arg)); }
     void insert(iterator && it, ConstReference arg)
-    { _F_insert(forward<iterator>(it), arg); }
+    { _F_insert(rapid::forward<iterator>(it), arg); }
     void insert(iterator && it, RvalueReference arg)
-    { _F_insert(forward<iterator>(it), forward<ValueType>(arg)); }
+    { _F_insert(rapid::forward<iterator>(it), rapid::forward<ValueType>(arg)); }
 
     void erase(const iterator &it)
     { _F_erase(it); }
     void erase(iterator && it)
-    { _F_erase(forward<iterator>(it)); }
+    { _F_erase(rapid::forward<iterator>(it)); }
+
+    /* insert the elements of [first, last) before [pos], the tail is moved once
+     * param[first]: forward iterator, not into this Vector
+     * return: the position of the first element inserted
+     */
+    template<typename _Iterator>
+    iterator insert(const_iterator pos, _Iterator first, _Iterator last);
+    // add the elements of [first, last) at the end
+    template<typename _Iterator>
+    iterator append(_Iterator first, _Iterator last)
+    { return insert(end(), first, last); }
+    // erase the elements of [first, last), the tail is moved once
+    void erase(const_iterator first, const_iterator last);
+    /* erase every element [pred] returns true for in a single pass
+     * return: the number of elements erased
+     */
+    template<typename _Pred>
+    SizeType erase_if(_Pred pred);
 
     Reference at(const SizeType index)
     {
@@ -536,7 +529,20 @@ public:
         { return (*this)[index]; }
     }
 
+    // the elements added are value initialized
     void resize(SizeType s);
+    // capacity for at least [s] elements, nothing is constructed
+    void reserve(SizeType s)
+    {
+        if(s > capacity())
+        { _F_initialize(s); }
+    }
+    // give back the capacity beyond size()
+    void shrink_to_fit()
+    {
+        if(capacity() > size())
+        { _F_initialize(size()); }
+    }
 
     SizeType size() const
     { return _M_size; }
@@ -544,39 +550,41 @@ public:
     { return _M_capacity; }
     bool empty() const
     { return size() == 0; }
+    AllocatorType get_allocator() const
+    { return _M_alloc; }
     void set_growth(SizeType s)
     { _M_growth = s; }
 
     iterator find(Reference arg) const
     { return _F_find(arg); }
     iterator find(RvalueReference arg) const
-    { return _F_find(forward<ValueType>(arg)); }
+    { return _F_find(rapid::forward<ValueType>(arg)); }
 
     template<typename ... Args>
     iterator emplace_front(const Args & ... args)
     { return _F_insert(begin(), args...); }
     template<typename ... Args>
     iterator emplace_front(Args && ... args)
-    { return _F_insert(begin(), forward<ValueType>(args)...); }
+    { return _F_insert(begin(), rapid::forward<Args>(args)...); }
     template<typename ... Args>
     iterator emplace_back(const Args & ... args)
     { return _F_insert(end(), args...); }
     template<typename ... Args>
     iterator emplace_back(Args && ... args)
-    { return _F_insert(end(), forward<ValueType>(args)...); }
+    { return _F_insert(end(), rapid::forward<Args>(args)...); }
 
     template<typename ... Args>
     iterator emplace(const_iterator it, const Args & ... args)
-    { return _F_insert(it._F_const_cast(), args...); }
+    { return _F_insert(it, args...); }
     template<typename ... Args>
     iterator emplace(iterator it, const Args & ... args)
     { return _F_insert(it, args...); }
     template<typename ... Args>
     iterator emplace(const_iterator it, Args && ... args)
-    { return _F_insert(it._F_const_cast(), forward<Args>(args)...); }
+    { return _F_insert(it, rapid::forward<Args>(args)...); }
     template<typename ... Args>
     iterator emplace(iterator it, Args && ... args)
-    { return _F_insert(it, forward<Args>(args)...); }
+    { return _F_insert(it, rapid::forward<Args>(args)...); }
 };
 
 //-----------------------impl-----------------------//
@@ -584,71 +592,198 @@ public:
 //-----------------------impl-----------------------//
 //-----------------------impl-----------------------//
 //-----------------------impl-----------------------//
-template<typename T>
-void Vector<T>::_F_initialize(SizeType s)
+template<typename T, typename _Alloc>
+void Vector<T, _Alloc>::_F_initialize(SizeType s)
 {
+    if(s < size())
+    {
+        rapid::destroy(_M_data[0].address() + s, size() - s);
+        _M_size = s;
+    }
+    // trivially relocatable elements are resized in place, so big buffers are not copied
+    if(IsTriviallyRelocatable<ValueType>::value && _M_data != nullptr && s > 0)
+    {
+        DataAllocator a(_M_alloc);
+        _M_data = reallocate_bytes(a, _M_data, _M_capacity, s, size());
+        _M_capacity = s;
+        return;
+    }
     NodeBase<ValueType> *temp = _M_data;
-    _M_data = new NodeBase<ValueType>[s];
+    _M_data = _F_allocate(s);
     if(temp != nullptr)
     {
-        mem_copy(_M_data, temp, size() > s ? s : size() * sizeof(ValueType));
-        delete[] temp;
+        rapid::relocate(_M_data[0].address(), temp[0].address(), size());
+        _F_deallocate(temp, _M_capacity);
     }
     _M_capacity = s;
 }
 
-template<typename T>
-void Vector<T>::_F_copy_data(const Vector &v)
+template<typename T, typename _Alloc>
+void Vector<T, _Alloc>::_F_copy_data(const Vector &v)
 {
     clear();
+    _M_capacity = v.capacity();
+    _M_growth = v._M_growth;
     if(capacity() > 0)
     {
-        _M_data = new NodeBase<ValueType>[capacity()];
-        mem_copy(_M_data[0].address(), v._M_data[0].address(), _M_size * sizeof(ValueType));
+        _M_data = _F_allocate(capacity());
+        rapid::uninitialized_copy(_M_data[0].address(), v._M_data[0].address(), v.size());
+        _M_size = v.size();
     }
 }
 
-template<typename T>
+template<typename T, typename _Alloc>
 template<typename ... Args>
-void Vector<T>::_F_insert(const iterator &it, const Args & ... args)
+typename Vector<T, _Alloc>::iterator Vector<T, _Alloc>::_F_insert(const_iterator it, Args && ... args)
 {
-    if(size() >= capacity())
-    { _F_growth(); }
-    if(it == end())
-    { _M_data[size()].construct(args...); }
-    else
+    // the index stays valid when the buffer moves
+    SizeType i = _F_index(it);
+    if(i == size() && size() < capacity())
     {
-        mem_backward(_M_data[it._M_current_index].address(), (size() - it._M_current_index) * sizeof(ValueType), sizeof(ValueType));
-        _M_data[it._M_current_index].construct(args...);
+        ::new(static_cast<void *>(_M_data[i].address())) ValueType(rapid::forward<Args>(args)...);
+        _F_add_size(1);
+        return begin() + static_cast<DifferenceType>(i);
     }
+    // the arguments may refer to an element which moves below
+    ValueType value(rapid::forward<Args>(args)...);
+    if(size() >= capacity())
+    { _F_growth(size() + 1); }
+    if(i < size())
+    { rapid::relocate(_M_data[i + 1].address(), _M_data[i].address(), size() - i); }
+    ::new(static_cast<void *>(_M_data[i].address())) ValueType(rapid::move(value));
     _F_add_size(1);
+    return begin() + static_cast<DifferenceType>(i);
+}
+
+template<typename T, typename _Alloc>
+template<typename _Iterator>
+void Vector<T, _Alloc>::_F_copy_range(Pointer dst, _Iterator first, SizeType n, std::false_type)
+{
+    SizeType i = 0;
+    try
+    {
+        for(; i < n; ++i, ++first)
+        { ::new(static_cast<void *>(dst + i)) ValueType(*first); }
+    }
+    catch(...)
+    {
+        rapid::destroy(dst, i);
+        throw;
+    }
 }
 
-template<typename T>
-void Vector<T>::resize(SizeType s)
+template<typename T, typename _Alloc>
+template<typename _Iterator>
+typename Vector<T, _Alloc>::iterator Vector<T, _Alloc>::insert(const_iterator pos, _Iterator first, _Iterator last)
 {
-    if(s > capacity())
-    { _F_initialize(s); }
-    else if(s > size())
-    { mem_clear(_M_data[0].address() + size(), (s - size()) * sizeof(ValueType)); }
-    else
+    // pointers and the iterators of Vector are copied as one block
+    using Contiguous = std::integral_constant<bool, std::is_convertible<_Iterator, ConstPointer>::value ||
+                                                    std::is_convertible<_Iterator, const_iterator>::value>;
+    SizeType i = _F_index(pos);
+    SizeType n = static_cast<SizeType>(std::distance(first, last));
+    if(n == 0)
+    { return begin() + static_cast<DifferenceType>(i); }
+    if(size() + n > capacity())
+    { _F_growth(size() + n); }
+    Pointer p = _F_data();
+    rapid::relocate(p + i + n, p + i, size() - i);
+    try
+    { _F_copy_range(p + i, first, n, Contiguous()); }
+    catch(...)
     {
-        mem_clear(_M_data[0].address() + s, (size() - s) * sizeof(ValueType));
+        rapid::relocate(p + i, p + i + n, size() - i);
+        throw;
+    }
+    _F_add_size(n);
+    return begin() + static_cast<DifferenceType>(i);
+}
+
+template<typename T, typename _Alloc>
+void Vector<T, _Alloc>::erase(const_iterator first, const_iterator last)
+{
+    SizeType i = _F_index(first), j = _F_index(last);
+    if(i >= j) return;
+    Pointer p = _F_data();
+    rapid::destroy(p + i, j - i);
+    rapid::relocate(p + i, p + j, size() - j);
+    _M_size -= j - i;
+}
+
+template<typename T, typename _Alloc>
+template<typename _Pred>
+typename Vector<T, _Alloc>::SizeType Vector<T, _Alloc>::erase_if(_Pred pred)
+{
+    Pointer p = _F_data();
+    SizeType n = size(), kept = 0, read = 0;
+    try
+    {
+        while(read < n)
+        {
+            // the elements kept are moved down a run at a time
+            SizeType run = read;
+            while(run < n && !pred(p[run]))
+            { ++run; }
+            rapid::relocate(p + kept, p + read, run - read);
+            kept += run - read;
+            read = run;
+            if(read < n)
+            { rapid::destroy(p + read++, 1); }
+        }
+    }
+    catch(...)
+    {
+        // the elements not visited yet are kept
+        rapid::relocate(p + kept, p + read, n - read);
+        _M_size = kept + n - read;
+        throw;
+    }
+    _M_size = kept;
+    return n - kept;
+}
+
+template<typename T, typename _Alloc>
+void Vector<T, _Alloc>::resize(SizeType s)
+{
+    if(s <= size())
+    {
+        rapid::destroy(_M_data[0].address() + s, size() - s);
         _M_size = s;
+        return;
     }
+    reserve(s);
+    for(; _M_size < s; ++_M_size)
+    { ::new(_M_data[_M_size].address()) ValueType(); }
 }
 
-template<typename T>
-typename Vector<T>::iterator Vector<T>::_F_find(ConstReference arg) const
+template<typename T, typename _Alloc>
+typename Vector<T, _Alloc>::iterator Vector<T, _Alloc>::_F_find(ConstReference arg) const
+{
+    // bitwise comparable elements of 1, 2, 4 or 8 bytes are searched by simd
+    using Bitwise = std::integral_constant<bool, IsBitwiseComparable<ValueType>::value &&
+        (sizeof(ValueType) == 1 || sizeof(ValueType) == 2 || sizeof(ValueType) == 4 || sizeof(ValueType) == 8)>;
+    SizeType i = _F_find_index(arg, Bitwise());
+    if(i < size())
+        return iterator(_F_data() + i);
+    return iterator(_F_data() + size());
+}
+
+template<typename T, typename _Alloc>
+typename Vector<T, _Alloc>::SizeType Vector<T, _Alloc>::_F_find_index(ConstReference arg, std::false_type) const
 {
     for(SizeType i = 0; i < size(); i++)
     {
         if(_M_data[i].content() == arg)
-            return iterator(i, size() - 1, _M_data[0].address());
+            return i;
     }
-    return end()._F_const_cast();
+    return size();
 }
 
+
+// the buffer is owned through a pointer, a Vector can be moved by copying its bytes
+template<typename T, typename _Alloc>
+struct IsTriviallyRelocatable<Vector<T, _Alloc>> : IsTriviallyRelocatable<_Alloc>
+{ };
+
 };
 
 #endif // VECTOR_H
@@ -30,6 +30,9 @@
 namespace rapid
 {
     using size_type = unsigned long long;
+
+    // byte size of a cache line, data written by different threads is kept this far apart
+    static constexpr size_type CacheLineSize = 64;
 }
 
 
@@ -0,0 +1,167 @@
+#ifndef WORKSTEALINGDEQUE_H
+#define WORKSTEALINGDEQUE_H
+
+#include "Core/Version.h"
+#include "Core/TypeTraits.h"
+#include "Core/Atomic.h"
+#include "Core/Allocator.h"
+
+namespace rapid
+{
+
+/* Chase-Lev work stealing deque
+ * the owner thread pushes and pops at the bottom like a stack, any other thread steals from
+ * the top, they only contend for the last element
+ * the ring grows when it is full, the old rings are kept until the deque is destroyed
+ * because a thief may still read one
+ * param[T]: trivially copyable, usually a pointer to a task
+ * param[_Alloc]: allocator of the rings
+ */
+template<typename T, typename _Alloc = ContainerAllocator<T, WorkStealingDequeStatsTag>>
+class WorkStealingDeque
+{
+public:
+    using ValueType = T;
+    using Reference = ValueType&;
+    using SizeType = size_type;
+    using AllocatorType = _Alloc;
+private:
+    static_assert(IsTriviallyCopyable<T>::value, "only support trivially copyable type");
+
+    using Index = long long;
+    using Item = Atomic<ValueType>;
+    using ItemAllocator = RebindAllocator<AllocatorType, Item>;
+    using ItemTraits = std::allocator_traits<ItemAllocator>;
+
+    struct Ring
+    {
+        Item *Items;
+        Index Mask;
+        Ring *Previous;
+    };
+
+    AllocatorType _M_alloc;
+    // next position to steal
+    Atomic<Index> _M_top;
+    char _M_padding_top[CacheLineSize - sizeof(Atomic<Index>)];
+    // next position to push, only written by the owner
+    Atomic<Index> _M_bottom;
+    Atomic<Ring *> _M_ring;
+    char _M_padding_bottom[CacheLineSize - sizeof(Atomic<Index>) - sizeof(Atomic<Ring *>)];
+
+    Ring* _F_create_ring(Index capacity, Ring *previous)
+    {
+        ItemAllocator a(_M_alloc);
+        Item *items = ItemTraits::allocate(a, static_cast<SizeType>(capacity));
+        for(Index i = 0; i < capacity; ++i)
+        { ::new(items + i) Item(); }
+        Ring *ring = allocate_object<Ring>(_M_alloc);
+        ring->Items = items;
+        ring->Mask = capacity - 1;
+        ring->Previous = previous;
+        return ring;
+    }
+    // copy [top, bottom) to a ring twice as large
+    Ring* _F_grow(Ring *ring, Index top, Index bottom)
+    {
+        Ring *bigger = _F_create_ring((ring->Mask + 1) * 2, ring);
+        for(Index i = top; i < bottom; ++i)
+        { bigger->Items[i & bigger->Mask].store(ring->Items[i & ring->Mask].load(MemoryOrder::Relaxed), MemoryOrder::Relaxed); }
+        _M_ring.store(bigger, MemoryOrder::Release);
+        return bigger;
+    }
+public:
+    // param[capacity]: initial capacity, rounded up to a power of 2
+    explicit WorkStealingDeque(SizeType capacity = 64, const AllocatorType &alloc = AllocatorType())
+        : _M_alloc(alloc), _M_top(0), _M_bottom(0)
+    {
+        Index n = 2;
+        while(static_cast<SizeType>(n) < capacity)
+        { n <<= 1; }
+        _M_ring.store(_F_create_ring(n, nullptr), MemoryOrder::Relaxed);
+    }
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque &) = delete;
+    ~WorkStealingDeque()
+    {
+        Ring *ring = _M_ring.load(MemoryOrder::Relaxed);
+        while(ring != nullptr)
+        {
+            Ring *previous = ring->Previous;
+            ItemAllocator a(_M_alloc);
+            ItemTraits::deallocate(a, ring->Items, static_cast<SizeType>(ring->Mask + 1));
+            release_object(_M_alloc, ring);
+            ring = previous;
+        }
+    }
+
+    // only the owner
+    void push(ValueType value)
+    {
+        Index bottom = _M_bottom.load(MemoryOrder::Relaxed);
+        Index top = _M_top.load(MemoryOrder::Acquire);
+        Ring *ring = _M_ring.load(MemoryOrder::Relaxed);
+        if(bottom - top > ring->Mask)
+        { ring = _F_grow(ring, top, bottom); }
+        ring->Items[bottom & ring->Mask].store(value, MemoryOrder::Relaxed);
+        _M_bottom.store(bottom + 1, MemoryOrder::Release);
+    }
+
+    /* take the element pushed last, only the owner
+     * return: false if it is empty
+     */
+    bool pop(Reference out)
+    {
+        Index bottom = _M_bottom.load(MemoryOrder::Relaxed) - 1;
+        Ring *ring = _M_ring.load(MemoryOrder::Relaxed);
+        // the store and the load below are not reordered, a thief sees the smaller bottom or loses the race
+        _M_bottom.store(bottom, MemoryOrder::SeqCst);
+        Index top = _M_top.load(MemoryOrder::SeqCst);
+        if(top > bottom)
+        {
+            _M_bottom.store(bottom + 1, MemoryOrder::Relaxed);
+            return false;
+        }
+        out = ring->Items[bottom & ring->Mask].load(MemoryOrder::Relaxed);
+        if(top == bottom)
+        {
+            // the last element, race with the thieves for it
+            bool won = _M_top.compare_exchange_strong(top, top + 1, MemoryOrder::SeqCst, MemoryOrder::Relaxed);
+            _M_bottom.store(bottom + 1, MemoryOrder::Relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /* take the element pushed first, any thread
+     * return: false if it is empty or another thread took the element first
+     */
+    bool steal(Reference out)
+    {
+        Index top = _M_top.load(MemoryOrder::SeqCst);
+        Index bottom = _M_bottom.load(MemoryOrder::SeqCst);
+        if(top >= bottom)
+        { return false; }
+        Ring *ring = _M_ring.load(MemoryOrder::Acquire);
+        ValueType value = ring->Items[top & ring->Mask].load(MemoryOrder::Relaxed);
+        if(!_M_top.compare_exchange_strong(top, top + 1, MemoryOrder::SeqCst, MemoryOrder::Relaxed))
+        { return false; }
+        out = value;
+        return true;
+    }
+
+    // exact only if no thread is using it
+    SizeType size() const
+    {
+        Index n = _M_bottom.load(MemoryOrder::Relaxed) - _M_top.load(MemoryOrder::Relaxed);
+        return n < 0 ? 0 : static_cast<SizeType>(n);
+    }
+    bool empty() const
+    { return size() == 0; }
+    SizeType capacity() const
+    { return static_cast<SizeType>(_M_ring.load(MemoryOrder::Relaxed)->Mask + 1); }
+};
+
+};
+
+#endif // WORKSTEALINGDEQUE_H
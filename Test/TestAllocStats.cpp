@@ -0,0 +1,45 @@
+#include "TestAllocStats.h"
+#include "Core/AllocStats.h"
+#include "Core/Allocator.h"
+#include "Core/Map.h"
+#include "Core/Vector.h"
+#include "Core/Matrix.h"
+#include <iostream>
+
+namespace rapid
+{
+REGIST_STATS_TAG(TestMap);
+}
+
+void rapid::test_AllocStats_main()
+{
+    std::cout << "************debug AllocStats begin************" << std::endl;
+    using Alloc = StatsAllocator<Pair<int, int>, TestMapStatsTag, Allocator<Pair<int, int>>>;
+    {
+        Map<int, int, Compare<Pair<int, int>>, Alloc> m;
+        for(int i = 0; i < 100; ++i)
+        { m[i] = i; }
+        AllocStats *stats = alloc_stats_find("TestMap");
+        std::cout << "live bytes > 0: " << (stats->LiveBytes > 0) << ", allocations: " << stats->Allocations << std::endl;
+        for(int i = 0; i < 50; ++i)
+        { m.erase(m.find(i)); }
+        std::cout << "deallocations: " << stats->Deallocations << std::endl;
+    }
+    AllocStats &stats = alloc_stats_of<TestMapStatsTag>();
+    std::cout << "live bytes after destruction: " << stats.LiveBytes << ", peak bytes > 0: " << (stats.PeakBytes > 0) << std::endl;
+
+    // the default allocators only record when RAPID_ALLOC_STATS is defined
+    Vector<int> v;
+    for(int i = 0; i < 1000; ++i)
+    { v.push_back(i); }
+    Matrix<double> matrix(10, 10);
+    matrix.clear();
+#if defined(RAPID_ALLOC_STATS)
+    std::cout << "vector recorded: " << (alloc_stats_find("Vector") != nullptr) << std::endl;
+    std::cout << "matrix recorded: " << (alloc_stats_find("Matrix") != nullptr) << std::endl;
+#endif
+    alloc_stats_dump(std::cout);
+    alloc_stats_reset();
+    std::cout << "allocations after reset: " << stats.Allocations << std::endl;
+    std::cout << "************debug AllocStats end************" << std::endl;
+}
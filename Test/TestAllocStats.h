@@ -0,0 +1,9 @@
+#ifndef TESTALLOCSTATS_H
+#define TESTALLOCSTATS_H
+
+namespace rapid
+{
+void test_AllocStats_main();
+}
+
+#endif // TESTALLOCSTATS_H
@@ -0,0 +1,75 @@
+#include "TestArena.h"
+#include "Core/Arena.h"
+#include "Core/Map.h"
+#include "Core/Set.h"
+#include "Core/Stack.h"
+#include "Core/SingleLinkedList.h"
+#include "Core/DoubleLinkedList.h"
+#include "Core/Vector.h"
+#include "Core/Exception.h"
+#include <iostream>
+#include <string>
+
+void rapid::test_Arena_main()
+{
+    std::cout << "************debug Arena begin************" << std::endl;
+    Arena arena(4096);
+    int *p = arena.create<int>(10);
+    std::cout << "create int: " << *p << std::endl;
+    double *d = static_cast<double *>(arena.allocate(sizeof(double) * 4, alignof(double)));
+    std::cout << "aligned: " << (reinterpret_cast<unsigned long>(d) % alignof(double) == 0) << std::endl;
+    std::cout << "used: " << arena.used() << ", capacity: " << arena.capacity() << std::endl;
+    {
+        Map<int, std::string, Compare<Pair<int, std::string>>, ArenaAllocator<Pair<int, std::string>>> m{ArenaAllocator<int>(arena)};
+        for(int i = 0; i < 100; ++i)
+        {
+            std::string value = std::to_string(i * i);
+            m[i] = value;
+        }
+        std::cout << "map size: " << m.size() << ", m[9] = " << m[9] << std::endl;
+        m.erase(m.find(9));
+        std::cout << "map size after erase: " << m.size() << std::endl;
+
+        Set<int, Compare<int>, ArenaAllocator<int>> s{ArenaAllocator<int>(arena)};
+        for(int i = 0; i < 100; i += 3)
+        { s.insert(i); }
+        std::cout << "set size: " << s.size() << ", find 30: " << (s.find(30) != s.end()) << std::endl;
+
+        Stack<int, ArenaAllocator<int>> st{ArenaAllocator<int>(arena)};
+        for(int i = 0; i < 10; ++i)
+        { st.push(i); }
+        std::cout << "stack top: " << st.top() << ", size: " << st.size() << std::endl;
+
+        Slist<int, ArenaAllocator<int>> sl{ArenaAllocator<int>(arena)};
+        for(int i = 0; i < 10; ++i)
+        { sl.push_front(i); }
+        std::cout << "slist front: " << sl.front() << ", size: " << sl.size() << std::endl;
+
+        List<std::string, ArenaAllocator<std::string>> dl{ArenaAllocator<std::string>(arena)};
+        const std::string a = "a", b = "b", c = "c";
+        dl.push_back(a);
+        dl.push_back(b);
+        dl.push_front(c);
+        for(auto it = dl.begin(); it != dl.end(); ++it)
+        { std::cout << *it << " "; }
+        std::cout << std::endl;
+
+        Vector<int, ArenaAllocator<int>> v{ArenaAllocator<int>(arena)};
+        for(int i = 0; i < 100; ++i)
+        { v.push_back(i); }
+        std::cout << "vector size: " << v.size() << ", v[50] = " << v[50] << std::endl;
+        std::cout << "used: " << arena.used() << ", capacity: " << arena.capacity() << std::endl;
+    }
+    arena.reset();
+    std::cout << "after reset used: " << arena.used() << ", capacity: " << arena.capacity() << std::endl;
+
+    Arena fixed(256, false);
+    try
+    {
+        for(int i = 0; i < 100; ++i)
+        { fixed.allocate(16); }
+    }
+    catch(OutOfMemoryException &e)
+    { std::cout << "fixed arena: " << e.what() << std::endl; }
+    std::cout << "************debug Arena end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTARENA_H
+#define TESTARENA_H
+
+namespace rapid
+{
+void test_Arena_main();
+}
+
+#endif // TESTARENA_H
@@ -0,0 +1,74 @@
+#include "TestAtomic.h"
+#include "Core/Atomic.h"
+#include <iostream>
+#include <thread>
+
+namespace
+{
+// 12 bytes, the atomic storage is aligned to 16, its operations need libatomic
+struct Triple
+{ int a, b, c; };
+// 8 bytes of 4 byte members, the atomic storage is aligned to 8 and lock free
+struct Pair
+{ int a, b; };
+}
+
+void rapid::test_Atomic_main()
+{
+    std::cout << "************debug Atomic begin************" << std::endl;
+    Atomic<long> a(10);
+    std::cout << "lock free: " << a.is_lock_free() << std::endl;
+    std::cout << "load: " << a.load(MemoryOrder::Acquire) << std::endl;
+    a.store(20, MemoryOrder::Release);
+    std::cout << "store: " << a << std::endl;
+    std::cout << "exchange: " << a.exchange(30) << " -> " << a << std::endl;
+    long expected = 0;
+    bool done = a.compare_exchange_strong(expected, 40);
+    std::cout << "compare_exchange_strong: " << done << " expected " << expected << std::endl;
+    done = a.compare_exchange_strong(expected, 40, MemoryOrder::AcqRel);
+    std::cout << "compare_exchange_strong: " << done << " value " << a << std::endl;
+    std::cout << "fetch_add: " << a.fetch_add(5, MemoryOrder::Relaxed) << " -> " << a << std::endl;
+    std::cout << "fetch_max: " << a.fetch_max(100) << " -> " << a << std::endl;
+    std::cout << "fetch_max: " << a.fetch_max(50) << " -> " << a << std::endl;
+    std::cout << "fetch_min: " << a.fetch_min(-1) << " -> " << a << std::endl;
+    std::cout << "operator: " << ++a << " " << a++ << " " << (a += 10) << " " << (a |= 16) << std::endl;
+    std::cout << "---------------------" << std::endl;
+    // a relaxed counter and a release/acquire publication flag
+    Atomic<unsigned long> counter;
+    Atomic<bool> ready;
+    long payload = 0;
+    std::thread writer([&]()
+    {
+        payload = 42;
+        ready.store(true, MemoryOrder::Release);
+    });
+    std::thread readers[4];
+    for(auto &t : readers)
+    {
+        t = std::thread([&]()
+        {
+            for(int i = 0; i < 10000; ++i)
+            { counter.fetch_add(1, MemoryOrder::Relaxed); }
+        });
+    }
+    while(!ready.load(MemoryOrder::Acquire))
+    { std::this_thread::yield(); }
+    std::cout << "payload: " << payload << std::endl;
+    writer.join();
+    for(auto &t : readers)
+    { t.join(); }
+    std::cout << "counter: " << counter << std::endl;
+    std::cout << "---------------------" << std::endl;
+    std::cout << "odd size: " << sizeof(Atomic<Triple>) << " align " << alignof(Atomic<Triple>) << std::endl;
+    Atomic<Pair> pair(Pair{1, 2});
+    std::cout << "struct size: " << sizeof(pair) << " align " << alignof(Atomic<Pair>)
+              << " lock free " << pair.is_lock_free() << std::endl;
+    Pair old = pair.exchange(Pair{3, 4});
+    Pair now = pair.load(MemoryOrder::Acquire);
+    std::cout << "exchange: " << old.a << old.b << " -> " << now.a << now.b << std::endl;
+    Pair want{3, 4};
+    done = pair.compare_exchange_strong(want, Pair{5, 6});
+    now = pair.load();
+    std::cout << "compare_exchange_strong: " << done << " value " << now.a << now.b << std::endl;
+    std::cout << "************debug Atomic end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTATOMIC_H
+#define TESTATOMIC_H
+
+namespace rapid
+{
+void test_Atomic_main();
+}
+
+#endif // TESTATOMIC_H
@@ -0,0 +1,86 @@
+#include "TestConcurrentStack.h"
+#include "Core/ConcurrentStack.h"
+#include "Core/Stack.h"
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr long ITEMS = 200000;
+
+/* every thread pushes its part of [0, ITEMS) and pops as much as it can, a task is
+ * popped by whichever thread comes first, like a pool of work
+ * return: million operations per second
+ */
+template<typename _Push, typename _Pop>
+static double run_pool(int threads, _Push push, _Pop pop)
+{
+    std::vector<std::thread> workers;
+    std::vector<long> sums(threads, 0);
+    auto begin = std::chrono::steady_clock::now();
+    for(int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([=, &sums]()
+        {
+            long value, sum = 0;
+            for(long i = t; i < ITEMS; i += threads)
+            {
+                push(i);
+                if(pop(value)) sum += value;
+            }
+            while(pop(value))
+            { sum += value; }
+            sums[t] = sum;
+        });
+    }
+    for(std::thread &w : workers)
+    { w.join(); }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    long sum = 0;
+    for(long s : sums)
+    { sum += s; }
+    if(sum != ITEMS * (ITEMS - 1) / 2)
+    { std::cout << "lost tasks" << std::endl; }
+    return 2.0 * ITEMS / seconds / 1e6;
+}
+
+void rapid::test_ConcurrentStack_main()
+{
+    std::cout << "************debug ConcurrentStack begin************" << std::endl;
+    ConcurrentStack<std::string> s;
+    std::cout << "empty: " << s.empty() << std::endl;
+    for(int i = 0; i < 4; ++i)
+    { s.push(std::to_string(i) + std::string(20, '.')); }
+    std::string str;
+    while(s.try_pop(str))
+    { std::cout << "pop: " << str << std::endl; }
+    std::cout << "empty: " << s.empty() << std::endl;
+    // the nodes not popped are freed by the destructor
+    s.push("left");
+    std::cout << "---------------------" << std::endl;
+    unsigned threads = std::thread::hardware_concurrency();
+    if(threads < 2) threads = 2;
+    if(threads > 8) threads = 8;
+    ConcurrentStack<long> stack;
+    double lock_free = run_pool(static_cast<int>(threads),
+        [&stack](long v) { stack.push(v); },
+        [&stack](long &v) { return stack.try_pop(v); });
+    Stack<long> locked_stack;
+    std::mutex mutex;
+    double locked = run_pool(static_cast<int>(threads),
+        [&](long v) { std::lock_guard<std::mutex> lock(mutex); locked_stack.push(v); },
+        [&](long &v)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(locked_stack.empty()) return false;
+            v = locked_stack.top();
+            locked_stack.pop();
+            return true;
+        });
+    std::cout << "work pool of " << threads << " threads: ConcurrentStack " << lock_free
+              << " M/s, Stack with mutex " << locked << " M/s" << std::endl;
+    std::cout << "hazard records: " << hazard_record_count() << std::endl;
+    std::cout << "************debug ConcurrentStack end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTCONCURRENTSTACK_H
+#define TESTCONCURRENTSTACK_H
+
+namespace rapid
+{
+void test_ConcurrentStack_main();
+}
+
+#endif // TESTCONCURRENTSTACK_H
@@ -0,0 +1,136 @@
+#include "TestDeque.h"
+#include "Core/Deque.h"
+#include "Core/Vector.h"
+#include "Core/DoubleLinkedList.h"
+#include "Core/AllocStats.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace rapid
+{
+REGIST_STATS_TAG(TestDeque);
+}
+
+template<typename _Container>
+static void print_deque(const _Container &d)
+{
+    for(const auto &value : d)
+    { std::cout << value << " "; }
+    std::cout << std::endl;
+}
+
+void rapid::test_Deque_main()
+{
+    std::cout << "************debug Deque begin************" << std::endl;
+    Deque<int> d{3, 4, 5};
+    d.push_front(2);
+    d.push_front(1);
+    d.push_back(6);
+    print_deque(d);
+    d.pop_front();
+    d.pop_back();
+    std::cout << "front: " << d.front() << ", back: " << d.back() << ", d[2]: " << d[2]
+              << ", block size: " << Deque<int>::BlockSize << std::endl;
+    for(auto it = d.rbegin(); it != d.rend(); ++it)
+    { std::cout << *it << " "; }
+    std::cout << std::endl;
+    try
+    { d.at(10); }
+    catch(IndexOutOfArrayException &e)
+    { std::cout << e.what() << std::endl; }
+    std::cout << "---------------------" << std::endl;
+    // elements do not move while the deque grows at both ends
+    Deque<long> big;
+    big.push_back(0);
+    long *first = &big.front();
+    for(long i = 1; i <= 10000; ++i)
+    {
+        big.push_back(i);
+        big.push_front(-i);
+    }
+    std::cout << "size: " << big.size() << ", address kept: " << (first == &big[10000]) << ", *first: " << *first
+              << ", map slots: " << big.map_size() << std::endl;
+    std::sort(big.begin(), big.end(), [](long a, long b) { return a > b; });
+    std::cout << "sorted descending: " << big.front() << " ... " << big.back()
+              << ", end - begin: " << (big.end() - big.begin()) << std::endl;
+    Deque<long> copy(big);
+    Deque<long> moved(rapid::move(big));
+    std::cout << "copy: " << copy.size() << ", moved: " << moved.size() << ", source: " << big.size() << std::endl;
+    moved.clear();
+    moved.shrink_to_fit();
+    std::cout << "after shrink: map slots " << moved.map_size() << ", spare blocks " << moved.spare_blocks() << std::endl;
+    Deque<std::string> words;
+    for(const char *w : {"deque", "of", "long", "enough", "strings"})
+    {
+        words.emplace_back(std::string(w) + std::string(20, '.'));
+        words.emplace_front(std::string(w));
+    }
+    words.pop_back();
+    words.pop_front();
+    print_deque(words);
+    std::cout << "---------------------" << std::endl;
+    // a sliding window reuses its blocks, the allocations stop once it is full
+    using Alloc = StatsAllocator<int, TestDequeStatsTag, Allocator<int>>;
+    AllocStats &stats = alloc_stats_of<TestDequeStatsTag>();
+    {
+        Deque<int, Alloc> window;
+        for(int i = 0; i < 1000; ++i)
+        { window.push_back(i); }
+        size_type warm = stats.Allocations;
+        long sum = 0;
+        for(int i = 1000; i < 1000000; ++i)
+        {
+            sum += window.front();
+            window.pop_front();
+            window.push_back(i);
+        }
+        std::cout << "window sum: " << sum << ", allocations while sliding: " << stats.Allocations - warm << std::endl;
+    }
+    std::cout << "live bytes after destruction: " << stats.LiveBytes << std::endl;
+    std::cout << "---------------------" << std::endl;
+    const int N = 20000;
+    auto begin = std::chrono::steady_clock::now();
+    Vector<int> v;
+    for(int i = 0; i < N; ++i)
+    { v.push_front(i); }
+    double vector_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    begin = std::chrono::steady_clock::now();
+    Deque<int> q;
+    for(int i = 0; i < N; ++i)
+    { q.push_front(i); }
+    double deque_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << N << " push_front, same: " << std::equal(q.begin(), q.end(), v.begin()) << ", Vector "
+              << vector_time << "s, Deque " << deque_time << "s" << std::endl;
+    const int M = 1000000;
+    begin = std::chrono::steady_clock::now();
+    DoubleLinkedList<int> list;
+    long list_sum = 0;
+    for(int i = 0; i < M; ++i)
+    {
+        list.push_back(i);
+        if(i % 2 == 1)
+        {
+            list_sum += list.front();
+            list.pop_front();
+        }
+    }
+    double list_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    begin = std::chrono::steady_clock::now();
+    Deque<int> fifo;
+    long fifo_sum = 0;
+    for(int i = 0; i < M; ++i)
+    {
+        fifo.push_back(i);
+        if(i % 2 == 1)
+        {
+            fifo_sum += fifo.front();
+            fifo.pop_front();
+        }
+    }
+    double fifo_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << M << " FIFO pushes, same: " << (list_sum == fifo_sum) << ", DoubleLinkedList " << list_time
+              << "s, Deque " << fifo_time << "s" << std::endl;
+    std::cout << "************debug Deque end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTDEQUE_H
+#define TESTDEQUE_H
+
+namespace rapid
+{
+void test_Deque_main();
+}
+
+#endif // TESTDEQUE_H
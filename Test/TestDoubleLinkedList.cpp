@@ -44,4 +44,10 @@ void rapid::test_DoubleLinkedList_main()
     {
         std::cout << i << " ";
     }
+    std::cout << std::endl;
+    DoubleLinkedList<int> empty_list;
+    try
+    { empty_list.back(); }
+    catch(const IndexOutOfArrayException &)
+    { std::cout << "back of an empty list throws" << std::endl; }
 }
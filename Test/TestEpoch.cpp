@@ -0,0 +1,106 @@
+#include "TestEpoch.h"
+#include "Core/Epoch.h"
+#include "Core/Map.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct Tracked
+{
+    static rapid::Atomic<long> Live;
+    Tracked() { ++Live; }
+    Tracked(const Tracked &) { ++Live; }
+    ~Tracked() { --Live; }
+};
+rapid::Atomic<long> Tracked::Live(0);
+}
+
+static constexpr int KEYS = 64;
+
+void rapid::test_Epoch_main()
+{
+    std::cout << "************debug Epoch begin************" << std::endl;
+    {
+        EpochGuard outer;
+        EpochGuard inner;
+        std::cout << "pinned: " << epoch_pinned() << std::endl;
+    }
+    std::cout << "pinned: " << epoch_pinned() << std::endl;
+    for(int i = 0; i < 10; ++i)
+    { epoch_retire(new Tracked()); }
+    std::cout << "live: " << Tracked::Live << ", pending: " << epoch_pending() << std::endl;
+    // a pinned thread holds the epoch back, nothing is reclaimed until it unpins
+    Atomic<int> step(0);
+    std::thread reader([&step]()
+    {
+        EpochGuard guard;
+        step.store(1);
+        while(step.load() != 2)
+        { std::this_thread::yield(); }
+    });
+    while(step.load() != 1)
+    { std::this_thread::yield(); }
+    epoch_retire(new Tracked());
+    for(int i = 0; i < 4; ++i)
+    { epoch_collect(); }
+    std::cout << "reader pinned, live: " << Tracked::Live << ", pending: " << epoch_pending() << std::endl;
+    step.store(2);
+    reader.join();
+    epoch_synchronize();
+    std::cout << "synchronized, live: " << Tracked::Live << ", pending: " << epoch_pending() << std::endl;
+    std::cout << "---------------------" << std::endl;
+    // a lookup table read by several threads while it is updated
+    Map<int, long> init;
+    for(int k = 0; k < KEYS; ++k)
+    { init[k] = 0; }
+    EpochSnapshot<Map<int, long>> table(init);
+    Atomic<bool> stop(false);
+    Atomic<long> reads(0), torn(0);
+    std::vector<std::thread> readers;
+    for(int t = 0; t < 3; ++t)
+    {
+        readers.emplace_back([&]()
+        {
+            long count = 0;
+            while(!stop.load(MemoryOrder::Relaxed))
+            {
+                // every version has the same value at all keys
+                bool same = table.read([](const Map<int, long> &m)
+                {
+                    long first = m.find(0)->Second;
+                    for(int k = 1; k < KEYS; ++k)
+                    {
+                        if(m.find(k)->Second != first)
+                        { return false; }
+                    }
+                    return true;
+                });
+                if(!same) ++torn;
+                ++count;
+            }
+            reads += count;
+        });
+    }
+    auto begin = std::chrono::steady_clock::now();
+    const long updates = 2000;
+    for(long u = 1; u <= updates; ++u)
+    {
+        table.update([](Map<int, long> &m)
+        {
+            for(int k = 0; k < KEYS; ++k)
+            { m[k] += 1; }
+        });
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    stop.store(true);
+    for(std::thread &r : readers)
+    { r.join(); }
+    epoch_synchronize();
+    std::cout << "final value: " << table.read([](const Map<int, long> &m) { return m.find(KEYS - 1)->Second; })
+              << ", torn reads: " << torn << ", pending: " << epoch_pending() << std::endl;
+    std::cout << "updates: " << updates / seconds << " /s, reads while updating: " << reads.load() / seconds << " /s" << std::endl;
+    std::cout << "************debug Epoch end************" << std::endl;
+}
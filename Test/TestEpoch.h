@@ -0,0 +1,9 @@
+#ifndef TESTEPOCH_H
+#define TESTEPOCH_H
+
+namespace rapid
+{
+void test_Epoch_main();
+}
+
+#endif // TESTEPOCH_H
@@ -0,0 +1,107 @@
+#include "TestMPMCQueue.h"
+#include "Core/MPMCQueue.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr long ITEMS = 1000000;
+
+/* [threads] producers and [threads] consumers move ITEMS numbers through [queue]
+ * param[batch]: elements of one push_n or pop_n, 1 uses try_push and try_pop
+ * return: million elements per second
+ */
+static double run_throughput(rapid::MPMCQueue<long> &queue, int threads, long batch)
+{
+    long per_producer = ITEMS / threads;
+    std::vector<std::thread> workers;
+    std::vector<long> sums(static_cast<unsigned long>(threads), 0);
+    auto begin = std::chrono::steady_clock::now();
+    for(int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&queue, per_producer, batch]()
+        {
+            std::vector<long> buffer(static_cast<unsigned long>(batch));
+            for(long i = 0; i < per_producer;)
+            {
+                if(batch == 1)
+                {
+                    if(queue.try_push(i)) ++i;
+                    else std::this_thread::yield();
+                    continue;
+                }
+                long n = per_producer - i < batch ? per_producer - i : batch;
+                for(long k = 0; k < n; ++k)
+                { buffer[static_cast<unsigned long>(k)] = i + k; }
+                long pushed = static_cast<long>(queue.push_n(buffer.data(), static_cast<rapid::size_type>(n)));
+                if(pushed == 0) std::this_thread::yield();
+                i += pushed;
+            }
+        });
+        workers.emplace_back([&queue, &sums, t, per_producer, batch]()
+        {
+            std::vector<long> buffer(static_cast<unsigned long>(batch));
+            long sum = 0;
+            for(long received = 0; received < per_producer;)
+            {
+                long n = per_producer - received < batch ? per_producer - received : batch;
+                long popped = static_cast<long>(queue.pop_n(buffer.data(), static_cast<rapid::size_type>(n)));
+                if(popped == 0) std::this_thread::yield();
+                for(long k = 0; k < popped; ++k)
+                { sum += buffer[static_cast<unsigned long>(k)]; }
+                received += popped;
+            }
+            sums[static_cast<unsigned long>(t)] = sum;
+        });
+    }
+    for(auto &w : workers)
+    { w.join(); }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    long total = 0, expected = threads * (per_producer * (per_producer - 1) / 2);
+    for(long s : sums)
+    { total += s; }
+    if(total != expected)
+    { std::cout << "lost elements: " << total << " != " << expected << std::endl; }
+    return static_cast<double>(per_producer * threads) / seconds / 1e6;
+}
+
+void rapid::test_MPMCQueue_main()
+{
+    std::cout << "************debug MPMCQueue begin************" << std::endl;
+    MPMCQueue<std::string> q(5);
+    std::cout << "capacity: " << q.capacity() << std::endl;
+    for(int i = 0; i < 10; ++i)
+    {
+        if(!q.try_push(std::to_string(i) + std::string(20, '.')))
+        {
+            std::cout << "full after " << i << " elements" << std::endl;
+            break;
+        }
+    }
+    std::string s;
+    q.try_pop(s);
+    std::cout << "pop: " << s << ", size: " << q.size() << std::endl;
+    std::string batch[4];
+    std::cout << "pop_n: " << q.pop_n(batch, 4) << " " << batch[0] << " " << batch[3] << std::endl;
+    const std::string more[3] = {"x", "y", "z"};
+    std::cout << "push_n: " << q.push_n(more, 3) << ", size: " << q.size() << std::endl;
+    while(q.try_pop(s))
+    { std::cout << s << " "; }
+    std::cout << std::endl << "empty: " << q.empty() << std::endl;
+    q.try_emplace(3, 'a');
+    std::cout << "left in queue: " << q.size() << std::endl;
+    std::cout << "---------------------" << std::endl;
+    // throughput, the same number of producers and consumers
+    unsigned int cores = std::thread::hardware_concurrency();
+    int max_threads = cores > 4 ? static_cast<int>(cores) : 4;
+    for(int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        MPMCQueue<long> queue(1024);
+        double single = run_throughput(queue, threads, 1);
+        double batched = run_throughput(queue, threads, 32);
+        std::cout << threads << " producers + " << threads << " consumers: "
+                  << single << " M/s, batch of 32: " << batched << " M/s" << std::endl;
+    }
+    std::cout << "************debug MPMCQueue end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTMPMCQUEUE_H
+#define TESTMPMCQUEUE_H
+
+namespace rapid
+{
+void test_MPMCQueue_main();
+}
+
+#endif // TESTMPMCQUEUE_H
@@ -0,0 +1,66 @@
+#include "TestMalloc.h"
+#include "Core/Malloc.h"
+#include "Core/Vector.h"
+#include <iostream>
+#include <string>
+#include <thread>
+
+void rapid::test_Malloc_main()
+{
+    std::cout << "************debug Malloc begin************" << std::endl;
+    void *p1 = rapid::malloc(10);
+    void *p2 = rapid::malloc(200);
+    void *p3 = rapid::malloc(100000);
+    std::cout << "usable size of 10 >= 10: " << (malloc_usable_size(p1) >= 10) << std::endl;
+    std::cout << "usable size of 200 >= 200: " << (malloc_usable_size(p2) >= 200) << std::endl;
+    std::cout << "usable size of 100000 >= 100000: " << (malloc_usable_size(p3) >= 100000) << std::endl;
+    rapid::free(p1);
+    void *p4 = rapid::malloc(16);
+
+    char *s = static_cast<char *>(rapid::malloc(6));
+    for(int i = 0; i < 5; ++i)
+    { s[i] = static_cast<char>('a' + i); }
+    s[5] = '\0';
+    s = static_cast<char *>(rapid::realloc(s, 1000));
+    std::cout << "realloc content: " << s << ", usable size >= 1000: " << (malloc_usable_size(s) >= 1000) << std::endl;
+    rapid::free(s);
+    rapid::free(p2);
+    rapid::free(p3);
+    rapid::free(p4);
+
+    // a mid size gets whole pages, not a span of 256K
+    char *mid = static_cast<char *>(rapid::malloc(33 * 1024));
+    mid[0] = 'm';
+    std::cout << "usable size of 33K < 40K: " << (malloc_usable_size(mid) < 40 * 1024) << std::endl;
+    mid = static_cast<char *>(rapid::realloc(mid, 300 * 1024));
+    mid[300 * 1024 - 1] = 'e';
+    mid = static_cast<char *>(rapid::realloc(mid, 64));
+    std::cout << "mid content after grow and shrink: " << mid[0] << ", usable size: " << malloc_usable_size(mid) << std::endl;
+    rapid::free(mid);
+
+    std::string *strs = malloc_array<std::string>(3);
+    strs[0] = "abc";
+    strs[2] = "xyz";
+    std::cout << "array: " << strs[0] << strs[1] << strs[2] << std::endl;
+    free_array(strs, 3);
+
+    // memory of one thread is freed by another one
+    void *shared[100];
+    std::thread producer([&shared](){
+        for(int i = 0; i < 100; ++i)
+        { shared[i] = rapid::malloc(static_cast<size_type>(i * 8 + 1)); }
+    });
+    producer.join();
+    std::thread consumer([&shared](){
+        for(int i = 0; i < 100; ++i)
+        { rapid::free(shared[i]); }
+    });
+    consumer.join();
+
+    Vector<int> v;
+    for(int i = 0; i < 1000; ++i)
+    { v.push_back(i); }
+    std::cout << "vector on rapid::malloc, v[999] = " << v[999] << std::endl;
+    malloc_flush_thread_cache();
+    std::cout << "************debug Malloc end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTMALLOC_H
+#define TESTMALLOC_H
+
+namespace rapid
+{
+void test_Malloc_main();
+}
+
+#endif // TESTMALLOC_H
@@ -20,6 +20,7 @@ void rapid::test_Memory_main()
     TestType *b = new TestType[blen];
     TestType *c = new TestType[clen]{0};
     std::cout << "---------------start-------------" << std::endl;
+    std::cout << "simd width: " << mem_simd_width() << std::endl;
     print(b, blen);
     std::cout << "---------------mem_clear-------------" << std::endl;
     mem_clear(b, blen * sizeof(TestType));
@@ -39,6 +40,40 @@ void rapid::test_Memory_main()
     std::cout << "***************************" << std::endl;
     mem_scopy(c, reinterpret_cast<char *>(c) + 12, 20);
     print(c, clen);
+    std::cout << "------------mem_compare----------------" << std::endl;
+    std::cout << mem_compare(a, c, alen * sizeof(TestType)) << " "
+              << mem_compare(a, a, alen * sizeof(TestType)) << std::endl;
+    std::cout << "------------mem_swap----------------" << std::endl;
+    mem_swap(a, c, alen * sizeof(TestType));
+    print(a, alen);
+    print(c, clen);
+    std::cout << "------------mem_stream_copy----------------" << std::endl;
+    std::cout << "stream threshold: " << mem_stream_threshold() << std::endl;
+    mem_stream_copy(c, a, alen * sizeof(TestType));
+    print(c, clen);
+    std::cout << "------------mem_stream_clear----------------" << std::endl;
+    mem_stream_clear(c, clen * sizeof(TestType));
+    print(c, clen);
+    std::cout << "------------mem_find----------------" << std::endl;
+    const char text[] = "the quick brown fox jumps over the lazy dog, the quick brown fox";
+    const size_type text_size = sizeof(text) - 1;
+    std::cout << static_cast<const char *>(mem_find(text, 'x', text_size)) - text << " "
+              << (mem_find(text, 'Z', text_size) == nullptr) << std::endl;
+    std::cout << "------------mem_find_pattern----------------" << std::endl;
+    std::cout << static_cast<const char *>(mem_find_pattern(text, text_size, "lazy", 4)) - text << " "
+              << static_cast<const char *>(mem_find_pattern(text, text_size, "the quick", 9)) - text << " "
+              << (mem_find_pattern(text, text_size, "quick fox", 9) == nullptr) << std::endl;
+    std::cout << "------------mem_count----------------" << std::endl;
+    std::cout << mem_count(text, 'o', text_size) << " " << mem_count(text, ' ', text_size) << std::endl;
+    std::cout << "------------mem_find_element----------------" << std::endl;
+    TestType value = 5;
+    std::cout << mem_find_element(a, alen, &value, sizeof(TestType)) << " ";
+    value = 100;
+    std::cout << mem_find_element(a, alen, &value, sizeof(TestType)) << std::endl;
+    std::cout << "------------mem_hash----------------" << std::endl;
+    std::cout << (mem_hash(text, text_size) == mem_hash(text, text_size)) << " "
+              << (mem_hash(text, text_size) != mem_hash(text, text_size, 1)) << " "
+              << (mem_hash(text, text_size) != mem_hash(text + 1, text_size - 1)) << std::endl;
     delete[] a;
     delete[] b;
     delete[] c;
@@ -0,0 +1,109 @@
+#include "TestObjectPool.h"
+#include "Core/ObjectPool.h"
+#include "Core/Map.h"
+#include "Core/SPSCQueue.h"
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+struct Message
+{ long Value[4]; };
+// aligned beyond what ::operator new guarantees
+struct alignas(64) Line
+{ char Data[64]; };
+}
+
+void rapid::test_ObjectPool_main()
+{
+    std::cout << "************debug ObjectPool begin************" << std::endl;
+    ObjectPool<std::string> pool(4);
+    std::string *s1 = pool.create("first");
+    std::string *s2 = pool.create("second");
+    std::cout << *s1 << " " << *s2 << ", capacity: " << pool.capacity() << std::endl;
+    pool.destroy(s1);
+    std::string *s3 = pool.create("third");
+    std::cout << "freed memory reused: " << (s3 == s1) << std::endl;
+    for(int i = 0; i < 10; ++i)
+    { pool.create("x"); }
+    std::cout << "capacity after growing: " << pool.capacity() << std::endl;
+    pool.destroy(s2);
+    pool.destroy(s3);
+
+    ObjectPool<int> other;
+    int *p = other.create(10);
+    std::cout << "create int: " << *p << std::endl;
+    ObjectPool<int> merged;
+    merged.merge(other);
+    merged.deallocate(p);
+    std::cout << "merged capacity: " << merged.capacity() << ", source capacity: " << other.capacity() << std::endl;
+
+    Map<int, int> m;
+    for(int r = 0; r < 3; ++r)
+    {
+        for(int i = 0; i < 1000; ++i)
+        { m[i] = i * 2; }
+        for(int i = 0; i < 1000; ++i)
+        { m.erase(m.find(i)); }
+    }
+    m[7] = 14;
+    std::cout << "map churn size: " << m.size() << ", m[7] = " << m[7] << std::endl;
+    std::cout << "---------------------" << std::endl;
+    {
+        ObjectPool<Line> lines(3);
+        PoolAllocator<Line> alloc;
+        bool aligned = true;
+        Line *kept[10];
+        for(int i = 0; i < 10; ++i)
+        {
+            kept[i] = lines.allocate();
+            aligned = aligned && reinterpret_cast<unsigned long>(kept[i]) % alignof(Line) == 0;
+        }
+        Line *single = alloc.allocate(1);
+        Line *array = alloc.allocate(5);
+        aligned = aligned && reinterpret_cast<unsigned long>(single) % alignof(Line) == 0 &&
+                  reinterpret_cast<unsigned long>(array) % alignof(Line) == 0;
+        alloc.deallocate(array, 5);
+        alloc.deallocate(single, 1);
+        for(Line *l : kept)
+        { lines.deallocate(l); }
+        std::cout << "over-aligned objects aligned: " << aligned << std::endl;
+    }
+    std::cout << "---------------------" << std::endl;
+    // one thread allocates, another frees, at most 1024 objects are alive at a time
+    {
+        using Alloc = PoolAllocator<Message>;
+        constexpr long Count = 1000000;
+        SPSCQueue<Message *> queue(1024);
+        long sum = 0;
+        std::thread producer([&]()
+        {
+            Alloc alloc;
+            for(long i = 0; i < Count; ++i)
+            {
+                Message *m = alloc.allocate(1);
+                m->Value[0] = i;
+                while(!queue.try_push(m))
+                { std::this_thread::yield(); }
+            }
+        });
+        std::thread consumer([&]()
+        {
+            Alloc alloc;
+            Message *m = nullptr;
+            for(long i = 0; i < Count; ++i)
+            {
+                while(!queue.try_pop(m))
+                { std::this_thread::yield(); }
+                sum += m->Value[0];
+                alloc.deallocate(m, 1);
+            }
+        });
+        producer.join();
+        consumer.join();
+        std::cout << "producer/consumer sum: " << (sum == Count * (Count - 1) / 2)
+                  << ", memory bounded: " << (Alloc::capacity() < 8 * 1024) << std::endl;
+    }
+    std::cout << "************debug ObjectPool end************" << std::endl;
+}
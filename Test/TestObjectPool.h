@@ -0,0 +1,9 @@
+#ifndef TESTOBJECTPOOL_H
+#define TESTOBJECTPOOL_H
+
+namespace rapid
+{
+void test_ObjectPool_main();
+}
+
+#endif // TESTOBJECTPOOL_H
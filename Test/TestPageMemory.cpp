@@ -0,0 +1,40 @@
+#include "TestPageMemory.h"
+#include "Core/PageMemory.h"
+#include "Core/Vector.h"
+#include <iostream>
+
+void rapid::test_PageMemory_main()
+{
+    std::cout << "************debug PageMemory begin************" << std::endl;
+    std::cout << "page size: " << page_size() << std::endl;
+    std::cout << "huge page size: " << huge_page_size() << std::endl;
+
+    const size_type align = 1024 * 1024;
+    char *p = static_cast<char *>(page_allocate(10000, PageHint::Transparent, align));
+    std::cout << "aligned: " << (reinterpret_cast<unsigned long>(p) % align == 0) << ", filled with 0: " << (p[9999] == 0) << std::endl;
+    for(int i = 0; i < 10000; ++i)
+    { p[i] = 'a'; }
+    p = static_cast<char *>(page_reallocate(p, 10000, 64 * 1024 * 1024, PageHint::Transparent, align));
+    std::cout << "content kept after growing: " << (p[9999] == 'a') << ", aligned: " << (reinterpret_cast<unsigned long>(p) % align == 0) << std::endl;
+    page_discard(p, 64 * 1024 * 1024);
+    std::cout << "read 0 after discard: " << (p[page_size()] == 0) << std::endl;
+    std::cout << "released: " << page_release(p, 64 * 1024 * 1024) << std::endl;
+
+    // a region from the huge page pool is unmapped and resized in whole huge pages
+    PageHint mapped = PageHint::Normal;
+    char *h = static_cast<char *>(page_allocate(3 * 1024 * 1024, PageHint::Huge, 0, &mapped));
+    h[0] = 'h';
+    std::cout << "huge page region: " << h[0] << std::endl;
+    h = static_cast<char *>(page_reallocate(h, 3 * 1024 * 1024, 1024 * 1024 + 1, mapped, 0, &mapped));
+    std::cout << "content kept after shrinking: " << (h != nullptr && h[0] == 'h') << std::endl;
+    h = static_cast<char *>(page_reallocate(h, 1024 * 1024 + 1, 5 * 1024 * 1024, mapped, 0, &mapped));
+    h[5 * 1024 * 1024 - 1] = 'e';
+    std::cout << "content kept after growing: " << (h[0] == 'h') << std::endl;
+    std::cout << "released: " << page_release(h, 5 * 1024 * 1024, mapped) << std::endl;
+
+    Vector<long> v;
+    for(long i = 0; i < 1000000; ++i)
+    { v.push_back(i); }
+    std::cout << "vector grown in place, v[999999] = " << v[999999] << std::endl;
+    std::cout << "************debug PageMemory end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTPAGEMEMORY_H
+#define TESTPAGEMEMORY_H
+
+namespace rapid
+{
+void test_PageMemory_main();
+}
+
+#endif // TESTPAGEMEMORY_H
@@ -0,0 +1,95 @@
+#include "TestParallel.h"
+#include "Core/Parallel.h"
+#include "Core/Vector.h"
+#include "Core/Matrix.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+static double harmonic(rapid::ThreadPool &pool, rapid::ReduceOrder order)
+{
+    return rapid::parallel_reduce(rapid::Range<int>(1, 1000000), 0.0,
+                                  [](double acc, int i) { return acc + 1.0 / i; },
+                                  [](double a, double b) { return a + b; }, 0, order, pool);
+}
+
+static bool same_bits(double a, double b)
+{ return std::memcmp(&a, &b, sizeof(double)) == 0; }
+
+void rapid::test_Parallel_main()
+{
+    std::cout << "************debug Parallel begin************" << std::endl;
+    std::vector<long> squares(1000, 0);
+    parallel_for(Range<int>(0, 999), [&squares](int i) { squares[i] = static_cast<long>(i) * i; });
+    long total = 0;
+    for(long s : squares)
+    { total += s; }
+    std::cout << "squares: " << total << std::endl;
+    Vector<long> v;
+    for(long i = 1; i <= 100000; ++i)
+    { v.push_back(i); }
+    parallel_for(v.begin(), v.end(), [](long &x) { x *= 2; }, 1000);
+    long doubled = parallel_reduce(v.begin(), v.end(), 0L, [](long acc, long x) { return acc + x; },
+                                   [](long a, long b) { return a + b; });
+    std::cout << "doubled sum: " << doubled << ", expected: " << 100000L * 100001L << std::endl;
+    long empty = parallel_reduce(Range<int>(5, 4), 7L, [](long acc, int) { return acc + 1; },
+                                 [](long a, long b) { return a + b; });
+    std::cout << "empty range: " << empty << std::endl;
+    try
+    {
+        parallel_for(Range<int>(0, 9999), [](int i)
+        {
+            if(i == 7777) throw std::out_of_range("index 7777");
+        }, 16);
+    }
+    catch(const std::out_of_range &e)
+    { std::cout << "caught: " << e.what() << std::endl; }
+    std::cout << "---------------------" << std::endl;
+    ThreadPool one(1), three(3);
+    double d1 = harmonic(one, ReduceOrder::Deterministic);
+    double d3 = harmonic(three, ReduceOrder::Deterministic);
+    double a1 = harmonic(one, ReduceOrder::Any);
+    double a3 = harmonic(three, ReduceOrder::Any);
+    std::cout.precision(17);
+    std::cout << "deterministic: " << d1 << " " << d3 << ", same bits: " << same_bits(d1, d3) << std::endl;
+    std::cout << "any: " << a1 << " " << a3 << std::endl;
+    std::cout.precision(6);
+    std::cout << "---------------------" << std::endl;
+    const size_type N = 200;
+    Matrix<double> a(N, N), b(N, N), c(N, N);
+    for(size_type i = 0; i < N; ++i)
+    {
+        for(size_type j = 0; j < N; ++j)
+        {
+            a.set_value(i, j, static_cast<double>((i * 7 + j) % 13));
+            b.set_value(i, j, static_cast<double>((i + j * 3) % 11));
+        }
+    }
+    auto begin = std::chrono::steady_clock::now();
+    Matrix<double> serial = a * b;
+    double serial_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    begin = std::chrono::steady_clock::now();
+    // every row of the product is independent
+    parallel_for(Range<size_type>(0, N - 1), [&](size_type i)
+    {
+        for(size_type j = 0; j < N; ++j)
+        {
+            double sum = 0;
+            for(size_type k = 0; k < N; ++k)
+            { sum += a.get_value(i, k) * b.get_value(k, j); }
+            c.set_value(i, j, sum);
+        }
+    });
+    double parallel_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    bool equal = true;
+    for(size_type i = 0; i < N; ++i)
+    {
+        for(size_type j = 0; j < N; ++j)
+        { equal = equal && serial.get_value(i, j) == c.get_value(i, j); }
+    }
+    std::cout << N << "x" << N << " multiply equal: " << equal << ", serial " << serial_time
+              << "s, parallel rows on " << ThreadPool::global().thread_count() << " threads " << parallel_time << "s" << std::endl;
+    std::cout << "************debug Parallel end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTPARALLEL_H
+#define TESTPARALLEL_H
+
+namespace rapid
+{
+void test_Parallel_main();
+}
+
+#endif // TESTPARALLEL_H
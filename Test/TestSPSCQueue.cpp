@@ -0,0 +1,92 @@
+#include "TestSPSCQueue.h"
+#include "Core/SPSCQueue.h"
+#include "Core/MPMCQueue.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+struct Pixel
+{
+    unsigned char R, G, B, A;
+};
+}
+
+static constexpr long ITEMS = 2000000;
+
+// return: million elements per second through one hop of [queue]
+template<typename _Queue>
+static double run_hop(_Queue &queue)
+{
+    auto begin = std::chrono::steady_clock::now();
+    std::thread producer([&queue]()
+    {
+        for(long i = 0; i < ITEMS;)
+        {
+            if(queue.try_push(i)) ++i;
+            else std::this_thread::yield();
+        }
+    });
+    long sum = 0, value;
+    for(long received = 0; received < ITEMS;)
+    {
+        if(queue.try_pop(value))
+        {
+            sum += value;
+            ++received;
+        }
+        else std::this_thread::yield();
+    }
+    producer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if(sum != ITEMS * (ITEMS - 1) / 2)
+    { std::cout << "lost elements" << std::endl; }
+    return static_cast<double>(ITEMS) / seconds / 1e6;
+}
+
+void rapid::test_SPSCQueue_main()
+{
+    std::cout << "************debug SPSCQueue begin************" << std::endl;
+    SPSCQueue<std::string> q(3);
+    std::cout << "capacity: " << q.capacity() << std::endl;
+    for(int i = 0; i < 6; ++i)
+    {
+        if(!q.try_push(std::to_string(i) + std::string(20, '.')))
+        {
+            std::cout << "full after " << i << " elements" << std::endl;
+            break;
+        }
+    }
+    std::string s;
+    q.try_pop(s);
+    std::cout << "pop: " << s << ", size: " << q.size() << std::endl;
+    std::cout << "---------------------" << std::endl;
+    // rows of pixels are written and read in place
+    SPSCQueue<Pixel> pixels(8);
+    size_type count;
+    Pixel *row = pixels.reserve(6, count);
+    for(size_type i = 0; i < count; ++i)
+    { row[i] = Pixel{static_cast<unsigned char>(i), 0, 0, 255}; }
+    pixels.commit(count);
+    std::cout << "reserved and committed: " << count << std::endl;
+    const Pixel *in = pixels.peek(4, count);
+    std::cout << "peek " << count << ":";
+    for(size_type i = 0; i < count; ++i)
+    { std::cout << " " << static_cast<int>(in[i].R); }
+    std::cout << std::endl;
+    pixels.release(count);
+    // 2 slots are left before the ring wraps around
+    row = pixels.reserve(6, count);
+    std::cout << "reserve before wrapping: " << count << std::endl;
+    pixels.commit(0);
+    std::cout << "size: " << pixels.size() << std::endl;
+    std::cout << "---------------------" << std::endl;
+    SPSCQueue<long> spsc(1024);
+    MPMCQueue<long> mpmc(1024);
+    double spsc_rate = run_hop(spsc);
+    double mpmc_rate = run_hop(mpmc);
+    std::cout << "one hop: SPSCQueue " << spsc_rate << " M/s, MPMCQueue " << mpmc_rate << " M/s" << std::endl;
+    std::cout << "************debug SPSCQueue end************" << std::endl;
+}
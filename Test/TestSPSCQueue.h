@@ -0,0 +1,9 @@
+#ifndef TESTSPSCQUEUE_H
+#define TESTSPSCQUEUE_H
+
+namespace rapid
+{
+void test_SPSCQueue_main();
+}
+
+#endif // TESTSPSCQUEUE_H
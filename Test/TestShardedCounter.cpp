@@ -0,0 +1,55 @@
+#include "TestShardedCounter.h"
+#include "Core/ShardedCounter.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static constexpr long INCREMENTS = 2000000;
+
+/* [threads] threads increment [counter] INCREMENTS times in total
+ * return: million increments per second
+ */
+template<typename _Counter>
+static double run_increments(_Counter &counter, int threads)
+{
+    std::vector<std::thread> workers;
+    auto begin = std::chrono::steady_clock::now();
+    for(int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&counter, threads]()
+        {
+            for(long i = 0; i < INCREMENTS / threads; ++i)
+            { ++counter; }
+        });
+    }
+    for(std::thread &w : workers)
+    { w.join(); }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if(static_cast<long>(counter) != INCREMENTS / threads * threads)
+    { std::cout << "lost increments" << std::endl; }
+    return static_cast<double>(INCREMENTS) / seconds / 1e6;
+}
+
+void rapid::test_ShardedCounter_main()
+{
+    std::cout << "************debug ShardedCounter begin************" << std::endl;
+    ShardedCounter<long> counter(3);
+    std::cout << "shards: " << counter.shard_count() << std::endl;
+    counter += 10;
+    --counter;
+    counter.sub(4);
+    std::cout << "value: " << counter.load() << std::endl;
+    counter.reset();
+    std::cout << "reset: " << counter.load() << std::endl;
+    std::cout << "---------------------" << std::endl;
+    unsigned hardware = std::thread::hardware_concurrency();
+    int threads = hardware < 2 ? 2 : static_cast<int>(hardware);
+    Atomic<long> shared(0);
+    ShardedCounter<long> sharded;
+    double shared_rate = run_increments(shared, threads);
+    double sharded_rate = run_increments(sharded, threads);
+    std::cout << threads << " threads, M increments/s: Atomic<long> " << shared_rate
+              << ", ShardedCounter " << sharded_rate << std::endl;
+    std::cout << "************debug ShardedCounter end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTSHARDEDCOUNTER_H
+#define TESTSHARDEDCOUNTER_H
+
+namespace rapid
+{
+void test_ShardedCounter_main();
+}
+
+#endif // TESTSHARDEDCOUNTER_H
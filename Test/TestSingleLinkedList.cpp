@@ -45,6 +45,11 @@ void rapid::test_SingleLinkedList_main()
     {
         std::cout << i << std::endl;
     }
+    Slist<int> empty_list;
+    try
+    { empty_list.front(); }
+    catch(const IndexOutOfArrayException &)
+    { std::cout << "front of an empty list throws" << std::endl; }
     std::cout << "************debug singleLinkedList end************" << std::endl;
 }
 
@@ -0,0 +1,87 @@
+#include "TestSmallVector.h"
+#include "Core/SmallVector.h"
+#include "Core/Vector.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+template<typename _Container>
+static void print_small(const _Container &v)
+{
+    for(const auto &value : v)
+    { std::cout << value << " "; }
+    std::cout << std::endl;
+}
+
+// build [rounds] short lists of [count] elements, return: seconds
+template<typename _Container>
+static double build_lists(int rounds, int count, long &checksum)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; ++r)
+    {
+        _Container list;
+        for(int i = 0; i < count; ++i)
+        { list.push_back(r + i); }
+        checksum += list[static_cast<rapid::size_type>(count - 1)];
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void rapid::test_SmallVector_main()
+{
+    std::cout << "************debug SmallVector begin************" << std::endl;
+    SmallVector<int, 4> v{3, 1, 2};
+    std::cout << "size: " << v.size() << ", capacity: " << v.capacity() << ", inline: " << v.is_inline() << std::endl;
+    v.push_back(v[0]);
+    v.push_back(v[1]);
+    std::cout << "size: " << v.size() << ", capacity: " << v.capacity() << ", inline: " << v.is_inline() << std::endl;
+    print_small(v);
+    v.insert(v.begin() + 1, 9);
+    v.push_front(v.back());
+    v.erase(v.find(2));
+    std::sort(v.begin(), v.end());
+    print_small(v);
+    for(auto it = v.rbegin(); it != v.rend(); ++it)
+    { std::cout << *it << " "; }
+    std::cout << std::endl;
+    v.resize(3);
+    v.shrink_to_fit();
+    std::cout << "shrunk: size: " << v.size() << ", capacity: " << v.capacity() << ", inline: " << v.is_inline() << std::endl;
+    try
+    { v.at(3); }
+    catch(IndexOutOfArrayException &e)
+    { std::cout << e.what() << std::endl; }
+    std::cout << "---------------------" << std::endl;
+    SmallVector<std::string, 2> words;
+    for(const char *w : {"small", "vector", "keeps", "strings", "inline"})
+    { words.emplace_back(std::string(w) + std::string(20, '.')); }
+    SmallVector<std::string, 2> copy(words);
+    SmallVector<std::string, 2> moved(rapid::move(words));
+    std::cout << "copy: " << copy.size() << ", moved: " << moved.size() << ", source: " << words.size()
+              << ", source inline: " << words.is_inline() << std::endl;
+    SmallVector<std::string, 2> few{"a", "b"};
+    SmallVector<std::string, 2> taken(rapid::move(few));
+    taken.pop_front();
+    print_small(taken);
+    moved = copy;
+    moved.pop_back();
+    print_small(moved);
+    int extra[] = {7, 8, 9, 10};
+    SmallVector<int, 4> bulk{1, 2};
+    bulk.append(extra, extra + 4);
+    bulk.insert(bulk.begin() + 1, v.begin(), v.end());
+    print_small(bulk);
+    bulk.erase(bulk.begin(), bulk.begin() + 2);
+    std::cout << "erased even: " << bulk.erase_if([](int x) { return x % 2 == 0; }) << ", ";
+    print_small(bulk);
+    std::cout << "---------------------" << std::endl;
+    const int ROUNDS = 200000;
+    long sum_vector = 0, sum_small = 0;
+    double vector_time = build_lists<Vector<int>>(ROUNDS, 12, sum_vector);
+    double small_time = build_lists<SmallVector<int, 16>>(ROUNDS, 12, sum_small);
+    std::cout << ROUNDS << " lists of 12 ints, same: " << (sum_vector == sum_small) << ", Vector " << vector_time
+              << "s, SmallVector " << small_time << "s" << std::endl;
+    std::cout << "************debug SmallVector end************" << std::endl;
+}
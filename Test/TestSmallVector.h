@@ -0,0 +1,9 @@
+#ifndef TESTSMALLVECTOR_H
+#define TESTSMALLVECTOR_H
+
+namespace rapid
+{
+void test_SmallVector_main();
+}
+
+#endif // TESTSMALLVECTOR_H
@@ -0,0 +1,137 @@
+#include "TestSpinLock.h"
+#include "Core/SpinLock.h"
+#include "Core/Map.h"
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr long OPERATIONS = 400000;
+
+/* [threads] threads take [lock] OPERATIONS times in total around a short critical section
+ * return: million critical sections per second
+ */
+template<typename _Lock>
+static double run_contention(_Lock &lock, int threads)
+{
+    long counter = 0;
+    std::vector<std::thread> workers;
+    auto begin = std::chrono::steady_clock::now();
+    for(int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&lock, &counter, threads]()
+        {
+            for(long i = 0; i < OPERATIONS / threads; ++i)
+            {
+                lock.lock();
+                ++counter;
+                lock.unlock();
+            }
+        });
+    }
+    for(std::thread &w : workers)
+    { w.join(); }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if(counter != OPERATIONS / threads * threads)
+    { std::cout << "lost updates" << std::endl; }
+    return static_cast<double>(counter) / seconds / 1e6;
+}
+
+/* lookups of a Map, one in [every] operations is an insertion
+ * return: million operations per second
+ */
+template<typename _Lock>
+static double run_lookup(_Lock &lock, int threads, long every)
+{
+    rapid::Map<long, long> map;
+    for(long k = 0; k < 256; ++k)
+    { map[k] = k; }
+    rapid::Atomic<long> found(0);
+    std::vector<std::thread> workers;
+    auto begin = std::chrono::steady_clock::now();
+    for(int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]()
+        {
+            long hits = 0;
+            for(long i = 0; i < OPERATIONS / threads; ++i)
+            {
+                long key = (i * 31 + t) & 255;
+                if(i % every == 0)
+                {
+                    rapid::LockGuard<_Lock> guard(lock);
+                    map[key] = i;
+                }
+                else
+                {
+                    rapid::SharedLockGuard<_Lock> guard(lock);
+                    if(map.find(key) != map.end()) ++hits;
+                }
+            }
+            found += hits;
+        });
+    }
+    for(std::thread &w : workers)
+    { w.join(); }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return static_cast<double>(OPERATIONS / threads * threads) / seconds / 1e6;
+}
+
+namespace
+{
+// a mutex taken shared is still exclusive, the baseline of run_lookup
+struct ExclusiveMutex
+{
+    std::mutex Mutex;
+    void lock() { Mutex.lock(); }
+    void unlock() { Mutex.unlock(); }
+    void lock_shared() { Mutex.lock(); }
+    void unlock_shared() { Mutex.unlock(); }
+};
+}
+
+void rapid::test_SpinLock_main()
+{
+    std::cout << "************debug SpinLock begin************" << std::endl;
+    SpinLock spin;
+    std::cout << "try_lock: " << spin.try_lock() << ", again: " << spin.try_lock() << std::endl;
+    spin.unlock();
+    TicketLock ticket;
+    {
+        LockGuard<TicketLock> guard(ticket);
+        std::cout << "ticket locked: " << ticket.locked() << ", try_lock: " << ticket.try_lock() << std::endl;
+    }
+    std::cout << "ticket locked: " << ticket.locked() << std::endl;
+    RWSpinLock rw;
+    std::cout << "shared: " << rw.try_lock_shared() << " " << rw.try_lock_shared()
+              << ", exclusive while shared: " << rw.try_lock() << std::endl;
+    rw.unlock_shared();
+    rw.unlock_shared();
+    std::cout << "exclusive: " << rw.try_lock() << ", shared while exclusive: " << rw.try_lock_shared() << std::endl;
+    rw.unlock();
+    std::cout << "---------------------" << std::endl;
+    unsigned hardware = std::thread::hardware_concurrency();
+    // more threads than cores, the holder gets preempted and the waiters have to sleep
+    for(int threads : {2, static_cast<int>(hardware < 2 ? 2 : hardware) * 2})
+    {
+        std::mutex mutex;
+        SpinLock s;
+        TicketLock t;
+        RWSpinLock r;
+        double m_rate = run_contention(mutex, threads);
+        double s_rate = run_contention(s, threads);
+        double t_rate = run_contention(t, threads);
+        double r_rate = run_contention(r, threads);
+        std::cout << threads << " threads, M locks/s: std::mutex " << m_rate << ", SpinLock " << s_rate
+                  << ", TicketLock " << t_rate << ", RWSpinLock " << r_rate << std::endl;
+    }
+    ExclusiveMutex exclusive;
+    RWSpinLock lookup_lock;
+    int threads = hardware < 2 ? 2 : static_cast<int>(hardware);
+    double exclusive_rate = run_lookup(exclusive, threads, 100);
+    double shared_rate = run_lookup(lookup_lock, threads, 100);
+    std::cout << "Map lookups with 1% inserts, M ops/s: std::mutex " << exclusive_rate
+              << ", RWSpinLock " << shared_rate << std::endl;
+    std::cout << "************debug SpinLock end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTSPINLOCK_H
+#define TESTSPINLOCK_H
+
+namespace rapid
+{
+void test_SpinLock_main();
+}
+
+#endif // TESTSPINLOCK_H
@@ -0,0 +1,146 @@
+#include "TestSync.h"
+#include "Core/Sync.h"
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr long HANDOFFS = 100000;
+
+/* a producer hands numbers one by one to a consumer through a slot guarded by [_Mutex]
+ * return: thousand handoffs per second
+ */
+template<typename _Mutex, typename _Condition>
+static double run_handoff()
+{
+    _Mutex mutex;
+    _Condition full, empty;
+    long slot = -1, sum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    std::thread consumer([&]()
+    {
+        for(long i = 0; i < HANDOFFS; ++i)
+        {
+            std::unique_lock<_Mutex> lock(mutex);
+            while(slot < 0)
+            { full.wait(lock); }
+            sum += slot;
+            slot = -1;
+            empty.notify_one();
+        }
+    });
+    for(long i = 0; i < HANDOFFS; ++i)
+    {
+        std::unique_lock<_Mutex> lock(mutex);
+        while(slot >= 0)
+        { empty.wait(lock); }
+        slot = i;
+        full.notify_one();
+    }
+    consumer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if(sum != HANDOFFS * (HANDOFFS - 1) / 2)
+    { std::cout << "lost handoffs" << std::endl; }
+    return HANDOFFS / seconds / 1e3;
+}
+
+namespace
+{
+// rapid::Condition with the interface of std::condition_variable, for run_handoff
+struct ConditionAdapter
+{
+    rapid::Condition Condition;
+    void wait(std::unique_lock<rapid::Mutex> &lock) { Condition.wait(*lock.mutex()); }
+    void notify_one() { Condition.notify_one(); }
+};
+}
+
+void rapid::test_Sync_main()
+{
+    std::cout << "************debug Sync begin************" << std::endl;
+    std::cout << "size: Mutex " << sizeof(Mutex) << ", Condition " << sizeof(Condition)
+              << ", Semaphore " << sizeof(Semaphore) << ", Latch " << sizeof(Latch)
+              << ", Barrier " << sizeof(Barrier) << std::endl;
+    Mutex mutex;
+    std::cout << "try_lock: " << mutex.try_lock() << ", again: " << mutex.try_lock() << std::endl;
+    mutex.unlock();
+    Semaphore semaphore(2);
+    std::cout << "semaphore: " << semaphore.try_acquire() << " " << semaphore.try_acquire()
+              << " " << semaphore.try_acquire() << std::endl;
+    semaphore.release(2);
+    std::cout << "released, count: " << semaphore.count() << std::endl;
+    std::cout << "---------------------" << std::endl;
+    // workers park on the semaphore until there is work, then count down the latch
+    const int workers = 4;
+    Semaphore work;
+    Latch done(workers);
+    Atomic<long> total(0);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < workers; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            work.acquire();
+            total += t + 1;
+            done.count_down();
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::cout << "parked, total: " << total << std::endl;
+    work.release(workers);
+    done.wait();
+    std::cout << "latch open, total: " << total << std::endl;
+    for(std::thread &t : threads)
+    { t.join(); }
+    threads.clear();
+    // every phase sees the values of the phase before
+    Barrier barrier(workers);
+    const int phases = 1000;
+    std::vector<long> values(workers, 0);
+    Atomic<int> serial(0), wrong(0);
+    for(int t = 0; t < workers; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for(int p = 0; p < phases; ++p)
+            {
+                values[t] = p;
+                if(barrier.arrive_and_wait()) ++serial;
+                for(int k = 0; k < workers; ++k)
+                {
+                    if(values[k] != p) ++wrong;
+                }
+                barrier.arrive_and_wait();
+            }
+        });
+    }
+    for(std::thread &t : threads)
+    { t.join(); }
+    std::cout << "barrier phases: " << barrier.phase() << ", serial threads: " << serial
+              << ", wrong values: " << wrong << std::endl;
+    std::cout << "---------------------" << std::endl;
+    auto begin = std::chrono::steady_clock::now();
+    for(long i = 0; i < 10000000; ++i)
+    {
+        mutex.lock();
+        mutex.unlock();
+    }
+    double rapid_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::mutex std_mutex;
+    begin = std::chrono::steady_clock::now();
+    for(long i = 0; i < 10000000; ++i)
+    {
+        std_mutex.lock();
+        std_mutex.unlock();
+    }
+    double std_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "uncontended lock and unlock, ns: Mutex " << rapid_seconds * 100
+              << ", std::mutex " << std_seconds * 100 << std::endl;
+    double rapid_rate = run_handoff<Mutex, ConditionAdapter>();
+    double std_rate = run_handoff<std::mutex, std::condition_variable>();
+    std::cout << "handoffs, K/s: Mutex and Condition " << rapid_rate
+              << ", std::mutex and std::condition_variable " << std_rate << std::endl;
+    std::cout << "************debug Sync end************" << std::endl;
+}
@@ -0,0 +1,9 @@
+#ifndef TESTSYNC_H
+#define TESTSYNC_H
+
+namespace rapid
+{
+void test_Sync_main();
+}
+
+#endif // TESTSYNC_H
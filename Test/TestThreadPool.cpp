@@ -0,0 +1,130 @@
+#include "TestThreadPool.h"
+#include "Core/ThreadPool.h"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static long fib_serial(int n)
+{ return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2); }
+
+// fork-join fib, small problems run serially
+static long fib_parallel(rapid::ThreadPool &pool, int n)
+{
+    if(n < 20)
+    { return fib_serial(n); }
+    long a = 0;
+    rapid::TaskGroup group(pool);
+    group.spawn([&pool, &a, n]() { a = fib_parallel(pool, n - 1); });
+    long b = fib_parallel(pool, n - 2);
+    group.sync();
+    return a + b;
+}
+
+static void test_deque()
+{
+    rapid::WorkStealingDeque<long> deque(4);
+    for(long i = 0; i < 100; ++i)
+    { deque.push(i); }
+    long value = 0;
+    deque.steal(value);
+    std::cout << "capacity: " << deque.capacity() << ", size: " << deque.size() << ", stolen: " << value;
+    deque.pop(value);
+    std::cout << ", popped: " << value << std::endl;
+    while(deque.pop(value))
+    { }
+    // the owner pops while thieves steal, every element is taken once
+    const long N = 200000;
+    rapid::Atomic<long> sum(0);
+    rapid::Atomic<bool> done(false);
+    std::vector<std::thread> thieves;
+    for(int t = 0; t < 3; ++t)
+    {
+        thieves.emplace_back([&]()
+        {
+            long v, local = 0;
+            while(!done.load(rapid::MemoryOrder::Acquire) || !deque.empty())
+            {
+                if(deque.steal(v)) local += v;
+            }
+            sum.fetch_add(local);
+        });
+    }
+    long local = 0;
+    for(long i = 1; i <= N; ++i)
+    {
+        deque.push(i);
+        if(i % 3 == 0 && deque.pop(value))
+        { local += value; }
+    }
+    while(deque.pop(value))
+    { local += value; }
+    done.store(true, rapid::MemoryOrder::Release);
+    for(std::thread &t : thieves)
+    { t.join(); }
+    sum.fetch_add(local);
+    std::cout << "sum: " << sum.load() << ", expected: " << N * (N + 1) / 2 << std::endl;
+}
+
+void rapid::test_ThreadPool_main()
+{
+    std::cout << "************debug ThreadPool begin************" << std::endl;
+    test_deque();
+    std::cout << "---------------------" << std::endl;
+    ThreadPool pool(4);
+    std::cout << "threads: " << pool.thread_count() << std::endl;
+    Future<int> answer = pool.submit([]() { return 6 * 7; });
+    Future<std::string> text = pool.submit([]() { return std::string("future"); });
+    Future<void> nothing = pool.submit([]() { });
+    Future<int> error = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    std::cout << "answer: " << answer.get() << ", text: " << text.get() << std::endl;
+    nothing.get();
+    try
+    { error.get(); }
+    catch(const std::runtime_error &e)
+    { std::cout << "caught: " << e.what() << std::endl; }
+    std::vector<Future<long>> futures;
+    for(long i = 0; i < 1000; ++i)
+    { futures.push_back(pool.submit([i]() { return i * i; })); }
+    long squares = 0;
+    for(Future<long> &f : futures)
+    { squares += f.get(); }
+    std::cout << "sum of squares: " << squares << std::endl;
+    // dropped futures and tasks still pending when the pool is destroyed
+    ThreadPool *small = new ThreadPool(2);
+    Atomic<int> ran(0);
+    for(int i = 0; i < 100; ++i)
+    { small->execute([&ran]() { ran.fetch_add(1); }); }
+    {
+        Future<int> dropped = small->submit([]() { return 1; });
+        un_use(dropped);
+        TaskGroup group(*small);
+        group.spawn([]() { throw std::logic_error("group failed"); });
+        group.spawn([&ran]() { ran.fetch_add(1); });
+        try
+        { group.sync(); }
+        catch(const std::logic_error &e)
+        { std::cout << "caught: " << e.what() << std::endl; }
+        group.sync();
+    }
+    delete small;
+    std::cout << "ran: " << ran.load() << std::endl;
+    std::cout << "---------------------" << std::endl;
+    const int N = 35;
+    auto begin = std::chrono::steady_clock::now();
+    long serial = fib_serial(N);
+    double serial_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    begin = std::chrono::steady_clock::now();
+    long parallel = fib_parallel(pool, N);
+    double parallel_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "fib(" << N << "): " << serial << " " << parallel << ", serial " << serial_time
+              << "s, fork-join on " << pool.thread_count() << " threads " << parallel_time << "s" << std::endl;
+    begin = std::chrono::steady_clock::now();
+    long nested = 0;
+    pool.submit([&]() { nested = fib_parallel(pool, N); }).get();
+    double nested_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "fork-join inside a worker: " << nested << " " << nested_time << "s" << std::endl;
+    std::cout << "************debug ThreadPool end************" << std::endl;
+}
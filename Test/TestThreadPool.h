@@ -0,0 +1,9 @@
+#ifndef TESTTHREADPOOL_H
+#define TESTTHREADPOOL_H
+
+namespace rapid
+{
+void test_ThreadPool_main();
+}
+
+#endif // TESTTHREADPOOL_H
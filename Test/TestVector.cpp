@@ -1,7 +1,15 @@
 #include "TestVector.h"
 #include "Core/Vector.h"
 #include "Core/Exception.h"
+#include "Core/Malloc.h"
+#include "Algorithm/Sorter.h"
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <stdexcept>
 #include <iostream>
+#include <string>
 
 template<typename T>
 static void print_vector(rapid::Vector<T> &v)
@@ -54,5 +62,167 @@ void rapid::test_Vector_main()
     }
     std::cout << "size = " << vec.size() << std::endl;
     print_vector(vec);
+    std::cout << "------------------------------" << std::endl;
+    // std::string is not trivially relocatable, it is moved by construction
+    Vector<std::string> words;
+    for(const char *w : {"the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog"})
+    { words.push_back(std::string(w) + std::string(20, '.')); }
+    words.erase(words.begin());
+    words.insert(words.begin() + 3, std::string("very") + std::string(20, '.'));
+    Vector<std::string> words_copy(words);
+    words_copy.pop_front();
+    std::cout << "size = " << words_copy.size() << std::endl;
+    print_vector(words_copy);
+    std::cout << "------------------------------" << std::endl;
+    // capacity is raw memory, only resize constructs elements
+    Vector<long> sized;
+    sized.reserve(100);
+    std::cout << "reserved: size = " << sized.size() << ", capacity = " << sized.capacity() << std::endl;
+    sized.resize(5);
+    sized[4] = 44;
+    print_vector(sized);
+    sized.resize(2);
+    sized.shrink_to_fit();
+    std::cout << "shrunk: size = " << sized.size() << ", capacity = " << sized.capacity() << std::endl;
+    for(long i = 0; i < 1000; ++i)
+    { sized.push_back(i); }
+    std::cout << "pushed: size = " << sized.size() << ", capacity = " << sized.capacity()
+              << ", back = " << sized.back() << std::endl;
+    sized.resize(0);
+    sized.shrink_to_fit();
+    sized.push_back(7);
+    std::cout << "after shrinking to 0: size = " << sized.size() << ", capacity = " << sized.capacity() << std::endl;
+    // shrink_to_fit gives the memory back, not only the capacity
+    Vector<int> shrinking;
+    shrinking.resize(10000000);
+    shrinking.resize(10);
+    shrinking.shrink_to_fit();
+    std::cout << "shrunk big: capacity = " << shrinking.capacity()
+              << ", usable bytes < 64K: " << (malloc_usable_size(shrinking.data()) < 64 * 1024) << std::endl;
+    shrinking.resize(1000);
+    shrinking.resize(10);
+    shrinking.shrink_to_fit();
+    std::cout << "shrunk small: capacity = " << shrinking.capacity()
+              << ", usable bytes < 1K: " << (malloc_usable_size(shrinking.data()) < 1024) << std::endl;
+    // without reallocate() in the allocator only the live elements are copied
+    Vector<long, std::allocator<long>> fallback;
+    fallback.reserve(1000);
+    for(long i = 0; i < 3; ++i)
+    { fallback.push_back(i + 1); }
+    fallback.reserve(5000);
+    fallback.shrink_to_fit();
+    std::cout << "std allocator: capacity = " << fallback.capacity() << ", elements = "
+              << fallback[0] << fallback[1] << fallback[2] << std::endl;
+    // clear() gives the buffer back, the capacity starts over from 0
+    Vector<std::string> cleared;
+    cleared.push_back("a");
+    cleared.reserve(16);
+    cleared.clear();
+    std::cout << "cleared: capacity = " << cleared.capacity() << std::endl;
+    cleared.reserve(2);
+    cleared.push_back("b");
+    cleared.clear();
+    cleared.push_back("c");
+    cleared.clear();
+    std::string letters[] = {"d", "e", "f"};
+    cleared.insert(cleared.begin(), letters, letters + 3);
+    cleared.clear();
+    cleared.append(letters, letters + 3);
+    std::cout << "reused after clear: size = " << cleared.size() << ", back = " << cleared.back() << std::endl;
+    // an argument referring to an element stays valid while the buffer grows
+    Vector<std::string> self;
+    self.reserve(1);
+    self.push_back(std::string(40, 's'));
+    for(int i = 0; i < 4; ++i)
+    { self.push_back(self[0]); }
+    self.insert(self.begin(), self.back());
+    std::string moved(40, 'm');
+    self.push_front(std::move(moved));
+    self.emplace_back(3, 'e');
+    std::cout << "self insert: size = " << self.size() << ", front = " << self.front().substr(0, 3)
+              << ", back = " << self.back() << ", source moved = " << moved.empty() << std::endl;
+    words_copy.resize(10);
+    std::cout << "resized strings: size = " << words_copy.size() << ", last empty = " << words_copy.back().empty() << std::endl;
+    std::cout << "------------------------------" << std::endl;
+    // the iterators are contiguous, std and rapid algorithms run on them as on arrays
+    Vector<int> numbers;
+    for(int i = 0; i < 10; ++i)
+    { numbers.push_back((i * 7) % 10); }
+    std::sort(numbers.begin(), numbers.end());
+    print_vector(numbers);
+    for(auto it = numbers.rbegin(); it != numbers.rend(); ++it)
+    { std::cout << *it << " "; }
+    std::cout << std::endl;
+    std::cout << "data()[3] = " << numbers.data()[3] << ", end - begin = " << (numbers.end() - numbers.begin())
+              << ", begin[5] = " << numbers.begin()[5] << std::endl;
+    const int N = 200000;
+    Vector<int> big;
+    int *raw = new int[N];
+    for(int i = 0; i < N; ++i)
+    {
+        raw[i] = (i * 7919) % N;
+        big.push_back(raw[i]);
+    }
+    auto start = std::chrono::steady_clock::now();
+    qsort(raw, raw + N);
+    double array_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    qsort(big.begin(), big.end());
+    double vector_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "qsort of " << N << " ints, same: " << std::equal(raw, raw + N, big.data())
+              << ", array " << array_time << "s, Vector " << vector_time << "s" << std::endl;
+    msort(big.begin(), big.end(), [](int a, int b) { return a > b; });
+    std::cout << "msort descending: " << big.front() << " ... " << big.back() << std::endl;
+    delete[] raw;
+    std::cout << "------------------------------" << std::endl;
+    // bulk operations move the tail once
+    Vector<int> rows{1, 2, 8, 9};
+    int middle[] = {3, 4, 5};
+    std::list<int> more{6, 7};
+    rows.insert(rows.begin() + 2, middle, middle + 3);
+    rows.insert(rows.begin() + 5, more.begin(), more.end());
+    Vector<int> tail{10, 11, 12};
+    rows.append(tail.begin(), tail.end());
+    print_vector(rows);
+    rows.erase(rows.begin() + 1, rows.begin() + 4);
+    print_vector(rows);
+    std::cout << "erased odd: " << rows.erase_if([](int x) { return x % 2 != 0; }) << ", ";
+    print_vector(rows);
+    Vector<std::string> names{"ann", "bob", "cid", "dan"};
+    std::list<std::string> guests{"eve", "fay"};
+    names.insert(names.begin() + 1, guests.begin(), guests.end());
+    names.erase_if([](const std::string &n) { return n[0] == 'c' || n[0] == 'e'; });
+    print_vector(names);
+    try
+    {
+        names.erase_if([](const std::string &n)
+        {
+            if(n == "dan") throw std::runtime_error("stop at dan");
+            return n == "bob";
+        });
+    }
+    catch(const std::runtime_error &e)
+    { std::cout << e.what() << ": "; }
+    print_vector(names);
+    const int BATCH = 2000, CALLS = 20;
+    Vector<int> batch;
+    for(int i = 0; i < BATCH; ++i)
+    { batch.push_back(i); }
+    Vector<int> one_by_one, bulk;
+    start = std::chrono::steady_clock::now();
+    for(int c = 0; c < CALLS; ++c)
+    {
+        long long middle = static_cast<long long>(one_by_one.size() / 2);
+        for(int i = 0; i < BATCH; ++i)
+        { one_by_one.insert(one_by_one.begin() + middle + i, batch[i]); }
+    }
+    double single_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for(int c = 0; c < CALLS; ++c)
+    { bulk.insert(bulk.begin() + static_cast<long long>(bulk.size() / 2), batch.begin(), batch.end()); }
+    double bulk_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << CALLS << " batches of " << BATCH << " rows, same: "
+              << std::equal(bulk.begin(), bulk.end(), one_by_one.begin()) << ", one by one " << single_time
+              << "s, bulk " << bulk_time << "s" << std::endl;
     std::cout << "---------------test end---------------" << std::endl;
 }